@@ -0,0 +1,74 @@
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#ifndef	ATOMIC_HG
+#define	ATOMIC_HG
+
+/* System include statements */
+#include <stdint.h>
+
+/* Silicon Labs include statements */
+#include "em_device.h"
+
+/* The developer's include statements */
+
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+
+// Read-modify-write of one word shared by the main loop and interrupt
+// handlers, without masking interrupts.
+//
+// Each function loads the word with LDREX and stores it back with STREX,
+// which fails if an interrupt was taken in between, as exception entry
+// clears the exclusive monitor. The update is then retried with the value
+// the handler left. All of them return the value the word held before.
+
+static inline uint32_t atomic_or32(volatile uint32_t *addr, uint32_t mask){
+	uint32_t old;
+
+	do {
+		old = __LDREXW(addr);
+	} while(__STREXW(old | mask, addr));
+	return old;
+}
+
+static inline uint32_t atomic_and32(volatile uint32_t *addr, uint32_t mask){
+	uint32_t old;
+
+	do {
+		old = __LDREXW(addr);
+	} while(__STREXW(old & mask, addr));
+	return old;
+}
+
+static inline uint32_t atomic_add32(volatile uint32_t *addr, uint32_t value){
+	uint32_t old;
+
+	do {
+		old = __LDREXW(addr);
+	} while(__STREXW(old + value, addr));
+	return old;
+}
+
+static inline uint32_t atomic_sub32(volatile uint32_t *addr, uint32_t value){
+	uint32_t old;
+
+	do {
+		old = __LDREXW(addr);
+	} while(__STREXW(old - value, addr));
+	return old;
+}
+
+//***********************************************************************************
+// global variables
+//***********************************************************************************
+
+
+//***********************************************************************************
+// function prototypes
+//***********************************************************************************
+
+
+#endif
@@ -68,6 +68,7 @@ typedef struct {
 //***********************************************************************************
 void ble_open(void);//uint32_t tx_event, uint32_t rx_event
 void ble_write(char *string);
+bool ble_tx_idle(void);
 
 bool ble_test(char *mod_name);
 
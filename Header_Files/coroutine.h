@@ -0,0 +1,61 @@
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#ifndef	COROUTINE_HG
+#define	COROUTINE_HG
+
+/* System include statements */
+#include <stdint.h>
+
+/* Silicon Labs include statements */
+
+
+/* The developer's include statements */
+
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+
+// Stackless coroutines for driver sequences that wait between steps.
+//
+// A coroutine is a function taking a COROUTINE pointer whose body sits
+// between COROUTINE_BEGIN() and COROUTINE_END(). COROUTINE_YIELD() returns
+// to the caller and the next call resumes on the line after it, by way of
+// a switch on the line number it left at. Locals are not kept across a
+// yield, so state the steps share must be static.
+//
+// The scheduler runs a coroutine from its own event, see the COROUTINE kind
+// in events.h. Each step starts an I2C transfer or a software timer that
+// posts that event, then yields, and the core sleeps until it is posted.
+// A switch statement may not be used inside the body.
+
+// State of a coroutine, zero before it first runs and once it has finished
+typedef struct {
+	uint16_t	line;			// line of the yield to resume after
+} COROUTINE;
+
+#define COROUTINE_BEGIN(cr)			switch((cr)->line){ case 0:
+
+// Returns, the next call carries on after this line
+#define COROUTINE_YIELD(cr) \
+	do { (cr)->line = __LINE__; return; case __LINE__:; } while(0)
+
+// Returns until cond is true, it is tested again on each call
+#define COROUTINE_AWAIT(cr, cond) \
+	do { (cr)->line = __LINE__; case __LINE__: if(!(cond)) return; } while(0)
+
+// Marks the coroutine finished, the next call starts it from the beginning
+#define COROUTINE_END(cr)			} (cr)->line = 0
+
+//***********************************************************************************
+// global variables
+//***********************************************************************************
+
+
+//***********************************************************************************
+// function prototypes
+//***********************************************************************************
+
+
+#endif
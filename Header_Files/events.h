@@ -0,0 +1,81 @@
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#ifndef	EVENTS_HG
+#define	EVENTS_HG
+
+/* System include statements */
+
+
+/* Silicon Labs include statements */
+
+
+/* The developer's include statements */
+
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+
+// Every event the scheduler knows about, one line each:
+//
+//   X(event, kind, handler, priority, budget)
+//
+// The position of a line is the event's ID, so IDs never need to be assigned
+// by hand and a name listed twice fails to compile. Within a priority level
+// the event listed first is dispatched first.
+//
+// kind is one of
+//   BIT     handler runs once however many times the event was posted
+//   RECORD  handler runs once per post and receives the payload
+//   COROUTINE  handler is a coroutine from coroutine.h, resumed each time
+//              the event is posted
+//   NONE    no handler, the event is polled with check_scheduled_event()
+//
+// budget is the most runs of a handler in one dispatch pass. Records are
+// always taken oldest first, so a RECORD event that is out of budget holds
+// back the records queued behind it until the next pass. The reading
+// handlers have a budget of 1, so a burst of completions is formatted one
+// per pass with the work queue drained in between. Boot up runs once from
+// the work queue and needs no event or budget.
+//
+// The handlers are only named here. The dispatch table is built from this
+// list in app.c, which includes their declarations.
+//
+// Completions and retries that restart the LEUART or an I2C bus are HIGH so the
+// peripherals are not left idle while readings are being formatted.
+#define SCHEDULER_EVENT_LIST(X) \
+	X(LETIMER_COMP0_CB,				BIT,	scheduled_letimer0_comp0_cb,		SCHEDULER_PRIORITY_NORMAL,	SCHEDULER_NO_BUDGET) \
+	X(LETIMER_UF_CB,				BIT,	scheduled_letimer0_uf_cb,			SCHEDULER_PRIORITY_NORMAL,	SCHEDULER_NO_BUDGET) \
+	X(Si7021_Read_Humidity_CB,		RECORD,	scheduled_si7021_humidity_cb,		SCHEDULER_PRIORITY_LOW,		1) \
+	X(BLE_TX_DONE_CB,				BIT,	scheduled_ble_tx_done_cb,			SCHEDULER_PRIORITY_HIGH,	SCHEDULER_NO_BUDGET) \
+	X(Si7021_Read_Temperature_CB,	RECORD,	scheduled_si7021_temperature_cb,	SCHEDULER_PRIORITY_LOW,		1) \
+	X(Si7021_Read_Reg_CB,			RECORD,	scheduled_si7021_readReg_cb,		SCHEDULER_PRIORITY_NORMAL,	SCHEDULER_NO_BUDGET) \
+	X(Si7021_Write_Reg_CB,			BIT,	scheduled_si7021_writeReg_cb,		SCHEDULER_PRIORITY_HIGH,	SCHEDULER_NO_BUDGET) \
+	X(SI7021_TEST_CB,				COROUTINE,	si7021_test,				SCHEDULER_PRIORITY_HIGH,	SCHEDULER_NO_BUDGET) \
+	X(VEML6030_Write_CB,			BIT,	scheduled_veml6030_write_cb,		SCHEDULER_PRIORITY_HIGH,	SCHEDULER_NO_BUDGET) \
+	X(VEML6030_Read_CB,				RECORD,	scheduled_veml6030_lux_cb,			SCHEDULER_PRIORITY_LOW,		1) \
+	X(I2C0_RETRY_CB,				BIT,	scheduled_i2c0_retry_cb,			SCHEDULER_PRIORITY_HIGH,	SCHEDULER_NO_BUDGET) \
+	X(I2C1_RETRY_CB,				BIT,	scheduled_i2c1_retry_cb,			SCHEDULER_PRIORITY_HIGH,	SCHEDULER_NO_BUDGET) \
+	X(I2C_STATS_CB,					COROUTINE,	i2c_stats_dump,				SCHEDULER_PRIORITY_LOW,		SCHEDULER_NO_BUDGET) \
+	X(TRACE_DUMP_CB,				COROUTINE,	trace_dump,					SCHEDULER_PRIORITY_LOW,		SCHEDULER_NO_BUDGET)
+
+// Event IDs, numbered in list order
+#define EVENTS_ID(event, kind, handler, priority, budget)		event,
+typedef enum {
+	SCHEDULER_EVENT_LIST(EVENTS_ID)
+	SCHEDULER_EVENT_COUNT
+} SCHEDULER_EVENT;
+#undef EVENTS_ID
+
+//***********************************************************************************
+// global variables
+//***********************************************************************************
+
+
+//***********************************************************************************
+// function prototypes
+//***********************************************************************************
+
+
+#endif
@@ -0,0 +1,52 @@
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#ifndef	HIBERNATE_HG
+#define	HIBERNATE_HG
+
+/* System include statements */
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Silicon Labs include statements */
+#include "em_cmu.h"
+#include "em_emu.h"
+#include "em_rmu.h"
+#include "em_rtcc.h"
+#include "em_assert.h"
+
+/* The developer's include statements */
+#include "rtcc.h"
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+
+// Layout of the RTCC retention registers, the state follows the header words
+#define HIBERNATE_REG_MAGIC		0
+#define HIBERNATE_REG_SIZE		1
+#define HIBERNATE_REG_CHECK		2
+#define HIBERNATE_REG_STATE		3
+#define HIBERNATE_REG_COUNT		32
+
+// Marks the retention registers as holding a state written by hibernate_enter()
+#define HIBERNATE_MAGIC			0x4842524EUL
+
+// Largest state kept through EM4H, in bytes
+#define HIBERNATE_STATE_MAX		((HIBERNATE_REG_COUNT - HIBERNATE_REG_STATE) * sizeof(uint32_t))
+
+//***********************************************************************************
+// global variables
+//***********************************************************************************
+
+
+//***********************************************************************************
+// function prototypes
+//***********************************************************************************
+void hibernate_open(void);
+bool hibernate_warm_boot(void);
+bool hibernate_restore(void *state, uint32_t size);
+void hibernate_pins_release(void);
+void hibernate_enter(const void *state, uint32_t size, uint32_t wake_at);
+
+#endif
@@ -14,17 +14,71 @@
 #include "em_gpio.h"
 #include "em_cmu.h"
 #include "em_assert.h"
+#include "em_core.h"
+#include "em_ldma.h"
 
 
 /* The developer's include statements */
 #include "brd_config.h"
 #include "sleep_routines.h"
 #include "scheduler.h"
+#include "letimer.h"
+#include "trace.h"
 
 //***********************************************************************************
 // defined files
 //***********************************************************************************
 
+// Transfers each bus holds behind the one in progress, must be a power of two
+#define I2C_QUEUE_SIZE			8
+
+// Uncomment to have the LDMA move the address, command and data bytes of each
+// transfer, so the CPU only takes its MSTOP interrupt instead of one per byte
+//#define I2C_LDMA_ENABLED
+
+// LDMA channels of each bus, one for each direction
+#define I2C0_LDMA_TX_CH			0
+#define I2C0_LDMA_RX_CH			1
+#define I2C1_LDMA_TX_CH			2
+#define I2C1_LDMA_RX_CH			3
+
+// Most bytes a transfer writes after the slave address
+#define I2C_WRITE_MAX			4
+
+// Retries of a NACKed or failed transfer before it is given up, and the wait
+// before the first one, doubled for each retry after it. The waits add up to
+// 63 ms, longer than the slowest si7021 conversion.
+#define I2C_RETRY_MAX			6
+#define I2C_BACKOFF_MS			1
+#define I2C_BACKOFF_MAX_MS		32
+
+// SCL held low for about 290 us at the fast mode clock raises CLTO, a bus
+// left busy without a STOP raises BITO and is freed by the hardware
+#define I2C_TIMEOUTS			(I2C_CTRL_CLTO_1024PCC | I2C_CTRL_BITO_160PCC | I2C_CTRL_GIBITO)
+
+// Kinds of transaction counted, one per slave address and command on each bus
+#define I2C_STATS_SIZE			8
+
+// Command of a transaction that writes nothing before it reads
+#define I2C_STATS_NO_COMMAND	0xFFFF
+
+// Time between checks of the BLE link while the stats are sent
+#define I2C_STATS_POLL_MS		20
+
+// How a transfer ended, posted as the status of its event's record
+typedef enum {
+	I2C_OK,
+	I2C_NACK_TIMEOUT,			// the slave did not answer in any of the retries
+	I2C_BUS_ERROR,				// clock held low, arbitration lost or misplaced START/STOP on every try
+	I2C_QUEUE_FULL				// the bus's queue had no room, the transfer was never sent
+} I2C_STATUS;
+
+// Order the bytes of a read make up the result in
+typedef enum {
+	I2C_MSB_FIRST,				// first byte received is the most significant
+	I2C_LSB_FIRST				// first byte received is the least significant
+} I2C_BYTE_ORDER;
+
 /***************************************************************************//**
  * @addtogroup i2c
  * @{
@@ -34,16 +88,80 @@
 // private variables
 //***********************************************************************************
 
+// Descriptor of a transfer: the bytes in write are sent after the address,
+// then read_len bytes are read back after a repeated START. A transfer with
+// nothing to write starts with the read address.
 typedef struct {
-	uint32_t 					STATE;				// Current state of i2c state machine
-	I2C_TypeDef                 *i2c;					//Which I2C peripheral is being used
-	uint32_t					slaveAddress;               //address of slave unit being accessed
-	uint32_t					Command;               //address of slave unit being accessed
-	uint32_t					*Data;
-	uint32_t                    SI7021_Read_CB;
-	uint8_t                     writeData;
-
-}   I2C_STATE_MACHINE;
+	uint32_t					address;				// 7-bit slave address
+	uint8_t						write[I2C_WRITE_MAX];	// command or register first, then data
+	uint32_t					write_len;
+	uint32_t					read_len;				// 0 for a write only transfer
+	I2C_BYTE_ORDER				order;					// how the first four bytes read make up the result
+	uint8_t						*rx;					// optional buffer for all read_len bytes, for bursts
+	uint32_t					*data;					// optional copy of the result, only written on success
+	I2C_STATUS					*status;				// optional copy of how the transfer ended
+	uint32_t					event;					// posted when done with the result as its payload, 0 on failure
+}   I2C_TRANSFER;
+
+// Counters of one kind of transaction, copied out with i2c_stats_snapshot().
+// A transaction is one i2c_transfer(), timed from when it goes on the bus to
+// when its event is posted, so the waits between retries are included.
+typedef struct {
+	uint8_t						bus;				// 0 for I2C0, 1 for I2C1
+	uint8_t						address;			// 7-bit slave address
+	uint16_t					command;			// first byte written, I2C_STATS_NO_COMMAND if none
+	uint32_t					count;				// transactions completed
+	uint32_t					failed;				// of which ran out of retries
+	uint32_t					nack_retries;		// retries after a NACK, e.g. a si7021 still converting
+	uint32_t					error_retries;		// retries after a bus error
+	uint32_t					bytes;				// bytes written and read after the address, successful ones only
+	uint64_t					ticks;				// time on the bus, in RTCC ticks
+	uint32_t					max_ticks;			// longest transaction
+}   I2C_STATS;
+
+// What ties a bus to its peripheral, one constant entry per I2C in i2c.c
+typedef struct {
+	I2C_TypeDef					*i2c;
+	CMU_Clock_TypeDef			clock;
+	IRQn_Type					irq;
+	SLEEP_OWNER					owner;				// holds the bus's EM2 block
+	uint32_t					retry_event;		// posted by the backoff timer
+	uint32_t					tx_ch;				// LDMA channel filling TXDATA
+	uint32_t					rx_ch;				// LDMA channel emptying RXDATA
+	LDMA_PeripheralSignal_t		tx_signal;
+	LDMA_PeripheralSignal_t		rx_signal;
+}   I2C_INSTANCE;
+
+// A bus runs one transfer at a time, the others wait in order in the queue.
+// head is only moved by i2c_transfer() with interrupts masked, tail only by
+// the interrupt handler. What the interrupt handler works on comes first,
+// the queue is only read when a transfer ends.
+typedef struct {
+	I2C_TypeDef					*i2c;
+	const I2C_INSTANCE			*instance;
+	uint32_t					state;				// where active is in the transition table
+	uint32_t					resume;				// state active is sent again from, I2C_IDLE if none
+	uint32_t					tx_pos;				// bytes of active written
+	uint32_t					rx_pos;				// bytes of active read
+	uint32_t					result;
+	I2C_STATUS					status;				// why the last try of active failed
+	uint32_t					attempts;			// retries of active so far
+	uint32_t					nacks;				// of which after a NACK
+	uint32_t					started;			// RTCC count active went on the bus at
+	bool						ldma;				// bytes are moved by the LDMA
+	volatile bool				busy;				// active holds a transfer
+	I2C_TRANSFER				active;				// transfer on the bus
+
+	uint8_t						tx_buf[I2C_WRITE_MAX + 1];	// write address, then the bytes to write
+	uint8_t						read_address;		// sent after the repeated START
+	uint8_t						rx_buf[4];			// bytes read, for a transfer without a buffer
+	LDMA_Descriptor_t			tx_desc[3];
+	LDMA_Descriptor_t			rx_desc[3];
+
+	volatile uint32_t			head;
+	volatile uint32_t			tail;
+	I2C_TRANSFER				queue[I2C_QUEUE_SIZE];
+}   I2C_BUS;
 
 
 //***********************************************************************************
@@ -79,7 +197,19 @@ void I2C0_IRQHandler(void);
 
 void I2C1_IRQHandler(void);
 
-void I2C_Start(I2C_TypeDef *i2c, uint32_t *data, uint32_t address, uint32_t I2C_CB, uint32_t Command, uint16_t writeData);
+bool i2c_transfer(I2C_TypeDef *i2c, const I2C_TRANSFER *transfer);
+
+void scheduled_i2c0_retry_cb(void);
+
+void scheduled_i2c1_retry_cb(void);
+
+uint32_t i2c_stats_snapshot(I2C_STATS stats[I2C_STATS_SIZE], uint32_t *untracked);
+
+void i2c_stats_clear(void);
+
+void i2c_stats_ble(void);
+
+void i2c_stats_dump(COROUTINE *cr);
 
 
 #endif /* SRC_HEADER_FILES_I2C_H_ */
@@ -16,12 +16,14 @@
 /* The developer's include statements */
 #include "sleep_routines.h"
 #include "scheduler.h"
+#include "trace.h"
 
 //***********************************************************************************
 // defined files
 //***********************************************************************************
 #define LETIMER_HZ		1000			// Utilizing ULFRCO oscillator for LETIMERs
 #define LETIMER_EM      EM4             // Using the ULFRCO, block from entering Energy Mode 4
+#define LETIMER_TIMER_MS	(1000 / LETIMER_HZ)	// software timer resolution, one LETIMER count
 
 //***********************************************************************************
 // global variables
@@ -38,8 +40,6 @@ typedef struct {
 
 	bool            comp0_irq_enable;
 	uint32_t        comp0_cb;
-	bool            comp1_irq_enable;
-	uint32_t        comp1_cb;
 	bool            uf_irq_enable;
 	uint32_t        uf_cb;
 
@@ -52,5 +52,10 @@ typedef struct {
 void letimer_pwm_open(LETIMER_TypeDef *letimer, APP_LETIMER_PWM_TypeDef *app_letimer_struct);
 void letimer_start(LETIMER_TypeDef *letimer, bool enable);
 void LETIMER0_IRQHandler(void);
+uint32_t letimer_timer_now(void);
+void letimer_timer_start(uint32_t event, uint32_t ms, bool periodic);
+void letimer_timer_stop(uint32_t event);
+bool letimer_timer_armed(uint32_t event);
+bool letimer_timers_idle(void);
 
 #endif
@@ -19,6 +19,7 @@
 #include "sleep_routines.h"
 #include "scheduler.h"
 #include "brd_config.h"
+#include "trace.h"
 
 
 
@@ -29,9 +30,6 @@
 #define LEUART_TX_EM		EM2
 #define LEUART_RX_EM		EM2
 
-//
-#define BLE_TX_DONE_CB              0x00000020 //0b100000
-
 /***************************************************************************//**
  * @addtogroup leuart
  * @{
@@ -0,0 +1,40 @@
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#ifndef	RTCC_HG
+#define	RTCC_HG
+
+/* System include statements */
+#include <stdint.h>
+
+/* Silicon Labs include statements */
+#include "em_rtcc.h"
+#include "em_cmu.h"
+#include "em_assert.h"
+
+/* The developer's include statements */
+
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+#define RTCC_HZ			32768			// RTCC counts the LFXO without a prescaler
+
+// Compare channel that wakes the chip from EM4H, and its interrupt flag
+#define RTCC_WAKEUP_CH		1
+#define RTCC_WAKEUP_IF		RTCC_IF_CC1
+
+//***********************************************************************************
+// global variables
+//***********************************************************************************
+
+
+//***********************************************************************************
+// function prototypes
+//***********************************************************************************
+void rtcc_open(void);
+uint32_t rtcc_timestamp(void);
+void rtcc_wakeup_at(uint32_t count);
+void rtcc_wakeup_clear(void);
+
+#endif
@@ -6,6 +6,8 @@
 
 /* Standard Libraries             */
 #include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
 
 /* Silicon Labs include statements */
 #include "em_assert.h"
@@ -16,16 +18,98 @@
 
 /* The developer's include statements */
 #include "sleep_routines.h"
+#include "rtcc.h"
+#include "events.h"
+#include "coroutine.h"
+#include "atomic.h"
+#include "trace.h"
 
 //***********************************************************************************
 // defined files
 //***********************************************************************************
 
+// Words of the pending event bitmap, SCHEDULER_EVENT_COUNT comes from events.h
+#define SCHEDULER_EVENT_WORDS		((SCHEDULER_EVENT_COUNT + 31) / 32)
+
+// Handler run by scheduler_dispatch() when its event bit is set
+typedef void (*SCHEDULER_CB)(void);
+
+// Dispatch order, pending events of a higher priority always run first
+typedef enum {
+	SCHEDULER_PRIORITY_HIGH,		// completions that keep a peripheral busy
+	SCHEDULER_PRIORITY_NORMAL,		// timer and sequencing events
+	SCHEDULER_PRIORITY_LOW,			// bulk work such as formatting output
+	SCHEDULER_PRIORITY_COUNT
+} SCHEDULER_PRIORITY;
+
+// Budget value for an event that may run any number of times per pass
+#define SCHEDULER_NO_BUDGET			0
+
+// Capacity of the event record queue, must be a power of two
+#define SCHEDULER_QUEUE_SIZE		16
+
+// Event posted together with a value, queued instead of setting a bit
+typedef struct {
+	uint32_t	event;				// ID of the event the record was posted for
+	uint32_t	payload;			// value handed to the handler
+	uint32_t	status;				// how the work behind the post ended, 0 if it succeeded
+	uint32_t	timestamp;			// RTCC count when the record was posted
+} SCHEDULER_RECORD;
+
+// Handler run by scheduler_dispatch() for each record of its event
+typedef void (*SCHEDULER_RECORD_CB)(const SCHEDULER_RECORD *record);
+
+// Coroutine resumed by scheduler_dispatch() each time its event is posted
+typedef void (*SCHEDULER_COROUTINE_CB)(COROUTINE *cr);
+
+// Entry of the dispatch table, one per event in events.h
+typedef struct {
+	SCHEDULER_CB		callback;			// BIT handler, NULL otherwise
+	SCHEDULER_RECORD_CB	record_callback;	// RECORD handler, NULL otherwise
+	SCHEDULER_COROUTINE_CB	coroutine;		// COROUTINE handler, NULL otherwise
+	uint8_t				priority;			// SCHEDULER_PRIORITY of the event
+	uint8_t				budget;				// runs per pass, or SCHEDULER_NO_BUDGET
+} SCHEDULER_EVENT_ENTRY;
+
+// Handler field of a table entry for each kind of event in events.h
+#define SCHEDULER_KIND_BIT(handler)			.callback = (handler)
+#define SCHEDULER_KIND_RECORD(handler)		.record_callback = (handler)
+#define SCHEDULER_KIND_COROUTINE(handler)	.coroutine = (handler)
+#define SCHEDULER_KIND_NONE(handler)		.callback = NULL
+
+// Expands a line of SCHEDULER_EVENT_LIST into its table entry
+#define SCHEDULER_TABLE_ENTRY(id, kind, fn, prio, runs) \
+	[id] = { SCHEDULER_KIND_##kind(fn), .priority = (prio), .budget = (runs) },
+
+// Expands a line of SCHEDULER_EVENT_LIST into compile time checks of its fields
+#define SCHEDULER_TABLE_CHECK(id, kind, fn, prio, runs) \
+	_Static_assert((prio) < SCHEDULER_PRIORITY_COUNT, #id " has no valid priority"); \
+	_Static_assert((runs) <= UINT8_MAX, #id " budget does not fit the table");
+
+// Buckets of the latency histograms. Bucket 0 counts waits of 0 RTCC ticks,
+// bucket n waits of 2^(n-1) up to 2^n - 1 ticks, and the last bucket
+// everything longer.
+#define SCHEDULER_LATENCY_BUCKETS	16
+
+// Per event counters, copied out with scheduler_stats_snapshot()
+typedef struct {
+	uint32_t	posted;				// posts of the event, as a bit or as a record
+	uint32_t	coalesced;			// bit posts merged into a post still pending
+	uint32_t	dropped;			// record posts lost to a full queue
+	uint32_t	dispatched;			// handler runs
+	uint32_t	max_pending;		// longest wait from post to handler, in RTCC ticks
+	uint32_t	max_run;			// longest handler run, in RTCC ticks
+	uint32_t	latency[SCHEDULER_LATENCY_BUCKETS];		// post to handler waits, log2 buckets
+} SCHEDULER_STATS;
+
 
 //***********************************************************************************
 // global variables
 //***********************************************************************************
 
+// Dispatch table, defined by the application from SCHEDULER_EVENT_LIST
+extern const SCHEDULER_EVENT_ENTRY scheduler_event_table[SCHEDULER_EVENT_COUNT];
+
 
 //***********************************************************************************
 // function prototypes
@@ -33,7 +117,13 @@
 void scheduler_open(void);
 void add_scheduled_event(uint32_t event);
 void remove_scheduled_event(uint32_t event);
-uint32_t get_scheduled_events(void);
+bool check_scheduled_event(uint32_t event);
+void scheduler_post(uint32_t event, uint32_t payload, uint32_t status);
+uint32_t scheduler_records_dropped(void);
+bool scheduler_pending(void);
+void scheduler_stats_snapshot(SCHEDULER_STATS stats[SCHEDULER_EVENT_COUNT]);
+void scheduler_stats_clear(void);
+void scheduler_dispatch(void);
 
 
 #endif
@@ -13,6 +13,11 @@
 #include "em_assert.h"
 #include "em_int.h"
 
+/* The developer's include statements */
+#include "atomic.h"
+#include "trace.h"
+#include "rtcc.h"
+
 //***********************************************************************************
 // defined files
 //***********************************************************************************
@@ -23,6 +28,38 @@
 #define 		EM4 				4
 #define 	MAX_ENERGY_MODES 		5
 
+// Every holder of sleep blocks, one line each. The position of a line is
+// the owner's handle, passed with each block and unblock so the blocks can
+// be charged to the driver that holds them.
+#define SLEEP_OWNER_LIST(X) \
+	X(SLEEP_OWNER_APP) \
+	X(SLEEP_OWNER_LETIMER0) \
+	X(SLEEP_OWNER_I2C0) \
+	X(SLEEP_OWNER_I2C1)
+
+// Owner handles, numbered in list order
+#define SLEEP_OWNER_ID(owner)		owner,
+typedef enum {
+	SLEEP_OWNER_LIST(SLEEP_OWNER_ID)
+	SLEEP_OWNER_COUNT
+} SLEEP_OWNER;
+#undef SLEEP_OWNER_ID
+
+// Blocks of one owner, copied out with sleep_owner_snapshot()
+typedef struct {
+	uint32_t	blocks[MAX_ENERGY_MODES];	// blocks held now, per mode
+	uint32_t	block_calls;				// calls of sleep_block_mode()
+	uint32_t	unbalanced;					// unblocks of a mode the owner did not hold
+	uint64_t	ticks;						// time holding any block, in RTCC ticks
+} SLEEP_OWNER_STATS;
+
+// Time spent in each energy mode, copied out with sleep_stats_snapshot().
+// EM0 holds the time awake and counts the wake ups.
+typedef struct {
+	uint64_t	ticks[MAX_ENERGY_MODES];		// time in the mode, in RTCC ticks
+	uint32_t	entries[MAX_ENERGY_MODES];		// times the mode was entered
+} SLEEP_STATS;
+
 //***********************************************************************************
 // global variables
 //***********************************************************************************
@@ -32,10 +69,14 @@
 // function prototypes
 //***********************************************************************************
 void sleep_open(void);
-void sleep_block_mode(uint32_t EM);
-void sleep_unblock_mode(uint32_t EM);
+void sleep_block_mode(uint32_t EM, SLEEP_OWNER owner);
+void sleep_unblock_mode(uint32_t EM, SLEEP_OWNER owner);
 void enter_sleep(void);
 uint32_t current_block_energy_mode(void);
+uint32_t sleep_blocked_modes(void);
+void sleep_stats_snapshot(SLEEP_STATS *stats);
+void sleep_stats_clear(void);
+void sleep_owner_snapshot(SLEEP_OWNER_STATS stats[SLEEP_OWNER_COUNT]);
 
 
 #endif
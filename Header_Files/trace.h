@@ -0,0 +1,79 @@
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#ifndef	TRACE_HG
+#define	TRACE_HG
+
+/* System include statements */
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Silicon Labs include statements */
+#include "em_assert.h"
+
+/* The developer's include statements */
+#include "rtcc.h"
+#include "atomic.h"
+#include "coroutine.h"
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+
+// Comment out to compile every TRACE() away
+#define TRACE_ENABLED
+
+// Entries kept, the oldest are overwritten. Must be a power of two, the host
+// build raises it to keep a whole run.
+#ifndef TRACE_RING_SIZE
+#define TRACE_RING_SIZE			512
+#endif
+
+// Time between checks of the BLE link while the ring is dumped
+#define TRACE_DUMP_POLL_MS		20
+
+// What an entry records, source and arg depend on it
+typedef enum {
+	TRACE_IRQ_ENTER,			// source IRQn, arg the interrupt flags being handled
+	TRACE_IRQ_EXIT,				// source IRQn
+	TRACE_POST,					// source event ID, arg low half of a record's payload
+	TRACE_HANDLER_BEGIN,		// source event ID
+	TRACE_HANDLER_END,			// source event ID
+	TRACE_SLEEP,				// source energy mode entered
+	TRACE_WAKE,					// source energy mode left
+	TRACE_BLOCK,				// source energy mode, arg blocks after the call
+	TRACE_UNBLOCK,				// source energy mode, arg blocks after the call
+	TRACE_ID_COUNT
+} TRACE_ID;
+
+// One entry of the ring, eight bytes
+typedef struct {
+	uint32_t	timestamp;			// RTCC count when it was written
+	uint8_t		id;					// TRACE_ID
+	uint8_t		source;				// interrupt, event or energy mode
+	uint16_t	arg;				// extra detail, see TRACE_ID
+} TRACE_ENTRY;
+
+#ifdef TRACE_ENABLED
+#define TRACE(id, source, arg)		trace_write((id), (source), (arg))
+#else
+#define TRACE(id, source, arg)		((void)0)
+#endif
+
+//***********************************************************************************
+// global variables
+//***********************************************************************************
+
+
+//***********************************************************************************
+// function prototypes
+//***********************************************************************************
+void trace_open(void);
+void trace_write(uint32_t id, uint32_t source, uint32_t arg);
+void trace_start(void);
+void trace_stop(void);
+uint32_t trace_snapshot(TRACE_ENTRY *entries, uint32_t max);
+void trace_dump_ble(void);
+void trace_dump(COROUTINE *cr);
+
+#endif
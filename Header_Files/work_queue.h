@@ -0,0 +1,55 @@
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#ifndef	WORK_QUEUE_HG
+#define	WORK_QUEUE_HG
+
+/* System include statements */
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/* Silicon Labs include statements */
+#include "em_assert.h"
+
+/* The developer's include statements */
+#include "atomic.h"
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+
+// Capacity of the work queue, must be a power of two
+#define WORK_QUEUE_SIZE			16
+
+// Deferred function, run from the main loop with the context it was submitted with
+typedef void (*WORK_FN)(void *ctx);
+
+// Item of the work queue, fn is NULL while the slot is free or still being filled
+typedef struct {
+	WORK_FN		fn;
+	void		*ctx;
+} WORK_ITEM;
+
+// Counters copied out with work_queue_stats()
+typedef struct {
+	uint32_t	submitted;			// items queued
+	uint32_t	dropped;			// items lost to a full queue
+	uint32_t	max_depth;			// most items waiting at once
+} WORK_QUEUE_STATS;
+
+//***********************************************************************************
+// global variables
+//***********************************************************************************
+
+
+//***********************************************************************************
+// function prototypes
+//***********************************************************************************
+void work_queue_open(void);
+bool work_submit(WORK_FN fn, void *ctx);
+bool work_queue_pending(void);
+void work_queue_drain(void);
+void work_queue_stats(WORK_QUEUE_STATS *stats);
+
+#endif
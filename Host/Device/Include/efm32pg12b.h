@@ -0,0 +1,109 @@
+/**
+ * @file efm32pg12b.h
+ * @author James Brennan
+ * @date October 16th, 2026
+ * @brief Host stand-in for the EFM32PG12B CMSIS device header. Peripheral
+ * register blocks keep their on-chip layout and base addresses; the host bus
+ * maps that address window so that every firmware register access is seen by
+ * the peripheral models in Host/Source_Files.
+ *
+ */
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#ifndef	EFM32PG12B_HG
+#define	EFM32PG12B_HG
+
+/* System include statements */
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+
+#define __I		volatile const		// read only register
+#define __O		volatile			// write only register
+#define __IOM	volatile			// read / write register
+
+/* Interrupt numbers, only the sources modeled by the host build are listed */
+typedef enum {
+	TIMER0_IRQn			= 5,
+	LDMA_IRQn			= 8,
+	I2C0_IRQn			= 10,
+	LEUART0_IRQn		= 14,
+	LETIMER0_IRQn		= 19,
+	I2C1_IRQn			= 30,
+	HOST_IRQ_COUNT		= 32
+} IRQn_Type;
+
+/* Peripheral base addresses, identical to the device memory map */
+#define PERIPH_BASE			(0x40000000UL)
+#define PERIPH_SIZE			(0x00100000UL)
+#define TIMER0_BASE			(0x40018000UL)
+#define I2C0_BASE			(0x4000C000UL)
+#define I2C1_BASE			(0x4000C400UL)
+#define LETIMER0_BASE		(0x40046000UL)
+#define LEUART0_BASE		(0x4004A000UL)
+#define RTCC_BASE			(0x40042000UL)
+#define LDMA_BASE			(0x400E2000UL)
+
+#include "efm32pg12b_i2c.h"
+#include "efm32pg12b_leuart.h"
+#include "efm32pg12b_letimer.h"
+#include "efm32pg12b_timer.h"
+#include "efm32pg12b_rtcc.h"
+#include "efm32pg12b_rmu.h"
+#include "efm32pg12b_ldma.h"
+
+#define TIMER0				((TIMER_TypeDef *) TIMER0_BASE)
+#define I2C0				((I2C_TypeDef *) I2C0_BASE)
+#define I2C1				((I2C_TypeDef *) I2C1_BASE)
+#define LETIMER0			((LETIMER_TypeDef *) LETIMER0_BASE)
+#define LEUART0				((LEUART_TypeDef *) LEUART0_BASE)
+#define RTCC				((RTCC_TypeDef *) RTCC_BASE)
+#define LDMA				((LDMA_TypeDef *) LDMA_BASE)
+
+/* Peripheral counts */
+#define I2C_COUNT			2
+
+//***********************************************************************************
+// function prototypes
+//***********************************************************************************
+
+/* Cortex-M4 core functions, implemented by the host interrupt controller */
+void NVIC_EnableIRQ(IRQn_Type IRQn);
+void NVIC_DisableIRQ(IRQn_Type IRQn);
+void NVIC_ClearPendingIRQ(IRQn_Type IRQn);
+
+static inline void __NOP(void) {}
+static inline void __DMB(void) { __atomic_thread_fence(__ATOMIC_SEQ_CST); }
+static inline void __DSB(void) { __atomic_thread_fence(__ATOMIC_SEQ_CST); }
+static inline void __ISB(void) { __atomic_thread_fence(__ATOMIC_SEQ_CST); }
+
+/* Exclusive access. The reservation is the address and the value LDREX read,
+   and STREX stores only if the word still holds that value, which a C11
+   compare and swap checks in one step. The reservation belongs to the calling
+   thread, so the atomics also hold between the threads of the host benchmarks. */
+static _Thread_local volatile uint32_t *host_exclusive_addr;
+static _Thread_local uint32_t host_exclusive_value;
+
+static inline uint32_t __LDREXW(volatile uint32_t *addr){
+	host_exclusive_addr = addr;
+	host_exclusive_value = __atomic_load_n(addr, __ATOMIC_SEQ_CST);
+	return host_exclusive_value;
+}
+
+static inline uint32_t __STREXW(uint32_t value, volatile uint32_t *addr){
+	uint32_t expected = host_exclusive_value;
+	bool reserved = (addr == host_exclusive_addr);
+
+	host_exclusive_addr = NULL;
+	return !(reserved && __atomic_compare_exchange_n(addr, &expected, value, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST));
+}
+
+static inline void __CLREX(void) { host_exclusive_addr = NULL; }
+
+#endif
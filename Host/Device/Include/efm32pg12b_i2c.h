@@ -0,0 +1,116 @@
+/**
+ * @file efm32pg12b_i2c.h
+ * @author James Brennan
+ * @date October 16th, 2026
+ * @brief Host stand-in for the EFM32PG12B I2C register block and bit fields.
+ *
+ */
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#ifndef	EFM32PG12B_I2C_HG
+#define	EFM32PG12B_I2C_HG
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+
+typedef struct {
+	__IOM uint32_t	CTRL;			// Control Register
+	__IOM uint32_t	CMD;			// Command Register
+	__I uint32_t	STATE;			// State Register
+	__I uint32_t	STATUS;			// Status Register
+	__IOM uint32_t	CLKDIV;			// Clock Division Register
+	__IOM uint32_t	SADDR;			// Slave Address Register
+	__IOM uint32_t	SADDRMASK;		// Slave Address Mask Register
+	__I uint32_t	RXDATA;			// Receive Buffer Data Register
+	__I uint32_t	RXDOUBLE;		// Receive Buffer Double Data Register
+	__I uint32_t	RXDATAP;		// Receive Buffer Data Peek Register
+	__I uint32_t	RXDOUBLEP;		// Receive Buffer Double Data Peek Register
+	__IOM uint32_t	TXDATA;			// Transmit Buffer Data Register
+	__IOM uint32_t	TXDOUBLE;		// Transmit Buffer Double Data Register
+	__I uint32_t	IF;				// Interrupt Flag Register
+	__IOM uint32_t	IFS;			// Interrupt Flag Set Register
+	__IOM uint32_t	IFC;			// Interrupt Flag Clear Register
+	__IOM uint32_t	IEN;			// Interrupt Enable Register
+	__IOM uint32_t	ROUTEPEN;		// I/O Routing Pin Enable Register
+	__IOM uint32_t	ROUTELOC0;		// I/O Routing Location Register
+} I2C_TypeDef;
+
+/* CTRL */
+#define I2C_CTRL_EN						(0x1UL << 0)
+#define I2C_CTRL_SLAVE					(0x1UL << 1)
+#define I2C_CTRL_AUTOACK				(0x1UL << 2)
+#define _I2C_CTRL_CLHR_SHIFT			8
+#define _I2C_CTRL_CLHR_MASK				(0x3UL << 8)
+#define _I2C_CTRL_BITO_SHIFT			12
+#define _I2C_CTRL_BITO_MASK				(0x3UL << 12)
+#define I2C_CTRL_BITO_OFF				(0x0UL << 12)
+#define I2C_CTRL_BITO_40PCC				(0x1UL << 12)
+#define I2C_CTRL_BITO_80PCC				(0x2UL << 12)
+#define I2C_CTRL_BITO_160PCC			(0x3UL << 12)
+#define I2C_CTRL_GIBITO					(0x1UL << 15)
+#define _I2C_CTRL_CLTO_SHIFT			16
+#define _I2C_CTRL_CLTO_MASK				(0x7UL << 16)
+#define I2C_CTRL_CLTO_OFF				(0x0UL << 16)
+#define I2C_CTRL_CLTO_40PCC				(0x1UL << 16)
+#define I2C_CTRL_CLTO_80PCC				(0x2UL << 16)
+#define I2C_CTRL_CLTO_160PCC			(0x3UL << 16)
+#define I2C_CTRL_CLTO_320PCC			(0x4UL << 16)
+#define I2C_CTRL_CLTO_1024PCC			(0x5UL << 16)
+
+/* CMD */
+#define I2C_CMD_START					(0x1UL << 0)
+#define I2C_CMD_STOP					(0x1UL << 1)
+#define I2C_CMD_ACK						(0x1UL << 2)
+#define I2C_CMD_NACK					(0x1UL << 3)
+#define I2C_CMD_CONT					(0x1UL << 4)
+#define I2C_CMD_ABORT					(0x1UL << 5)
+#define I2C_CMD_CLEARTX					(0x1UL << 6)
+#define I2C_CMD_CLEARPC					(0x1UL << 7)
+
+/* STATE */
+#define I2C_STATE_BUSY					(0x1UL << 0)
+#define I2C_STATE_MASTER				(0x1UL << 1)
+#define I2C_STATE_TRANSMITTER			(0x1UL << 2)
+#define I2C_STATE_NACKED				(0x1UL << 3)
+#define I2C_STATE_BUSHOLD				(0x1UL << 4)
+#define _I2C_STATE_STATE_SHIFT			5
+#define _I2C_STATE_STATE_MASK			(0x7UL << 5)
+#define I2C_STATE_STATE_IDLE			(0x0UL << 5)
+#define I2C_STATE_STATE_WAIT			(0x1UL << 5)
+#define I2C_STATE_STATE_START			(0x2UL << 5)
+#define I2C_STATE_STATE_ADDR			(0x3UL << 5)
+#define I2C_STATE_STATE_ADDRACK			(0x4UL << 5)
+#define I2C_STATE_STATE_DATA			(0x5UL << 5)
+#define I2C_STATE_STATE_DATAACK			(0x6UL << 5)
+
+/* STATUS */
+#define I2C_STATUS_TXC					(0x1UL << 6)
+#define I2C_STATUS_TXBL					(0x1UL << 7)
+#define I2C_STATUS_RXDATAV				(0x1UL << 8)
+
+/* IF, IFS, IFC and IEN share one bit layout */
+#define I2C_IF_START					(0x1UL << 0)
+#define I2C_IF_RSTART					(0x1UL << 1)
+#define I2C_IF_ADDR						(0x1UL << 2)
+#define I2C_IF_TXC						(0x1UL << 3)
+#define I2C_IF_TXBL						(0x1UL << 4)
+#define I2C_IF_RXDATAV					(0x1UL << 5)
+#define I2C_IF_ACK						(0x1UL << 6)
+#define I2C_IF_NACK						(0x1UL << 7)
+#define I2C_IF_MSTOP					(0x1UL << 8)
+#define I2C_IF_ARBLOST					(0x1UL << 9)
+#define I2C_IF_BUSERR					(0x1UL << 10)
+#define I2C_IF_BUSHOLD					(0x1UL << 11)
+#define I2C_IF_TXOF						(0x1UL << 12)
+#define I2C_IF_RXUF						(0x1UL << 13)
+#define I2C_IF_BITO						(0x1UL << 14)
+#define I2C_IF_CLTO						(0x1UL << 15)
+#define I2C_IF_SSTOP					(0x1UL << 16)
+#define I2C_IF_RXFULL					(0x1UL << 17)
+#define I2C_IF_CLERR					(0x1UL << 18)
+#define _I2C_IF_MASK					0x0007FFFFUL
+
+#endif
@@ -0,0 +1,76 @@
+/**
+ * @file efm32pg12b_ldma.h
+ * @author James Brennan
+ * @date October 17th, 2026
+ * @brief Host stand-in for the EFM32PG12B LDMA register block and bit fields.
+ *
+ */
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#ifndef	EFM32PG12B_LDMA_HG
+#define	EFM32PG12B_LDMA_HG
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+
+#define DMA_CHAN_COUNT					8
+
+typedef struct {
+	__IOM uint32_t	REQSEL;			// Channel Peripheral Request Select Register
+	__IOM uint32_t	CFG;			// Channel Configuration Register
+	__IOM uint32_t	LOOP;			// Channel Loop Counter Register
+	__IOM uint32_t	CTRL;			// Channel Descriptor Control Word Register
+	__IOM uint32_t	SRC;			// Channel Descriptor Source Data Address Register
+	__IOM uint32_t	DST;			// Channel Descriptor Destination Data Address Register
+	__IOM uint32_t	LINK;			// Channel Descriptor Link Structure Address Register
+	uint32_t		RESERVED0[5];
+} LDMA_CH_TypeDef;
+
+typedef struct {
+	__IOM uint32_t	CTRL;			// DMA Control Register
+	__I uint32_t	STATUS;			// DMA Status Register
+	__IOM uint32_t	SYNC;			// DMA Synchronization Trigger Register
+	uint32_t		RESERVED0[5];
+	__IOM uint32_t	CHEN;			// DMA Channel Enable Register
+	__I uint32_t	CHBUSY;			// DMA Channel Busy Register
+	__IOM uint32_t	CHDONE;			// DMA Channel Linking Done Register
+	__IOM uint32_t	DBGHALT;		// Debug Halt Register
+	__O uint32_t	SWREQ;			// DMA Channel Software Transfer Request Register
+	__IOM uint32_t	REQDIS;			// DMA Channel Request Disable Register
+	__I uint32_t	REQPEND;		// DMA Channel Requests Pending Register
+	__O uint32_t	LINKLOAD;		// DMA Channel Link Load Register
+	__O uint32_t	REQCLEAR;		// DMA Channel Request Clear Register
+	uint32_t		RESERVED1[7];
+	__I uint32_t	IF;				// Interrupt Flag Register
+	__O uint32_t	IFS;			// Interrupt Flag Set Register
+	__O uint32_t	IFC;			// Interrupt Flag Clear Register
+	__IOM uint32_t	IEN;			// Interrupt Enable Register
+	uint32_t		RESERVED2[4];
+	LDMA_CH_TypeDef	CH[DMA_CHAN_COUNT];
+} LDMA_TypeDef;
+
+/* CH REQSEL */
+#define _LDMA_CH_REQSEL_SIGSEL_SHIFT		0
+#define _LDMA_CH_REQSEL_SIGSEL_MASK			(0xFUL << 0)
+#define _LDMA_CH_REQSEL_SOURCESEL_SHIFT		16
+#define _LDMA_CH_REQSEL_SOURCESEL_MASK		(0x3FUL << 16)
+#define LDMA_CH_REQSEL_SOURCESEL_NONE		(0x00UL << 16)
+#define LDMA_CH_REQSEL_SOURCESEL_I2C0		(0x0AUL << 16)
+#define LDMA_CH_REQSEL_SOURCESEL_I2C1		(0x0BUL << 16)
+#define LDMA_CH_REQSEL_SIGSEL_I2C0RXDATAV	(0x0UL << 0)
+#define LDMA_CH_REQSEL_SIGSEL_I2C0TXBL		(0x1UL << 0)
+#define LDMA_CH_REQSEL_SIGSEL_I2C1RXDATAV	(0x0UL << 0)
+#define LDMA_CH_REQSEL_SIGSEL_I2C1TXBL		(0x1UL << 0)
+
+/* IF, one DONE flag per channel */
+#define _LDMA_IF_DONE_MASK					(0xFFUL << 0)
+#define LDMA_IF_ERROR						(0x1UL << 31)
+#define _LDMA_IF_MASK						(_LDMA_IF_DONE_MASK | LDMA_IF_ERROR)
+
+/* IEN, same layout as IF */
+#define LDMA_IEN_ERROR						(0x1UL << 31)
+
+#endif
@@ -0,0 +1,70 @@
+/**
+ * @file efm32pg12b_letimer.h
+ * @author James Brennan
+ * @date October 16th, 2026
+ * @brief Host stand-in for the EFM32PG12B LETIMER register block and bit fields.
+ *
+ */
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#ifndef	EFM32PG12B_LETIMER_HG
+#define	EFM32PG12B_LETIMER_HG
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+
+typedef struct {
+	__IOM uint32_t	CTRL;			// Control Register
+	__IOM uint32_t	CMD;			// Command Register
+	__I uint32_t	STATUS;			// Status Register
+	__IOM uint32_t	CNT;			// Counter Value Register
+	__IOM uint32_t	COMP0;			// Compare Value Register 0
+	__IOM uint32_t	COMP1;			// Compare Value Register 1
+	__IOM uint32_t	REP0;			// Repeat Counter Register 0
+	__IOM uint32_t	REP1;			// Repeat Counter Register 1
+	__I uint32_t	IF;				// Interrupt Flag Register
+	__IOM uint32_t	IFS;			// Interrupt Flag Set Register
+	__IOM uint32_t	IFC;			// Interrupt Flag Clear Register
+	__IOM uint32_t	IEN;			// Interrupt Enable Register
+	uint32_t		RESERVED0[1];
+	__I uint32_t	SYNCBUSY;		// Synchronization Busy Register
+	uint32_t		RESERVED1[2];
+	__IOM uint32_t	ROUTEPEN;		// I/O Routing Pin Enable Register
+	__IOM uint32_t	ROUTELOC0;		// I/O Routing Location Register
+	uint32_t		RESERVED2[2];
+	__IOM uint32_t	PRSSEL;			// PRS Input Select Register
+} LETIMER_TypeDef;
+
+/* CTRL */
+#define _LETIMER_CTRL_REPMODE_MASK		(0x3UL << 0)
+#define _LETIMER_CTRL_UFOA0_SHIFT		2
+#define _LETIMER_CTRL_UFOA1_SHIFT		4
+#define LETIMER_CTRL_OPOL0				(0x1UL << 6)
+#define LETIMER_CTRL_OPOL1				(0x1UL << 7)
+#define LETIMER_CTRL_BUFTOP				(0x1UL << 8)
+#define LETIMER_CTRL_COMP0TOP			(0x1UL << 9)
+#define LETIMER_CTRL_DEBUGRUN			(0x1UL << 12)
+
+/* CMD */
+#define LETIMER_CMD_START				(0x1UL << 0)
+#define LETIMER_CMD_STOP				(0x1UL << 1)
+#define LETIMER_CMD_CLEAR				(0x1UL << 2)
+#define LETIMER_CMD_CTO0				(0x1UL << 3)
+#define LETIMER_CMD_CTO1				(0x1UL << 4)
+
+/* STATUS */
+#define LETIMER_STATUS_RUNNING			(0x1UL << 0)
+
+/* IF, IFS, IFC and IEN share one bit layout */
+#define LETIMER_IF_COMP0				(0x1UL << 0)
+#define LETIMER_IF_COMP1				(0x1UL << 1)
+#define LETIMER_IF_UF					(0x1UL << 2)
+#define LETIMER_IF_REP0					(0x1UL << 3)
+#define LETIMER_IF_REP1					(0x1UL << 4)
+
+#define _LETIMER_CNT_MASK				0xFFFFUL
+
+#endif
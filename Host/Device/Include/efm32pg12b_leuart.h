@@ -0,0 +1,85 @@
+/**
+ * @file efm32pg12b_leuart.h
+ * @author James Brennan
+ * @date October 16th, 2026
+ * @brief Host stand-in for the EFM32PG12B LEUART register block and bit fields.
+ *
+ */
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#ifndef	EFM32PG12B_LEUART_HG
+#define	EFM32PG12B_LEUART_HG
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+
+typedef struct {
+	__IOM uint32_t	CTRL;			// Control Register
+	__IOM uint32_t	CMD;			// Command Register
+	__I uint32_t	STATUS;			// Status Register
+	__IOM uint32_t	CLKDIV;			// Clock Control Register
+	__IOM uint32_t	STARTFRAME;		// Start Frame Register
+	__IOM uint32_t	SIGFRAME;		// Signal Frame Register
+	__I uint32_t	RXDATAX;		// Receive Buffer Data Extended Register
+	__I uint32_t	RXDATA;			// Receive Buffer Data Register
+	__I uint32_t	RXDATAXP;		// Receive Buffer Data Extended Peek Register
+	__IOM uint32_t	TXDATAX;		// Transmit Buffer Data Extended Register
+	__IOM uint32_t	TXDATA;			// Transmit Buffer Data Register
+	__I uint32_t	IF;				// Interrupt Flag Register
+	__IOM uint32_t	IFS;			// Interrupt Flag Set Register
+	__IOM uint32_t	IFC;			// Interrupt Flag Clear Register
+	__IOM uint32_t	IEN;			// Interrupt Enable Register
+	__IOM uint32_t	PULSECTRL;		// Pulse Control Register
+	__IOM uint32_t	FREEZE;			// Freeze Register
+	__I uint32_t	SYNCBUSY;		// Synchronization Busy Register
+	uint32_t		RESERVED0[3];
+	__IOM uint32_t	ROUTEPEN;		// I/O Routing Pin Enable Register
+	__IOM uint32_t	ROUTELOC0;		// I/O Routing Location Register
+	uint32_t		RESERVED1[2];
+	__IOM uint32_t	INPUT;			// LEUART Input Register
+} LEUART_TypeDef;
+
+/* CTRL */
+#define LEUART_CTRL_DATABITS			(0x1UL << 1)
+#define _LEUART_CTRL_PARITY_SHIFT		2
+#define _LEUART_CTRL_PARITY_MASK		(0x3UL << 2)
+#define LEUART_CTRL_STOPBITS			(0x1UL << 4)
+
+/* CMD */
+#define LEUART_CMD_RXEN					(0x1UL << 0)
+#define LEUART_CMD_RXDIS				(0x1UL << 1)
+#define LEUART_CMD_TXEN					(0x1UL << 2)
+#define LEUART_CMD_TXDIS				(0x1UL << 3)
+#define LEUART_CMD_RXBLOCKEN			(0x1UL << 4)
+#define LEUART_CMD_RXBLOCKDIS			(0x1UL << 5)
+#define LEUART_CMD_CLEARTX				(0x1UL << 6)
+#define LEUART_CMD_CLEARRX				(0x1UL << 7)
+#define _LEUART_CMD_CLEARTX_MASK		0x40UL
+#define _LEUART_CMD_CLEARRX_MASK		0x80UL
+
+/* STATUS */
+#define LEUART_STATUS_RXENS				(0x1UL << 0)
+#define LEUART_STATUS_TXENS				(0x1UL << 1)
+#define LEUART_STATUS_RXBLOCK			(0x1UL << 2)
+#define LEUART_STATUS_TXC				(0x1UL << 3)
+#define LEUART_STATUS_TXBL				(0x1UL << 4)
+#define LEUART_STATUS_RXDATAV			(0x1UL << 5)
+#define LEUART_STATUS_RXFULL			(0x1UL << 6)
+#define LEUART_STATUS_TXIDLE			(0x1UL << 7)
+#define _LEUART_STATUS_TXIDLE_MASK		0x80UL
+
+/* IF, IFS, IFC and IEN share one bit layout */
+#define LEUART_IF_TXC					(0x1UL << 0)
+#define LEUART_IF_TXBL					(0x1UL << 1)
+#define LEUART_IF_RXDATAV				(0x1UL << 2)
+#define LEUART_IF_RXOF					(0x1UL << 3)
+#define LEUART_IF_RXUF					(0x1UL << 4)
+#define LEUART_IF_TXOF					(0x1UL << 5)
+#define LEUART_IEN_TXC					(0x1UL << 0)
+#define LEUART_IEN_TXBL					(0x1UL << 1)
+#define LEUART_IEN_RXDATAV				(0x1UL << 2)
+
+#endif
@@ -0,0 +1,31 @@
+/**
+ * @file efm32pg12b_rmu.h
+ * @author James Brennan
+ * @date October 16th, 2026
+ * @brief Host stand-in for the EFM32PG12B RMU register bits. The reset cause
+ * is kept by the emlib stand-in, so the register block itself is not mapped.
+ *
+ */
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#ifndef	EFM32PG12B_RMU_HG
+#define	EFM32PG12B_RMU_HG
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+
+/* RSTCAUSE */
+#define RMU_RSTCAUSE_PORST				(0x1UL << 0)
+#define RMU_RSTCAUSE_AVDDBOD			(0x1UL << 2)
+#define RMU_RSTCAUSE_DVDDBOD			(0x1UL << 3)
+#define RMU_RSTCAUSE_DECBOD				(0x1UL << 4)
+#define RMU_RSTCAUSE_EXTRST				(0x1UL << 8)
+#define RMU_RSTCAUSE_LOCKUPRST			(0x1UL << 9)
+#define RMU_RSTCAUSE_SYSREQRST			(0x1UL << 10)
+#define RMU_RSTCAUSE_WDOGRST			(0x1UL << 11)
+#define RMU_RSTCAUSE_EM4RST				(0x1UL << 16)
+
+#endif
@@ -0,0 +1,84 @@
+/**
+ * @file efm32pg12b_rtcc.h
+ * @author James Brennan
+ * @date October 16th, 2026
+ * @brief Host stand-in for the EFM32PG12B RTCC register block.
+ *
+ */
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#ifndef	EFM32PG12B_RTCC_HG
+#define	EFM32PG12B_RTCC_HG
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+
+typedef struct {
+	__IOM uint32_t	CTRL;			// CC Channel Control Register
+	__IOM uint32_t	CCV;			// Capture/Compare Value Register
+	__IOM uint32_t	TIME;			// Capture/Compare Time Register
+	__IOM uint32_t	DATE;			// Capture/Compare Date Register
+} RTCC_CC_TypeDef;
+
+typedef struct {
+	__IOM uint32_t	REG;			// Retention Register
+} RTCC_RET_TypeDef;
+
+typedef struct {
+	__IOM uint32_t		CTRL;			// Control Register
+	__IOM uint32_t		PRECNT;			// Pre-Counter Value Register
+	__IOM uint32_t		CNT;			// Counter Value Register
+	__I uint32_t		COMBCNT;		// Combined Pre-Counter and Counter Value Register
+	__IOM uint32_t		TIME;			// Time of Day Register
+	__IOM uint32_t		DATE;			// Date Register
+	__I uint32_t		IF;				// RTCC Interrupt Flags
+	__IOM uint32_t		IFS;			// Interrupt Flag Set Register
+	__IOM uint32_t		IFC;			// Interrupt Flag Clear Register
+	__IOM uint32_t		IEN;			// Interrupt Enable Register
+	__I uint32_t		STATUS;			// Status Register
+	__IOM uint32_t		CMD;			// Command Register
+	__I uint32_t		SYNCBUSY;		// Synchronization Busy Register
+	__IOM uint32_t		POWERDOWN;		// Retention RAM Power-down Register
+	__IOM uint32_t		LOCK;			// Configuration Lock Register
+	__IOM uint32_t		EM4WUEN;		// Wake Up Enable
+	RTCC_CC_TypeDef		CC[3];			// Capture/Compare Channels
+	uint32_t			RESERVED0[37];
+	RTCC_RET_TypeDef	RET[32];		// RetentionReg
+} RTCC_TypeDef;
+
+/* CTRL */
+#define RTCC_CTRL_ENABLE				(0x1UL << 0)
+#define RTCC_CTRL_DEBUGRUN				(0x1UL << 2)
+#define RTCC_CTRL_PRECCV0TOP			(0x1UL << 4)
+#define RTCC_CTRL_CCV1TOP				(0x1UL << 5)
+#define _RTCC_CTRL_CNTPRESC_SHIFT		8
+#define _RTCC_CTRL_CNTPRESC_MASK		(0xFUL << 8)
+#define RTCC_CTRL_CNTTICK				(0x1UL << 12)
+#define RTCC_CTRL_OSCFDETEN				(0x1UL << 15)
+#define RTCC_CTRL_CNTMODE				(0x1UL << 16)
+#define RTCC_CTRL_LYEARCORRDIS			(0x1UL << 17)
+
+/* IF, IFS, IFC and IEN share one bit layout */
+#define RTCC_IF_OF						(0x1UL << 0)
+#define RTCC_IF_CC0						(0x1UL << 1)
+#define RTCC_IF_CC1						(0x1UL << 2)
+#define RTCC_IF_CC2						(0x1UL << 3)
+
+/* CC_CTRL */
+#define _RTCC_CC_CTRL_MODE_MASK			(0x3UL << 0)
+#define RTCC_CC_CTRL_MODE_OFF			(0x0UL << 0)
+#define RTCC_CC_CTRL_MODE_OUTPUTCOMPARE	(0x2UL << 0)
+#define _RTCC_CC_CTRL_CMOA_SHIFT		2
+#define _RTCC_CC_CTRL_ICEDGE_SHIFT		4
+#define _RTCC_CC_CTRL_PRSSEL_SHIFT		6
+#define RTCC_CC_CTRL_COMPBASE			(0x1UL << 11)
+#define _RTCC_CC_CTRL_COMPMASK_SHIFT	12
+#define RTCC_CC_CTRL_DAYCC				(0x1UL << 17)
+
+/* EM4WUEN */
+#define RTCC_EM4WUEN_EM4WU				(0x1UL << 0)
+
+#endif
@@ -0,0 +1,54 @@
+/**
+ * @file efm32pg12b_timer.h
+ * @author James Brennan
+ * @date October 16th, 2026
+ * @brief Host stand-in for the EFM32PG12B TIMER register block. Only the
+ * registers in front of CNT are laid out, which is all HW_delay.c touches.
+ *
+ */
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#ifndef	EFM32PG12B_TIMER_HG
+#define	EFM32PG12B_TIMER_HG
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+
+typedef struct {
+	__IOM uint32_t	CTRL;			// Control Register
+	__IOM uint32_t	CMD;			// Command Register
+	__I uint32_t	STATUS;			// Status Register
+	__I uint32_t	IF;				// Interrupt Flag Register
+	__IOM uint32_t	IFS;			// Interrupt Flag Set Register
+	__IOM uint32_t	IFC;			// Interrupt Flag Clear Register
+	__IOM uint32_t	IEN;			// Interrupt Enable Register
+	__IOM uint32_t	TOP;			// Counter Top Value Register
+	__IOM uint32_t	TOPB;			// Counter Top Value Buffer Register
+	__IOM uint32_t	CNT;			// Counter Value Register
+} TIMER_TypeDef;
+
+/* CTRL */
+#define _TIMER_CTRL_MODE_MASK			(0x3UL << 0)
+#define TIMER_CTRL_OSMEN				(0x1UL << 4)
+#define TIMER_CTRL_DEBUGRUN				(0x1UL << 6)
+#define _TIMER_CTRL_PRESC_SHIFT			24
+#define _TIMER_CTRL_PRESC_MASK			(0xFUL << 24)
+
+/* CMD */
+#define TIMER_CMD_START					(0x1UL << 0)
+#define TIMER_CMD_STOP					(0x1UL << 1)
+
+/* STATUS */
+#define TIMER_STATUS_RUNNING			(0x1UL << 0)
+
+/* IF, IFS, IFC and IEN share one bit layout */
+#define TIMER_IF_OF						(0x1UL << 0)
+#define TIMER_IF_UF						(0x1UL << 1)
+
+#define _TIMER_CNT_MASK					0xFFFFUL
+#define _TIMER_TOP_RESETVALUE			0x0000FFFFUL
+
+#endif
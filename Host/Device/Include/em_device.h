@@ -0,0 +1,18 @@
+/**
+ * @file em_device.h
+ * @author James Brennan
+ * @date October 16th, 2026
+ * @brief Host stand-in for the CMSIS device selection header. The host build
+ * only knows the Pearl Gecko part used on the board.
+ *
+ */
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#ifndef	EM_DEVICE_HG
+#define	EM_DEVICE_HG
+
+#include "efm32pg12b.h"
+
+#endif
@@ -0,0 +1,11 @@
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#ifndef	HOST_HW_DELAY_HG
+#define	HOST_HW_DELAY_HG
+
+// app.h includes the delay header as HW_Delay.h, which only resolves on a case
+// insensitive file system
+#include "HW_delay.h"
+
+#endif
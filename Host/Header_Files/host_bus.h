@@ -0,0 +1,51 @@
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#ifndef	HOST_BUS_HG
+#define	HOST_BUS_HG
+
+/* System include statements */
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/* Silicon Labs include statements */
+#include "em_device.h"
+#include "em_cmu.h"
+
+/* The developer's include statements */
+
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+
+// Register access as reported to a peripheral model
+typedef enum {
+	HOST_ACCESS_PREREAD,		// firmware is about to read, refresh the register value
+	HOST_ACCESS_READ,			// firmware has read the register
+	HOST_ACCESS_WRITE,			// firmware has written the register
+	HOST_ACCESS_RESET			// chip is entering EM4H, offset is unused
+} HOST_ACCESS;
+
+typedef void (*HOST_PERIPH_FN)(void *model, uint32_t offset, HOST_ACCESS access);
+
+// Register of a model's read/write view, e.g. HOST_REG(regs, I2C_TypeDef, IF)
+#define HOST_REG(regs, type, field)	\
+	(*(volatile uint32_t *)((volatile uint8_t *)(regs) + offsetof(type, field)))
+
+// Offset of a register inside its block, for switching on HOST_PERIPH_FN offsets
+#define HOST_OFFSET(type, field)		((uint32_t)offsetof(type, field))
+
+//***********************************************************************************
+// function prototypes
+//***********************************************************************************
+void host_bus_open(void);
+void host_bus_attach(uint32_t base, uint32_t size, CMU_Clock_TypeDef clock, HOST_PERIPH_FN fn, void *model);
+volatile void *host_bus_alias(uint32_t base);
+void host_bus_reset(void);
+uint64_t host_bus_access_count(void);
+uint32_t host_bus_master_read(uint32_t address);
+void host_bus_master_write(uint32_t address, uint32_t value);
+
+#endif
@@ -0,0 +1,78 @@
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#ifndef	HOST_ENERGY_HG
+#define	HOST_ENERGY_HG
+
+/* System include statements */
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Silicon Labs include statements */
+
+/* The developer's include statements */
+#include "host_engine.h"
+
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+
+// Currents and battery figures of the energy model, each can be overridden by
+// name in the PG_ENERGY file. HF peripheral and active mode currents are per
+// MHz of HFCLK.
+typedef enum {
+	HOST_PARAM_EM0_UA_PER_MHZ,		// core running from flash, HFRCO included
+	HOST_PARAM_EM1_UA_PER_MHZ,		// core sleeping, HF clocks running
+	HOST_PARAM_EM2_UA,				// deep sleep, full RAM retention
+	HOST_PARAM_EM3_UA,				// stop, ULFRCO only
+	HOST_PARAM_EM4H_UA,				// hibernate, RTCC domain only
+	HOST_PARAM_HFXO_UA,
+	HOST_PARAM_LFXO_UA,
+	HOST_PARAM_LFRCO_UA,
+	HOST_PARAM_TIMER_UA_PER_MHZ,
+	HOST_PARAM_I2C_UA_PER_MHZ,
+	HOST_PARAM_LDMA_UA_PER_MHZ,
+	HOST_PARAM_LETIMER_UA,
+	HOST_PARAM_LEUART_UA,
+	HOST_PARAM_RTCC_UA,
+	HOST_PARAM_I2C_BUS_UA,			// pull-ups while a transfer holds the bus
+	HOST_PARAM_BLE_TX_UA,			// BLE module while the LEUART sends to it
+	HOST_PARAM_BLE_IDLE_UA,			// BLE module the rest of the time
+	HOST_PARAM_SI7021_CONV_UA,		// Si7021 during a conversion
+	HOST_PARAM_SI7021_IDLE_UA,		// Si7021 standby
+	HOST_PARAM_VEML6030_ON_UA,		// VEML6030 out of shutdown
+	HOST_PARAM_VEML6030_SD_UA,		// VEML6030 shut down
+	HOST_PARAM_SUPPLY_V,
+	HOST_PARAM_BATTERY_MAH,
+	HOST_PARAM_COUNT
+} HOST_PARAM;
+
+typedef struct HOST_LOAD HOST_LOAD;
+
+// Current drawn by a model while it is switched on or until a set time,
+// e.g. a transfer holding a bus or a sensor conversion
+struct HOST_LOAD {
+	const char		*name;		// shown in the report
+	HOST_PARAM		on;			// current while on
+	HOST_PARAM		off;		// current while off, HOST_PARAM_COUNT for none
+	bool			active;		// switched on
+	HOST_TIME		until;		// also on until this time
+	double			charge;		// uC drawn so far
+	HOST_LOAD		*next;
+};
+
+//***********************************************************************************
+// function prototypes
+//***********************************************************************************
+void host_energy_open(void);
+void host_energy_charge(uint32_t em, HOST_TIME start, HOST_TIME interval);
+void host_energy_sample(void);
+void host_energy_underflow(void);
+void host_energy_report(void);
+
+void host_load_init(HOST_LOAD *load, const char *name, HOST_PARAM on, HOST_PARAM off);
+void host_load_set(HOST_LOAD *load, bool active);
+void host_load_until(HOST_LOAD *load, HOST_TIME until);
+
+#endif
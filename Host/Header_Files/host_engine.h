@@ -0,0 +1,100 @@
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#ifndef	HOST_ENGINE_HG
+#define	HOST_ENGINE_HG
+
+/* System include statements */
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Silicon Labs include statements */
+#include "em_device.h"
+
+/* The developer's include statements */
+
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+
+// Virtual time is kept in picoseconds, enough for 213 days of simulated run time
+typedef uint64_t HOST_TIME;
+
+#define HOST_TIME_NS				1000ULL
+#define HOST_TIME_US				1000000ULL
+#define HOST_TIME_MS				1000000000ULL
+#define HOST_TIME_S					1000000000000ULL
+
+// Energy modes as tracked by the engine, numbered like sleep_routines.h
+#define HOST_EM0					0
+#define HOST_EM1					1
+#define HOST_EM2					2
+#define HOST_EM3					3
+#define HOST_EM4					4
+#define HOST_EM_COUNT				5
+
+// CPU cycles charged to virtual time for work the host can observe
+#define HOST_HAL_CALL_CYCLES		20		// one emlib call
+#define HOST_BUS_ACCESS_CYCLES		4		// one peripheral register access
+#define HOST_IRQ_ENTRY_CYCLES		12		// exception entry, stacking included
+#define HOST_IRQ_EXIT_CYCLES		10		// exception return
+#define HOST_CALL_CYCLES			4		// one firmware call intercepted by the host
+
+// Simulated run time when PG_SIM_TIME is not set in the environment
+#define HOST_DEFAULT_SIM_SECONDS	60
+
+typedef struct HOST_EVENT HOST_EVENT;
+typedef void (*HOST_EVENT_FN)(HOST_EVENT *event);
+
+struct HOST_EVENT {
+	HOST_TIME		when;		// virtual time the event fires at
+	const char		*name;		// peripheral the event belongs to, for diagnostics
+	uint32_t		lowest_em;	// deepest energy mode the peripheral keeps running in
+	HOST_EVENT_FN	fn;			// model callback
+	void			*ctx;		// model the event belongs to
+	bool			armed;		// event is queued
+	HOST_EVENT		*next;		// next event in time order
+};
+
+//***********************************************************************************
+// global variables
+//***********************************************************************************
+
+// Interrupt vector table, defined by host_startup.c
+extern void (* const host_vector_table[HOST_IRQ_COUNT])(void);
+
+//***********************************************************************************
+// function prototypes
+//***********************************************************************************
+void host_engine_open(void);
+HOST_TIME host_now(void);
+uint64_t host_time_to_ticks(HOST_TIME interval, uint32_t hz, uint32_t div);
+HOST_TIME host_ticks_to_time(uint64_t ticks, uint32_t hz, uint32_t div);
+
+void host_event_init(HOST_EVENT *event, const char *name, uint32_t lowest_em, HOST_EVENT_FN fn, void *ctx);
+void host_event_schedule(HOST_EVENT *event, HOST_TIME when);
+void host_event_cancel(HOST_EVENT *event);
+
+void host_cpu_cycles(uint32_t cycles);
+void host_sync(void);
+void host_spin(void);
+void host_sleep(uint32_t em);
+void host_hibernate(void);
+void host_em4_wakeup(bool level);
+uint32_t host_activity_epoch(void);
+void host_activity(void);
+
+void host_irq_set(IRQn_Type irq, bool level);
+void host_irq_poll(void);
+void host_irq_mask(bool masked);
+bool host_irq_masked(void);
+bool host_irq_active(void);
+uint32_t host_irq_stats(uint32_t irq, HOST_TIME *time);
+const char *host_irq_name(uint32_t irq);
+
+void host_report(void);
+void host_firmware_report(void);
+void host_warm_reset(void) __attribute__((noreturn));
+
+#endif
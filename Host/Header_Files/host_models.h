@@ -0,0 +1,60 @@
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#ifndef	HOST_MODELS_HG
+#define	HOST_MODELS_HG
+
+/* System include statements */
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Silicon Labs include statements */
+#include "em_device.h"
+#include "em_cmu.h"
+
+/* The developer's include statements */
+#include "host_engine.h"
+
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+
+// Slave on a modeled I2C bus, driven byte by byte by the I2C model
+typedef struct HOST_I2C_DEVICE HOST_I2C_DEVICE;
+
+struct HOST_I2C_DEVICE {
+	uint8_t				address;							// 7-bit slave address
+	bool				(*start)(HOST_I2C_DEVICE *dev, bool read);	// addressed, return ACK
+	bool				(*write)(HOST_I2C_DEVICE *dev, uint8_t data);	// byte from master, return ACK
+	uint8_t				(*read)(HOST_I2C_DEVICE *dev);		// byte to master
+	void				(*stop)(HOST_I2C_DEVICE *dev);		// STOP condition on the bus
+	HOST_I2C_DEVICE		*next;								// next slave on the same bus
+};
+
+//***********************************************************************************
+// function prototypes
+//***********************************************************************************
+uint32_t host_cmu_freq(CMU_Clock_TypeDef clock);
+bool host_cmu_enabled(CMU_Clock_TypeDef clock);
+bool host_cmu_osc_enabled(CMU_Osc_TypeDef osc);
+uint32_t host_cmu_lowest_em(CMU_Clock_TypeDef clock);
+void host_cmu_em4(bool retain_lfrco, bool retain_lfxo);
+void host_gpio_reset(void);
+void host_rmu_reset(uint32_t cause);
+
+void host_i2c_model_open(I2C_TypeDef *i2c, IRQn_Type irq, CMU_Clock_TypeDef clock);
+void host_i2c_attach(I2C_TypeDef *i2c, HOST_I2C_DEVICE *dev);
+void host_leuart_model_open(LEUART_TypeDef *leuart, IRQn_Type irq, CMU_Clock_TypeDef clock);
+void host_letimer_model_open(LETIMER_TypeDef *letimer, IRQn_Type irq, CMU_Clock_TypeDef clock);
+void host_timer_model_open(TIMER_TypeDef *timer, IRQn_Type irq, CMU_Clock_TypeDef clock);
+void host_rtcc_model_open(RTCC_TypeDef *rtcc, CMU_Clock_TypeDef clock);
+void host_ldma_model_open(IRQn_Type irq);
+void host_ldma_link(uint32_t ch, const void *descriptor);
+void host_ldma_request(uint32_t signal, bool level);
+void host_ldma_report(void);
+void host_i2c_report(void);
+void host_sensors_open(void);
+void host_sensors_report(void);
+
+#endif
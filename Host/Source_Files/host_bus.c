@@ -0,0 +1,407 @@
+/**
+ * @file host_bus.c
+ * @author James Brennan
+ * @date October 16th, 2026
+ * @brief Peripheral bus for the host build.
+ *
+ * @details
+ * The peripheral address window is mapped at its on-chip address with no
+ * access rights, so every register access made by the unmodified firmware
+ * faults into this file. A read first lets the model refresh the register,
+ * then the page is opened for exactly one instruction using the x86-64 trap
+ * flag; the trap that follows closes the page again and hands the completed
+ * access to the model. Models keep a second, always accessible view of the
+ * same memory for their own bookkeeping.
+ *
+ */
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+
+//** Standard Libraries
+#define _GNU_SOURCE
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <ucontext.h>
+#include <unistd.h>
+
+//** Silicon Lab include files
+#include "em_assert.h"
+
+//** User/developer include files
+#include "host_bus.h"
+#include "host_engine.h"
+#include "host_models.h"
+
+#if !defined(__x86_64__) || !defined(__linux__)
+#error "The host bus traps register accesses with the x86-64 trap flag and needs Linux on x86-64"
+#endif
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+#define HOST_BUS_PAGE_SIZE		4096UL
+#define HOST_BUS_MAX_REGIONS	16
+#define HOST_EFLAGS_TF			0x100		// x86 trap flag, single step
+#define HOST_PF_ERR_WRITE		0x2			// page fault error code, access was a write
+
+typedef struct {
+	uint32_t			base;		// first address of the register block
+	uint32_t			size;		// size of the register block in bytes
+	CMU_Clock_TypeDef	clock;		// clock gating the block
+	HOST_PERIPH_FN		fn;			// peripheral model access hook
+	void				*model;		// model instance
+} HOST_BUS_REGION;
+
+typedef struct {
+	bool				active;		// an access is being single stepped
+	HOST_BUS_REGION		*region;	// block being accessed
+	uintptr_t			address;	// faulting address
+	uintptr_t			pc;			// faulting instruction
+	bool				write;		// access is a write
+	bool				gated;		// block clock is off, the access has no effect
+	uint32_t			saved;		// register value to restore for a gated access
+} HOST_BUS_ACCESS;
+
+//***********************************************************************************
+// Private variables
+//***********************************************************************************
+static volatile uint8_t *alias;
+static HOST_BUS_REGION regions[HOST_BUS_MAX_REGIONS];
+static uint32_t region_count;
+static HOST_BUS_ACCESS pending;
+static uint64_t access_count;
+
+static uintptr_t last_read_pc;
+static uintptr_t last_read_address;
+static uint32_t last_read_epoch;
+static uint32_t last_read_value;
+
+//***********************************************************************************
+// Private functions
+//***********************************************************************************
+
+/***************************************************************************//**
+ * @brief
+ *   Finds the register block containing an address
+ *
+ ******************************************************************************/
+
+static HOST_BUS_REGION *host_bus_region(uintptr_t address){
+	uint32_t i;
+
+	for(i = 0; i < region_count; i++){
+		if(address >= regions[i].base && address < regions[i].base + regions[i].size){
+			return &regions[i];
+		}
+	}
+	return NULL;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Opens or closes the page holding an address
+ *
+ ******************************************************************************/
+
+static void host_bus_protect(uintptr_t address, int prot){
+	void *page = (void *)(address & ~(HOST_BUS_PAGE_SIZE - 1));
+
+	if(mprotect(page, HOST_BUS_PAGE_SIZE, prot) != 0){
+		abort();
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Word of the model view at an address in the peripheral window
+ *
+ ******************************************************************************/
+
+static volatile uint32_t *host_bus_word(uintptr_t address){
+	return (volatile uint32_t *)(alias + ((address & ~3UL) - PERIPH_BASE));
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Page fault handler, first half of a register access
+ *
+ * @details
+ * 	 Faults outside the peripheral window are real crashes and are handed
+ * 	 back to the default handler.
+ *
+ ******************************************************************************/
+
+static void host_bus_fault(int sig, siginfo_t *info, void *context){
+	ucontext_t *uc = context;
+	uintptr_t address = (uintptr_t)info->si_addr;
+	HOST_BUS_REGION *region;
+
+	if(pending.active || address < PERIPH_BASE || address >= PERIPH_BASE + PERIPH_SIZE){
+		signal(sig, SIG_DFL);
+		return;
+	}
+
+	region = host_bus_region(address);
+	if(region == NULL){
+		fprintf(stderr, "[host] access to unmodeled peripheral address 0x%08lx\n", (unsigned long)address);
+		exit(EXIT_FAILURE);
+	}
+
+	pending.active = true;
+	pending.region = region;
+	pending.address = address;
+	pending.pc = (uintptr_t)uc->uc_mcontext.gregs[REG_RIP];
+	pending.write = (uc->uc_mcontext.gregs[REG_ERR] & HOST_PF_ERR_WRITE) != 0;
+	pending.gated = !host_cmu_enabled(region->clock);
+
+	if(pending.gated){
+		// An unclocked block ignores writes and reads back as zero
+		pending.saved = *host_bus_word(address);
+		if(!pending.write){
+			*host_bus_word(address) = 0;
+		}
+	}
+	else if(!pending.write){
+		region->fn(region->model, (address & ~3UL) - region->base, HOST_ACCESS_PREREAD);
+	}
+
+	host_bus_protect(address, PROT_READ | PROT_WRITE);
+	uc->uc_mcontext.gregs[REG_EFL] |= HOST_EFLAGS_TF;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Single step handler, second half of a register access
+ *
+ * @details
+ * 	 Runs after the faulting instruction has completed. Besides passing the
+ * 	 access to the model, it charges the bus cycles, fast-forwards a read
+ * 	 that is being polled with nothing else going on, and takes any
+ * 	 interrupt the access raised, which is where the firmware handlers run.
+ *
+ ******************************************************************************/
+
+static void host_bus_step(int sig, siginfo_t *info, void *context){
+	ucontext_t *uc = context;
+	HOST_BUS_ACCESS access = pending;
+	uint32_t value;
+
+	(void)info;
+	if(!access.active){
+		signal(sig, SIG_DFL);
+		return;
+	}
+
+	uc->uc_mcontext.gregs[REG_EFL] &= ~HOST_EFLAGS_TF;
+	host_bus_protect(access.address, PROT_NONE);
+	pending.active = false;
+	access_count++;
+
+	// value the faulting instruction saw, before the model reacts to the access
+	value = *host_bus_word(access.address);
+	if(access.gated){
+		*host_bus_word(access.address) = access.saved;
+	}
+	else{
+		access.region->fn(access.region->model, (access.address & ~3UL) - access.region->base,
+				access.write ? HOST_ACCESS_WRITE : HOST_ACCESS_READ);
+	}
+
+	if(access.write){
+		host_activity();
+	}
+	host_cpu_cycles(HOST_BUS_ACCESS_CYCLES);
+
+	if(!access.write){
+		if(access.pc == last_read_pc && access.address == last_read_address &&
+				value == last_read_value && host_activity_epoch() == last_read_epoch){
+			host_spin();
+		}
+		last_read_pc = access.pc;
+		last_read_address = access.address;
+		last_read_value = value;
+	}
+
+	host_irq_poll();
+	last_read_epoch = host_activity_epoch();
+}
+
+//***********************************************************************************
+// Global functions
+//***********************************************************************************
+
+/***************************************************************************//**
+ * @brief
+ *   Maps the peripheral window and installs the access handlers
+ *
+ * @details
+ * 	 The window is backed by an anonymous memory file mapped twice: at the
+ * 	 on-chip address with no access rights for the firmware, and at a
+ * 	 kernel chosen address with full access for the models.
+ *
+ * @note
+ *   Called once from the host reset handler before any model is opened
+ *
+ ******************************************************************************/
+
+void host_bus_open(void){
+	struct sigaction action;
+	void *window;
+	int fd;
+
+	fd = memfd_create("pearl_gecko_periph", 0);
+	if(fd < 0 || ftruncate(fd, PERIPH_SIZE) != 0){
+		perror("[host] peripheral window");
+		exit(EXIT_FAILURE);
+	}
+
+	window = mmap((void *)PERIPH_BASE, PERIPH_SIZE, PROT_NONE, MAP_SHARED | MAP_FIXED_NOREPLACE, fd, 0);
+	if(window != (void *)PERIPH_BASE){
+		fprintf(stderr, "[host] cannot map the peripheral window at 0x%08lx\n", (unsigned long)PERIPH_BASE);
+		exit(EXIT_FAILURE);
+	}
+
+	alias = mmap(NULL, PERIPH_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	if(alias == MAP_FAILED){
+		perror("[host] peripheral alias");
+		exit(EXIT_FAILURE);
+	}
+	close(fd);
+
+	memset(&action, 0, sizeof(action));
+	action.sa_flags = SA_SIGINFO | SA_NODEFER;
+	sigemptyset(&action.sa_mask);
+	action.sa_sigaction = host_bus_fault;
+	sigaction(SIGSEGV, &action, NULL);
+	action.sa_sigaction = host_bus_step;
+	sigaction(SIGTRAP, &action, NULL);
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Connects a peripheral model to a register block
+ *
+ * @param[in] base
+ *   Base address of the register block
+ *
+ * @param[in] size
+ *   Size of the register block in bytes
+ *
+ * @param[in] clock
+ *   Clock that has to be enabled for the block to respond
+ *
+ * @param[in] fn
+ *   Model hook called around every firmware access to the block
+ *
+ * @param[in] model
+ *   Model instance handed back to fn
+ *
+ ******************************************************************************/
+
+void host_bus_attach(uint32_t base, uint32_t size, CMU_Clock_TypeDef clock, HOST_PERIPH_FN fn, void *model){
+	HOST_BUS_REGION *region;
+
+	EFM_ASSERT(region_count < HOST_BUS_MAX_REGIONS);
+	EFM_ASSERT(base >= PERIPH_BASE && base + size <= PERIPH_BASE + PERIPH_SIZE);
+
+	region = &regions[region_count++];
+	region->base = base;
+	region->size = size;
+	region->clock = clock;
+	region->fn = fn;
+	region->model = model;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Returns the model view of a register block
+ *
+ * @details
+ * 	 Accesses through this view are not seen by the bus, so a model can read
+ * 	 and update its registers without triggering its own hooks.
+ *
+ ******************************************************************************/
+
+volatile void *host_bus_alias(uint32_t base){
+	return alias + (base - PERIPH_BASE);
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Resets every peripheral model, as an EM4H entry does
+ *
+ * @details
+ * 	 Each model gets a HOST_ACCESS_RESET and decides for itself what it
+ * 	 keeps, only the EM4H domain survives.
+ *
+ ******************************************************************************/
+
+void host_bus_reset(void){
+	for(uint32_t i = 0; i < region_count; i++){
+		regions[i].fn(regions[i].model, 0, HOST_ACCESS_RESET);
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Reads a register for a bus master other than the CPU, e.g. the LDMA
+ *
+ * @details
+ * 	 The model sees the access as it would a firmware read, but no CPU
+ * 	 cycles are charged and no interrupt is taken, as the caller runs from
+ * 	 an engine event.
+ *
+ * @return
+ *   Word holding the register, zero if its block is not clocked
+ *
+ ******************************************************************************/
+
+uint32_t host_bus_master_read(uint32_t address){
+	HOST_BUS_REGION *region = host_bus_region(address);
+	uint32_t value;
+
+	EFM_ASSERT(region != NULL);
+	if(!host_cmu_enabled(region->clock)){
+		return 0;
+	}
+	region->fn(region->model, (address & ~3UL) - region->base, HOST_ACCESS_PREREAD);
+	value = *host_bus_word(address);
+	region->fn(region->model, (address & ~3UL) - region->base, HOST_ACCESS_READ);
+	return value;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Writes a register for a bus master other than the CPU, e.g. the LDMA
+ *
+ * @details
+ * 	 As host_bus_master_read(), a write to an unclocked block is dropped
+ *
+ ******************************************************************************/
+
+void host_bus_master_write(uint32_t address, uint32_t value){
+	HOST_BUS_REGION *region = host_bus_region(address);
+
+	EFM_ASSERT(region != NULL);
+	if(!host_cmu_enabled(region->clock)){
+		return;
+	}
+	*host_bus_word(address) = value;
+	region->fn(region->model, (address & ~3UL) - region->base, HOST_ACCESS_WRITE);
+	host_activity();
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Returns the number of firmware register accesses so far
+ *
+ ******************************************************************************/
+
+uint64_t host_bus_access_count(void){
+	return access_count;
+}
@@ -0,0 +1,497 @@
+/**
+ * @file host_energy.c
+ * @author James Brennan
+ * @date October 16th, 2026
+ * @brief Energy model for the host build.
+ *
+ * @details
+ * Integrates the supply current over virtual time. The engine charges every
+ * interval it advances with the current of the energy mode the core is in,
+ * the oscillators and peripheral clocks enabled in the CMU, and the loads the
+ * peripheral models switch on: I2C transfers, the BLE module while the
+ * LEUART sends to it, and the sensors while they convert. Each Si7021
+ * humidity measurement starts a new sample period, so the report gives the
+ * energy of a period and the battery life it projects.
+ *
+ * The currents are typical datasheet figures. PG_ENERGY names a file of
+ * "name value" lines that override them, so a configuration can be checked
+ * against its own hardware.
+ *
+ */
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+
+//** Standard Libraries
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+//** Silicon Lab include files
+#include "em_cmu.h"
+
+//** User/developer include files
+#include "brd_config.h"
+#include "host_energy.h"
+#include "host_models.h"
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+#define HOST_ENERGY_LINE			128
+#define HOST_HOURS_PER_YEAR			(24.0 * 365.0)
+
+// Largest difference between the average period and PWM_PER, as a fraction.
+// The LETIMER period is whole ticks of its clock, so it is not exactly PWM_PER.
+#define HOST_ENERGY_PERIOD_TOLERANCE	0.001
+
+typedef struct {
+	const char		*name;			// name in the PG_ENERGY file
+	double			value;
+} HOST_ENERGY_PARAM;
+
+// Peripheral clock charged while it reaches its peripheral
+typedef struct {
+	const char			*name;
+	CMU_Clock_TypeDef	clock;
+	HOST_PARAM			param;
+	bool				hf;			// current is per MHz and stops below EM1
+	double				charge;		// uC drawn so far
+} HOST_ENERGY_CLOCK;
+
+// Oscillator charged while it is enabled and running in the energy mode
+typedef struct {
+	const char			*name;
+	CMU_Osc_TypeDef		osc;
+	HOST_PARAM			param;
+	uint32_t			lowest_em;	// deepest energy mode it keeps running in
+	double				charge;		// uC drawn so far
+} HOST_ENERGY_OSC;
+
+//***********************************************************************************
+// Private variables
+//***********************************************************************************
+static HOST_ENERGY_PARAM params[HOST_PARAM_COUNT] = {
+	[HOST_PARAM_EM0_UA_PER_MHZ]		= { "em0_ua_per_mhz",		69.0 },
+	[HOST_PARAM_EM1_UA_PER_MHZ]		= { "em1_ua_per_mhz",		36.0 },
+	[HOST_PARAM_EM2_UA]				= { "em2_ua",				1.6 },
+	[HOST_PARAM_EM3_UA]				= { "em3_ua",				1.4 },
+	[HOST_PARAM_EM4H_UA]			= { "em4h_ua",				0.5 },
+	[HOST_PARAM_HFXO_UA]			= { "hfxo_ua",				190.0 },
+	[HOST_PARAM_LFXO_UA]			= { "lfxo_ua",				0.1 },
+	[HOST_PARAM_LFRCO_UA]			= { "lfrco_ua",				0.2 },
+	[HOST_PARAM_TIMER_UA_PER_MHZ]	= { "timer_ua_per_mhz",		1.2 },
+	[HOST_PARAM_I2C_UA_PER_MHZ]		= { "i2c_ua_per_mhz",		1.1 },
+	[HOST_PARAM_LDMA_UA_PER_MHZ]	= { "ldma_ua_per_mhz",		1.5 },
+	[HOST_PARAM_LETIMER_UA]			= { "letimer_ua",			0.15 },
+	[HOST_PARAM_LEUART_UA]			= { "leuart_ua",			0.2 },
+	[HOST_PARAM_RTCC_UA]			= { "rtcc_ua",				0.1 },
+	[HOST_PARAM_I2C_BUS_UA]			= { "i2c_bus_ua",			350.0 },
+	[HOST_PARAM_BLE_TX_UA]			= { "ble_tx_ua",			1500.0 },
+	[HOST_PARAM_BLE_IDLE_UA]		= { "ble_idle_ua",			0.0 },
+	[HOST_PARAM_SI7021_CONV_UA]		= { "si7021_conv_ua",		90.0 },
+	[HOST_PARAM_SI7021_IDLE_UA]		= { "si7021_idle_ua",		0.06 },
+	[HOST_PARAM_VEML6030_ON_UA]		= { "veml6030_on_ua",		45.0 },
+	[HOST_PARAM_VEML6030_SD_UA]		= { "veml6030_sd_ua",		0.5 },
+	[HOST_PARAM_SUPPLY_V]			= { "supply_v",				3.0 },
+	[HOST_PARAM_BATTERY_MAH]		= { "battery_mah",			225.0 },
+};
+
+static HOST_ENERGY_CLOCK clocks[] = {
+	{ "TIMER0",		cmuClock_TIMER0,	HOST_PARAM_TIMER_UA_PER_MHZ,	true,	0.0 },
+	{ "I2C0",		cmuClock_I2C0,		HOST_PARAM_I2C_UA_PER_MHZ,		true,	0.0 },
+	{ "I2C1",		cmuClock_I2C1,		HOST_PARAM_I2C_UA_PER_MHZ,		true,	0.0 },
+	{ "LDMA",		cmuClock_LDMA,		HOST_PARAM_LDMA_UA_PER_MHZ,		true,	0.0 },
+	{ "LETIMER0",	cmuClock_LETIMER0,	HOST_PARAM_LETIMER_UA,			false,	0.0 },
+	{ "LEUART0",	cmuClock_LEUART0,	HOST_PARAM_LEUART_UA,			false,	0.0 },
+	{ "RTCC",		cmuClock_RTCC,		HOST_PARAM_RTCC_UA,				false,	0.0 },
+};
+
+static HOST_ENERGY_OSC oscs[] = {
+	{ "HFXO",		cmuOsc_HFXO,		HOST_PARAM_HFXO_UA,		HOST_EM1,	0.0 },
+	{ "LFXO",		cmuOsc_LFXO,		HOST_PARAM_LFXO_UA,		HOST_EM4,	0.0 },
+	{ "LFRCO",		cmuOsc_LFRCO,		HOST_PARAM_LFRCO_UA,	HOST_EM4,	0.0 },
+};
+
+static double core_charge[HOST_EM_COUNT];
+static HOST_LOAD *loads;
+
+// running total and the sample periods seen so far
+static double total_charge;
+static double period_start_charge;
+static HOST_TIME period_start;
+static bool period_measured;
+static bool period_underflow;
+static bool period_open;
+static uint32_t periods;
+static double period_charge_sum;
+static double period_charge_min;
+static double period_charge_max;
+static HOST_TIME period_time_sum;
+
+//***********************************************************************************
+// Private functions
+//***********************************************************************************
+
+/***************************************************************************//**
+ * @brief
+ *   Reads the PG_ENERGY overrides
+ *
+ * @details
+ * 	 One "name value" pair per line, # starts a comment. An unknown name
+ * 	 ends the run, so a typo cannot silently leave a default in place.
+ *
+ ******************************************************************************/
+
+static void host_energy_load_file(const char *path){
+	char line[HOST_ENERGY_LINE];
+	char name[HOST_ENERGY_LINE];
+	double value;
+	FILE *file = fopen(path, "r");
+	int i;
+
+	if(file == NULL){
+		fprintf(stderr, "[host] cannot open PG_ENERGY file %s\n", path);
+		exit(EXIT_FAILURE);
+	}
+	while(fgets(line, sizeof(line), file) != NULL){
+		line[strcspn(line, "#\r\n")] = '\0';
+		if(sscanf(line, "%127s %lf", name, &value) != 2){
+			continue;
+		}
+		for(i = 0; i < HOST_PARAM_COUNT; i++){
+			if(strcmp(name, params[i].name) == 0){
+				params[i].value = value;
+				break;
+			}
+		}
+		if(i == HOST_PARAM_COUNT){
+			fprintf(stderr, "[host] unknown PG_ENERGY parameter %s\n", name);
+			exit(EXIT_FAILURE);
+		}
+	}
+	fclose(file);
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Charge a constant current draws over an interval, in uC
+ *
+ ******************************************************************************/
+
+static double host_energy_uc(double ua, HOST_TIME interval){
+	return ua * (double)interval / HOST_TIME_S;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Charge drawn by a load over an interval
+ *
+ ******************************************************************************/
+
+static double host_load_charge(HOST_LOAD *load, HOST_TIME start, HOST_TIME interval){
+	HOST_TIME on = 0;
+	double charge;
+
+	if(load->active){
+		on = interval;
+	}
+	else if(load->until > start){
+		on = (load->until - start < interval) ? load->until - start : interval;
+	}
+	charge = host_energy_uc(params[load->on].value, on);
+	if(load->off != HOST_PARAM_COUNT){
+		charge += host_energy_uc(params[load->off].value, interval - on);
+	}
+	return charge;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Prints one line of the breakdown, skipping parts that drew nothing
+ *
+ ******************************************************************************/
+
+static void host_energy_line(const char *name, const char *part, double charge){
+	if(charge <= 0.0){
+		return;
+	}
+	fprintf(stderr, "[host]     %-10s %-8s %14.3f uJ\n", name, part,
+			charge * params[HOST_PARAM_SUPPLY_V].value);
+}
+
+//***********************************************************************************
+// Global functions
+//***********************************************************************************
+
+/***************************************************************************//**
+ * @brief
+ *   Opens the energy model
+ *
+ * @details
+ * 	 Applies the PG_ENERGY overrides, if the variable is set
+ *
+ * @note
+ *   Called once from the host reset handler, before the engine registers
+ *   its exit report and before the peripheral models attach their loads
+ *
+ ******************************************************************************/
+
+void host_energy_open(void){
+	const char *path = getenv("PG_ENERGY");
+
+	if(path != NULL){
+		host_energy_load_file(path);
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Charges an interval of virtual time
+ *
+ * @details
+ * 	 Nothing changes state inside an interval, the engine cuts one at every
+ * 	 firmware access and model event, so the state at its start holds
+ * 	 throughout. Loads switched on until a set time are the exception and
+ * 	 are split at that time.
+ *
+ * @param[in] em
+ *   Energy mode the core is in
+ *
+ * @param[in] start
+ *   Virtual time the interval starts at
+ *
+ * @param[in] interval
+ *   Length of the interval
+ *
+ ******************************************************************************/
+
+void host_energy_charge(uint32_t em, HOST_TIME start, HOST_TIME interval){
+	double mhz = host_cmu_freq(cmuClock_HF) / 1e6;
+	double charge;
+	double sum;
+
+	if(interval == 0){
+		return;
+	}
+
+	switch(em){
+		case HOST_EM0:
+			charge = host_energy_uc(params[HOST_PARAM_EM0_UA_PER_MHZ].value * mhz, interval);
+			break;
+		case HOST_EM1:
+			charge = host_energy_uc(params[HOST_PARAM_EM1_UA_PER_MHZ].value * mhz, interval);
+			break;
+		case HOST_EM2:
+			charge = host_energy_uc(params[HOST_PARAM_EM2_UA].value, interval);
+			break;
+		case HOST_EM3:
+			charge = host_energy_uc(params[HOST_PARAM_EM3_UA].value, interval);
+			break;
+		default:
+			charge = host_energy_uc(params[HOST_PARAM_EM4H_UA].value, interval);
+			break;
+	}
+	core_charge[em] += charge;
+	sum = charge;
+
+	for(uint32_t i = 0; i < sizeof(oscs) / sizeof(oscs[0]); i++){
+		if(em <= oscs[i].lowest_em && em != HOST_EM3 && host_cmu_osc_enabled(oscs[i].osc)){
+			charge = host_energy_uc(params[oscs[i].param].value, interval);
+			oscs[i].charge += charge;
+			sum += charge;
+		}
+	}
+
+	for(uint32_t i = 0; i < sizeof(clocks) / sizeof(clocks[0]); i++){
+		if(!host_cmu_enabled(clocks[i].clock)){
+			continue;
+		}
+		if(!clocks[i].hf){
+			charge = host_energy_uc(params[clocks[i].param].value, interval);
+		}
+		else if(em <= HOST_EM1){
+			charge = host_energy_uc(params[clocks[i].param].value * mhz, interval);
+		}
+		else{
+			continue;
+		}
+		clocks[i].charge += charge;
+		sum += charge;
+	}
+
+	for(HOST_LOAD *load = loads; load != NULL; load = load->next){
+		charge = host_load_charge(load, start, interval);
+		load->charge += charge;
+		sum += charge;
+	}
+
+	total_charge += sum;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Marks the start of a sample period
+ *
+ * @details
+ * 	 Called by the Si7021 model when a humidity measurement is started,
+ * 	 which the firmware does once per period in every sleep strategy. The
+ * 	 period that ends here is added to the statistics.
+ *
+ * 	 Only a measurement with a LETIMER underflow since the one before starts
+ * 	 a period. The boot self test's measurement, which comes first, is start
+ * 	 up and is left out, as is a humidity read sent again after a NACK.
+ *
+ ******************************************************************************/
+
+void host_energy_sample(void){
+	HOST_TIME now = host_now();
+	double charge = total_charge - period_start_charge;
+	bool timed = period_measured && period_underflow;
+
+	period_measured = true;
+	period_underflow = false;
+	if(!timed){
+		return;
+	}
+
+	if(period_open){
+		if(periods == 0 || charge < period_charge_min){
+			period_charge_min = charge;
+		}
+		if(periods == 0 || charge > period_charge_max){
+			period_charge_max = charge;
+		}
+		period_charge_sum += charge;
+		period_time_sum += now - period_start;
+		periods++;
+	}
+	period_start_charge = total_charge;
+	period_start = now;
+	period_open = true;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Notes a LETIMER underflow, which starts a sample once the app is running
+ *
+ ******************************************************************************/
+
+void host_energy_underflow(void){
+	period_underflow = true;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Prints the energy part of the end of run report
+ *
+ * @details
+ * 	 The battery life is projected from the average current of the complete
+ * 	 sample periods, or of the whole run if there were none. An average
+ * 	 period that is not the app's PWM_PER means the marks no longer line up
+ * 	 with the samples, and is flagged.
+ *
+ ******************************************************************************/
+
+void host_energy_report(void){
+	double volts = params[HOST_PARAM_SUPPLY_V].value;
+	HOST_TIME now = host_now();
+	double average_ua = now ? total_charge * HOST_TIME_S / (double)now : 0.0;
+	double hours;
+	char part[8];
+
+	fprintf(stderr, "[host]   energy %.3f uJ at %.2f V, %.3f uA average\n",
+			total_charge * volts, volts, average_ua);
+	for(int i = 0; i < HOST_EM_COUNT; i++){
+		snprintf(part, sizeof(part), "EM%d", i);
+		host_energy_line("core", part, core_charge[i]);
+	}
+	for(uint32_t i = 0; i < sizeof(oscs) / sizeof(oscs[0]); i++){
+		host_energy_line(oscs[i].name, "osc", oscs[i].charge);
+	}
+	for(uint32_t i = 0; i < sizeof(clocks) / sizeof(clocks[0]); i++){
+		host_energy_line(clocks[i].name, "clock", clocks[i].charge);
+	}
+	for(HOST_LOAD *load = loads; load != NULL; load = load->next){
+		host_energy_line(load->name, "", load->charge);
+	}
+
+	if(periods != 0){
+		average_ua = period_charge_sum * HOST_TIME_S / (double)period_time_sum;
+		fprintf(stderr, "[host]   %lu sample periods of %.3f s: %.3f uJ average, %.3f min, %.3f max\n",
+				(unsigned long)periods, (double)period_time_sum / HOST_TIME_S / periods,
+				period_charge_sum * volts / periods, period_charge_min * volts,
+				period_charge_max * volts);
+		if(fabs((double)period_time_sum / HOST_TIME_S / periods - PWM_PER) > PWM_PER * HOST_ENERGY_PERIOD_TOLERANCE){
+			fprintf(stderr, "[host]   warning: sample periods do not match PWM_PER of %.3f s\n", PWM_PER);
+		}
+	}
+	if(average_ua > 0.0){
+		hours = params[HOST_PARAM_BATTERY_MAH].value * 1000.0 / average_ua;
+		fprintf(stderr, "[host]   %.0f mAh battery at %.3f uA: %.1f days, %.2f years\n",
+				params[HOST_PARAM_BATTERY_MAH].value, average_ua, hours / 24.0,
+				hours / HOST_HOURS_PER_YEAR);
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Adds a load to the energy model
+ *
+ * @param[in] load
+ *   Load owned by the model, starts switched off
+ *
+ * @param[in] name
+ *   Name shown in the report
+ *
+ * @param[in] on
+ *   Parameter giving the current while on
+ *
+ * @param[in] off
+ *   Parameter giving the current while off, HOST_PARAM_COUNT if none
+ *
+ ******************************************************************************/
+
+void host_load_init(HOST_LOAD *load, const char *name, HOST_PARAM on, HOST_PARAM off){
+	HOST_LOAD **link = &loads;
+
+	load->name = name;
+	load->on = on;
+	load->off = off;
+	load->active = false;
+	load->until = 0;
+	load->charge = 0.0;
+	load->next = NULL;
+
+	// kept in the order they were added, for the report
+	while(*link != NULL){
+		link = &(*link)->next;
+	}
+	*link = load;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Switches a load on or off from the current virtual time
+ *
+ ******************************************************************************/
+
+void host_load_set(HOST_LOAD *load, bool active){
+	load->active = active;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Switches a load on from the current virtual time until a set time
+ *
+ * @details
+ * 	 For activity with a known end and no model event at that end, such as
+ * 	 a sensor conversion
+ *
+ ******************************************************************************/
+
+void host_load_until(HOST_LOAD *load, HOST_TIME until){
+	load->until = until;
+}
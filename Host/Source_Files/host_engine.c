@@ -0,0 +1,660 @@
+/**
+ * @file host_engine.c
+ * @author James Brennan
+ * @date October 16th, 2026
+ * @brief Virtual-time engine and interrupt controller for the host build.
+ *
+ * @details
+ * The firmware runs on the host CPU, but time only moves when the engine is
+ * told about work: emlib calls, peripheral register accesses and interrupt
+ * entry are charged in CPU cycles, and entering an energy mode jumps straight
+ * to the next peripheral event. Peripheral models queue HOST_EVENTs in time
+ * order and raise interrupt lines, which are delivered to the firmware's
+ * handlers whenever PRIMASK is clear and no handler is already running.
+ *
+ */
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+
+//** Standard Libraries
+#include <stdio.h>
+#include <stdlib.h>
+
+//** Silicon Lab include files
+#include "em_cmu.h"
+
+//** User/developer include files
+#include "host_bus.h"
+#include "host_energy.h"
+#include "host_engine.h"
+#include "host_models.h"
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+
+// An interrupt that keeps re-entering this often without returning to thread
+// mode is treated as a stuck interrupt flag
+#define HOST_IRQ_STORM_LIMIT		100000
+
+//***********************************************************************************
+// Private variables
+//***********************************************************************************
+static HOST_TIME now;
+static HOST_TIME sim_end;
+static HOST_EVENT *event_head;
+
+static uint32_t mode;
+static HOST_TIME mode_time[HOST_EM_COUNT];
+static uint32_t mode_entries[HOST_EM_COUNT];
+
+static uint32_t irq_pending;
+static uint32_t irq_enabled;
+static uint32_t irq_count[HOST_IRQ_COUNT];
+static HOST_TIME irq_time[HOST_IRQ_COUNT];	// spent in each handler, entry and exit included
+static bool primask;
+static bool in_handler;
+static bool em4_wakeup;				// an EM4 wake-up source is asserted
+
+static uint32_t activity_epoch;
+static bool stopped;				// run is over, firmware called from the report sees frozen time
+
+static const char *irq_names[HOST_IRQ_COUNT] = {
+	[TIMER0_IRQn] = "TIMER0",
+	[LDMA_IRQn] = "LDMA",
+	[I2C0_IRQn] = "I2C0",
+	[LEUART0_IRQn] = "LEUART0",
+	[LETIMER0_IRQn] = "LETIMER0",
+	[I2C1_IRQn] = "I2C1",
+};
+
+//***********************************************************************************
+// Private functions
+//***********************************************************************************
+
+/***************************************************************************//**
+ * @brief
+ *   Moves virtual time forward
+ *
+ * @details
+ * 	 Charges the interval to the current energy mode and to the energy
+ * 	 model, and fires every event that has come due. Reaching the end of
+ * 	 the simulated run exits the program through the atexit() report.
+ *
+ * @param[in] when
+ *   Virtual time to advance to
+ *
+ ******************************************************************************/
+
+static void host_advance(HOST_TIME when){
+	if(stopped){
+		return;
+	}
+	if(when > sim_end){
+		host_energy_charge(mode, now, sim_end - now);
+		mode_time[mode] += sim_end - now;
+		now = sim_end;
+		exit(EXIT_SUCCESS);
+	}
+	if(when > now){
+		host_energy_charge(mode, now, when - now);
+		mode_time[mode] += when - now;
+		now = when;
+	}
+
+	while(event_head && event_head->when <= now){
+		HOST_EVENT *event = event_head;
+		event_head = event->next;
+		event->armed = false;
+		activity_epoch++;
+		event->fn(event);
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Reports a firmware deadlock and stops the run
+ *
+ * @details
+ * 	 Called when the firmware waits for hardware while no peripheral has any
+ * 	 activity queued, which on the board would hang forever.
+ *
+ ******************************************************************************/
+
+static void host_deadlock(const char *where){
+	fprintf(stderr, "[host] deadlock: firmware is %s with no peripheral activity pending\n", where);
+	exit(EXIT_FAILURE);
+}
+
+//***********************************************************************************
+// Global functions
+//***********************************************************************************
+
+/***************************************************************************//**
+ * @brief
+ *   Opens the virtual-time engine
+ *
+ * @details
+ * 	 Reads the simulated run time from the PG_SIM_TIME environment variable
+ * 	 (seconds, fractions allowed) and registers the exit report.
+ *
+ * @note
+ *   Called once from the host reset handler before main()
+ *
+ ******************************************************************************/
+
+void host_engine_open(void){
+	const char *sim_time = getenv("PG_SIM_TIME");
+	double seconds = HOST_DEFAULT_SIM_SECONDS;
+
+	if(sim_time != NULL){
+		seconds = strtod(sim_time, NULL);
+	}
+	sim_end = (HOST_TIME)(seconds * HOST_TIME_S);
+
+	now = 0;
+	event_head = NULL;
+	mode = HOST_EM0;
+	mode_entries[HOST_EM0] = 1;
+
+	atexit(host_report);
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Returns the current virtual time in picoseconds
+ *
+ ******************************************************************************/
+
+HOST_TIME host_now(void){
+	return now;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Converts an interval to whole ticks of a divided clock
+ *
+ * @param[in] interval
+ *   Interval in virtual time
+ *
+ * @param[in] hz
+ *   Clock frequency
+ *
+ * @param[in] div
+ *   Clock divider, e.g. a timer prescaler
+ *
+ * @return
+ *   Number of complete ticks of hz / div in the interval
+ *
+ ******************************************************************************/
+
+uint64_t host_time_to_ticks(HOST_TIME interval, uint32_t hz, uint32_t div){
+	return (uint64_t)(((unsigned __int128)interval * hz) / ((unsigned __int128)HOST_TIME_S * div));
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Converts ticks of a divided clock to virtual time
+ *
+ * @details
+ * 	 The result is rounded up, so the returned interval always contains the
+ * 	 requested number of ticks when converted back.
+ *
+ ******************************************************************************/
+
+HOST_TIME host_ticks_to_time(uint64_t ticks, uint32_t hz, uint32_t div){
+	unsigned __int128 scaled = (unsigned __int128)ticks * HOST_TIME_S * div;
+
+	return (HOST_TIME)((scaled + hz - 1) / hz);
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Initializes a peripheral model event
+ *
+ * @param[in] event
+ *   Event owned by the model
+ *
+ * @param[in] name
+ *   Peripheral name used in diagnostics
+ *
+ * @param[in] lowest_em
+ *   Deepest energy mode in which the peripheral keeps running, the model may
+ *   update event->lowest_em when its clock source changes
+ *
+ * @param[in] fn
+ *   Callback run when the event fires
+ *
+ * @param[in] ctx
+ *   Model instance handed back to the callback through event->ctx
+ *
+ ******************************************************************************/
+
+void host_event_init(HOST_EVENT *event, const char *name, uint32_t lowest_em, HOST_EVENT_FN fn, void *ctx){
+	event->name = name;
+	event->lowest_em = lowest_em;
+	event->fn = fn;
+	event->ctx = ctx;
+	event->armed = false;
+	event->next = NULL;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Queues an event, replacing any earlier schedule of the same event
+ *
+ * @param[in] event
+ *   Event to queue
+ *
+ * @param[in] when
+ *   Virtual time to fire at, times in the past fire on the next advance
+ *
+ ******************************************************************************/
+
+void host_event_schedule(HOST_EVENT *event, HOST_TIME when){
+	HOST_EVENT **link;
+
+	host_event_cancel(event);
+	event->when = when;
+	event->armed = true;
+
+	link = &event_head;
+	while(*link && (*link)->when <= when){
+		link = &(*link)->next;
+	}
+	event->next = *link;
+	*link = event;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Removes an event from the queue if it is armed
+ *
+ ******************************************************************************/
+
+void host_event_cancel(HOST_EVENT *event){
+	HOST_EVENT **link;
+
+	if(!event->armed){
+		return;
+	}
+	for(link = &event_head; *link; link = &(*link)->next){
+		if(*link == event){
+			*link = event->next;
+			break;
+		}
+	}
+	event->armed = false;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Charges CPU cycles to virtual time
+ *
+ * @details
+ * 	 Cycles are converted with the current HFCLK frequency, so changing the
+ * 	 HFRCO band changes how long the same work takes.
+ *
+ * @param[in] cycles
+ *   Number of HFCLK cycles spent
+ *
+ ******************************************************************************/
+
+void host_cpu_cycles(uint32_t cycles){
+	host_advance(now + host_ticks_to_time(cycles, host_cmu_freq(cmuClock_HF), 1));
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Synchronization point for emlib calls
+ *
+ * @details
+ * 	 Charges the cost of the call and delivers any interrupt that became
+ * 	 pending while the firmware was running.
+ *
+ ******************************************************************************/
+
+void host_sync(void){
+	host_activity();
+	host_cpu_cycles(HOST_HAL_CALL_CYCLES);
+	host_irq_poll();
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Fast-forwards a firmware busy-wait
+ *
+ * @details
+ * 	 When the firmware polls the same location with nothing else happening,
+ * 	 nothing it can observe changes before the next peripheral event. The
+ * 	 engine therefore jumps to that event, charging the wait to EM0 as the
+ * 	 spinning core would, and delivers the interrupts it raises.
+ *
+ ******************************************************************************/
+
+void host_spin(void){
+	if(event_head == NULL){
+		host_deadlock("busy-waiting");
+	}
+	host_advance(event_head->when);
+	host_irq_poll();
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Puts the virtual core to sleep
+ *
+ * @details
+ * 	 Runs the peripheral models forward until an enabled interrupt is
+ * 	 pending. As with WFI, a pending interrupt wakes the core even while
+ * 	 PRIMASK is set; the handler then runs when the critical section ends.
+ * 	 A peripheral that is not clocked in the requested energy mode would
+ * 	 stall on the board, so reaching one of its events ends the run.
+ *
+ * @param[in] em
+ *   Energy mode being entered
+ *
+ ******************************************************************************/
+
+void host_sleep(uint32_t em){
+	host_activity();
+	mode = em;
+	mode_entries[em]++;
+
+	while(!(irq_pending & irq_enabled)){
+		if(event_head == NULL){
+			host_deadlock("asleep");
+		}
+		if(event_head->lowest_em < em){
+			fprintf(stderr, "[host] %s is active but not clocked in EM%lu, t = %.6f s\n",
+					event_head->name, (unsigned long)em, (double)now / HOST_TIME_S);
+			exit(EXIT_FAILURE);
+		}
+		host_advance(event_head->when);
+	}
+
+	mode = HOST_EM0;
+	host_irq_poll();
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Holds the virtual chip in EM4H until a wake-up
+ *
+ * @details
+ * 	 The core and the interrupt controller lose their state, so the
+ * 	 pending and enabled interrupts, PRIMASK and any handler in progress are
+ * 	 dropped. The peripheral models have been reset by then and only the
+ * 	 EM4H domain has events left, which run until one of them asserts the
+ * 	 wake-up. The time is charged to EM4.
+ *
+ * @note
+ *   Returns at the wake-up, the caller then restarts the firmware
+ *
+ ******************************************************************************/
+
+void host_hibernate(void){
+	host_activity();
+	irq_pending = 0;
+	irq_enabled = 0;
+	primask = false;
+	in_handler = false;
+	mode = HOST_EM4;
+	mode_entries[HOST_EM4]++;
+
+	while(!em4_wakeup){
+		if(event_head == NULL){
+			host_deadlock("in EM4H");
+		}
+		host_advance(event_head->when);
+	}
+
+	mode = HOST_EM0;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Drives the EM4 wake-up line
+ *
+ * @details
+ * 	 Level sensitive like the interrupt lines, the RTCC model holds it while
+ * 	 an enabled flag is set and EM4WUEN allows it to wake the chip.
+ *
+ ******************************************************************************/
+
+void host_em4_wakeup(bool level){
+	em4_wakeup = level;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Returns the activity epoch used to detect busy-waits
+ *
+ * @details
+ * 	 The epoch changes whenever the firmware does anything the host can
+ * 	 observe, so an unchanged epoch between two identical polls means the
+ * 	 firmware is spinning.
+ *
+ ******************************************************************************/
+
+uint32_t host_activity_epoch(void){
+	return activity_epoch;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Records observable firmware activity
+ *
+ ******************************************************************************/
+
+void host_activity(void){
+	activity_epoch++;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Drives a peripheral interrupt line
+ *
+ * @details
+ * 	 Peripheral interrupts are level sensitive: the line follows IF & IEN
+ * 	 and is re-evaluated by the model whenever either register changes.
+ *
+ ******************************************************************************/
+
+void host_irq_set(IRQn_Type irq, bool level){
+	if(level){
+		irq_pending |= 1UL << irq;
+	}
+	else{
+		irq_pending &= ~(1UL << irq);
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Delivers pending interrupts to the firmware
+ *
+ * @details
+ * 	 All firmware interrupts share one priority, so handlers never nest and
+ * 	 the lowest numbered pending interrupt is taken first, as on the NVIC.
+ *
+ ******************************************************************************/
+
+void host_irq_poll(void){
+	uint32_t storm = 0;
+
+	if(primask || in_handler || stopped){
+		return;
+	}
+
+	while(irq_pending & irq_enabled){
+		IRQn_Type irq = (IRQn_Type)__builtin_ctz(irq_pending & irq_enabled);
+
+		if(++storm > HOST_IRQ_STORM_LIMIT){
+			fprintf(stderr, "[host] interrupt %d is stuck pending\n", irq);
+			exit(EXIT_FAILURE);
+		}
+
+		if(host_vector_table[irq] == NULL){
+			fprintf(stderr, "[host] interrupt %d has no handler\n", irq);
+			exit(EXIT_FAILURE);
+		}
+
+		HOST_TIME entry = now;
+
+		in_handler = true;
+		activity_epoch++;
+		irq_count[irq]++;
+		host_cpu_cycles(HOST_IRQ_ENTRY_CYCLES);
+		host_vector_table[irq]();
+		host_cpu_cycles(HOST_IRQ_EXIT_CYCLES);
+		irq_time[irq] += now - entry;
+		in_handler = false;
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Sets or clears the modeled PRIMASK
+ *
+ ******************************************************************************/
+
+void host_irq_mask(bool masked){
+	primask = masked;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Returns the modeled PRIMASK
+ *
+ ******************************************************************************/
+
+bool host_irq_masked(void){
+	return primask;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Returns true while an interrupt handler is running
+ *
+ ******************************************************************************/
+
+bool host_irq_active(void){
+	return in_handler;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Returns how often an interrupt was taken, for the model reports
+ *
+ * @param[out] time
+ *   Virtual time spent in its handler, entry and exit included
+ *
+ ******************************************************************************/
+
+uint32_t host_irq_stats(uint32_t irq, HOST_TIME *time){
+	*time = irq_time[irq];
+	return irq_count[irq];
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Returns the name of a modeled interrupt, for reports
+ *
+ ******************************************************************************/
+
+const char *host_irq_name(uint32_t irq){
+	return (irq < HOST_IRQ_COUNT && irq_names[irq] != NULL) ? irq_names[irq] : "IRQ";
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Prints the end of run report
+ *
+ * @details
+ * 	 Registered with atexit(), so it runs when the simulated run time is
+ * 	 reached, on a firmware assert and on a detected deadlock.
+ *
+ ******************************************************************************/
+
+void host_report(void){
+	int i;
+
+	stopped = true;
+	fflush(stdout);
+	fprintf(stderr, "\n[host] simulated %.6f s\n", (double)now / HOST_TIME_S);
+	for(i = 0; i < HOST_EM_COUNT; i++){
+		if(mode_entries[i] == 0){
+			continue;
+		}
+		fprintf(stderr, "[host]   EM%d %12.6f s %6.2f %% %10lu entries\n", i,
+				(double)mode_time[i] / HOST_TIME_S,
+				now ? 100.0 * (double)mode_time[i] / (double)now : 0.0,
+				(unsigned long)mode_entries[i]);
+	}
+	for(i = 0; i < HOST_IRQ_COUNT; i++){
+		if(irq_count[i] != 0){
+			fprintf(stderr, "[host]   %-8s %10lu interrupts %10.3f ms in handler\n",
+					host_irq_name(i), (unsigned long)irq_count[i], (double)irq_time[i] / HOST_TIME_MS);
+		}
+	}
+	fprintf(stderr, "[host]   %lu register accesses\n", (unsigned long)host_bus_access_count());
+	host_i2c_report();
+	host_sensors_report();
+	host_ldma_report();
+	host_energy_report();
+	host_firmware_report();
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Enables an interrupt in the modeled NVIC
+ *
+ ******************************************************************************/
+
+void NVIC_EnableIRQ(IRQn_Type IRQn){
+	irq_enabled |= 1UL << IRQn;
+	host_sync();
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Disables an interrupt in the modeled NVIC
+ *
+ ******************************************************************************/
+
+void NVIC_DisableIRQ(IRQn_Type IRQn){
+	irq_enabled &= ~(1UL << IRQn);
+	host_sync();
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Clears a pending interrupt in the modeled NVIC
+ *
+ * @details
+ * 	 Peripheral lines are level sensitive, so the line is raised again on
+ * 	 the next model update if the peripheral flag is still set.
+ *
+ ******************************************************************************/
+
+void NVIC_ClearPendingIRQ(IRQn_Type IRQn){
+	irq_pending &= ~(1UL << IRQn);
+	host_sync();
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Reports a failed EFM_ASSERT and aborts the run
+ *
+ ******************************************************************************/
+
+void assertEFM(const char *file, int line){
+	fflush(stdout);
+	fprintf(stderr, "\n[host] EFM_ASSERT failed at %s:%d, t = %.6f s\n", file, line,
+			(double)now / HOST_TIME_S);
+	host_report();
+	abort();
+}
@@ -0,0 +1,808 @@
+/**
+ * @file host_i2c.c
+ * @author James Brennan
+ * @date October 16th, 2026
+ * @brief I2C master model for the host build.
+ *
+ * @details
+ * The model follows the bus one phase at a time: START, address, data bytes,
+ * ACK bits and STOP each take their real duration at the configured SCL
+ * rate. Between phases the bus is held, as the EFM32 master does, until the
+ * firmware supplies data or a command. Slaves are HOST_I2C_DEVICEs attached
+ * to the bus and are handed each byte as it completes.
+ *
+ * TXBL and RXDATAV are also the model's LDMA request lines. With AUTOACK
+ * set the master ACKs a received byte once RXDATA has been read, so the
+ * LDMA can take a multi-byte read without the CPU.
+ *
+ * CLTO counts while SCL is held low, by the master waiting for the firmware
+ * or by a slave stretching the clock, and BITO while the bus is seen busy
+ * with SCL high. PG_I2C_FAULTS names a file of faults to inject, one per
+ * line: the bus, the fault, its start and its duration in seconds.
+ *
+ *   I2C1 nack 10 0.5      no slave on I2C1 answers its address
+ *   I2C0 scl_low 20 0.01  a slave on I2C0 holds SCL low
+ *   I2C0 glitch 30 0      a START with no STOP, the next START waits for BITO
+ *
+ */
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+
+//** Standard Libraries
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+
+//** Silicon Lab include files
+#include "em_assert.h"
+#include "em_ldma.h"
+
+//** User/developer include files
+#include "host_bus.h"
+#include "host_energy.h"
+#include "host_engine.h"
+#include "host_models.h"
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+#define HOST_I2C_INSTANCES		2
+
+// Clock cycles added to each SCL period by the synchronization logic
+#define HOST_I2C_CR_MAX			4
+
+// Faults PG_I2C_FAULTS can hold, and the longest line it may have
+#define HOST_I2C_FAULTS			16
+#define HOST_I2C_FAULT_LINE		128
+
+typedef enum {
+	HOST_I2C_FAULT_NACK,		// every slave NACKs its address
+	HOST_I2C_FAULT_SCL_LOW,		// a slave holds SCL low, bus phases stall until the end
+	HOST_I2C_FAULT_GLITCH,		// the bus is seen busy once, with no STOP to follow
+	HOST_I2C_FAULT_KINDS
+} HOST_I2C_FAULT_KIND;
+
+typedef struct {
+	char				bus[8];			// peripheral name, e.g. I2C1
+	HOST_I2C_FAULT_KIND	kind;
+	HOST_TIME			start;
+	HOST_TIME			end;
+	bool				fired;			// a glitch has happened
+} HOST_I2C_FAULT;
+
+typedef enum {
+	I2C_PHASE_IDLE,			// bus free
+	I2C_PHASE_HOLD,			// bus owned and held, waiting for data or a command
+	I2C_PHASE_START,		// START or repeated START condition
+	I2C_PHASE_ADDR,			// address byte and slave ACK
+	I2C_PHASE_TX,			// data byte to the slave and slave ACK
+	I2C_PHASE_RX,			// data byte from the slave
+	I2C_PHASE_RX_HOLD,		// byte received, waiting for ACK or NACK command
+	I2C_PHASE_ACK,			// master ACK or NACK bit
+	I2C_PHASE_STOP			// STOP condition
+} HOST_I2C_PHASE;
+
+typedef struct {
+	volatile void		*regs;			// model view of the register block
+	IRQn_Type			irq;			// interrupt line
+	CMU_Clock_TypeDef	clock;			// peripheral clock
+	HOST_EVENT			event;			// end of the current bus phase
+	HOST_EVENT			timeout;		// CLTO or BITO
+	uint32_t			timeout_flag;	// flag timeout raises, 0 while it is not armed
+	bool				other_busy;		// bus seen busy without this master owning it
+	HOST_I2C_PHASE		phase;			// current bus phase
+	bool				busy;			// bus owned by this master
+	bool				want_addr;		// next byte after a START is an address
+	bool				transmitter;	// master is writing to the slave
+	bool				nacked;			// last byte was not acknowledged
+	bool				start_pending;	// START command waiting for the bus
+	bool				stop_pending;	// STOP command waiting for the bus
+	bool				tx_full;		// transmit buffer holds a byte
+	uint8_t				tx_byte;		// transmit buffer
+	uint8_t				shift;			// byte on the bus
+	bool				ack_bit;		// master ACK (true) or NACK being sent
+	HOST_I2C_DEVICE		*devices;		// slaves on the bus
+	HOST_I2C_DEVICE		*target;		// slave addressed by the current transfer
+	HOST_LOAD			bus_load;		// pull-ups while the bus is owned
+	uint32_t			tx_signal;		// LDMA request lines
+	uint32_t			rx_signal;
+	uint32_t			transfers;		// STOPs sent, for the report
+	uint32_t			injected;		// phases a fault changed
+	uint32_t			cltos;
+	uint32_t			bitos;
+} HOST_I2C_MODEL;
+
+//***********************************************************************************
+// Private variables
+//***********************************************************************************
+static HOST_I2C_MODEL models[HOST_I2C_INSTANCES];
+static uint32_t model_count;
+
+static const char *fault_names[HOST_I2C_FAULT_KINDS] = {
+	[HOST_I2C_FAULT_NACK]		= "nack",
+	[HOST_I2C_FAULT_SCL_LOW]	= "scl_low",
+	[HOST_I2C_FAULT_GLITCH]		= "glitch",
+};
+static HOST_I2C_FAULT faults[HOST_I2C_FAULTS];
+static uint32_t fault_count;
+
+// timeouts in prescaled clock cycles, by the CLTO and BITO fields of CTRL
+static const uint32_t clto_pcc[8] = { 0, 40, 80, 160, 320, 1024, 0, 0 };
+static const uint32_t bito_pcc[4] = { 0, 40, 80, 160 };
+
+//***********************************************************************************
+// Private functions
+//***********************************************************************************
+
+/***************************************************************************//**
+ * @brief
+ *   Duration of one SCL period
+ *
+ * @details
+ * 	 fSCL = fHFPER / ((Nlow + Nhigh) * (CLKDIV + 1) + 4), with Nlow + Nhigh
+ * 	 set by the CLHR field of CTRL.
+ *
+ ******************************************************************************/
+
+static HOST_TIME host_i2c_bit_time(HOST_I2C_MODEL *model){
+	static const uint32_t nsum[] = { 4 + 4, 6 + 3, 11 + 6, 11 + 6 };
+	uint32_t ctrl = HOST_REG(model->regs, I2C_TypeDef, CTRL);
+	uint32_t div = HOST_REG(model->regs, I2C_TypeDef, CLKDIV) & 0x1FF;
+	uint32_t cycles = nsum[(ctrl & _I2C_CTRL_CLHR_MASK) >> _I2C_CTRL_CLHR_SHIFT] * (div + 1) + HOST_I2C_CR_MAX;
+
+	return (HOST_TIME)cycles * HOST_TIME_S / host_cmu_freq(model->clock);
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Duration of a number of prescaled clock cycles, the unit of the timeouts
+ *
+ ******************************************************************************/
+
+static HOST_TIME host_i2c_pcc_time(HOST_I2C_MODEL *model, uint32_t pcc){
+	uint32_t div = HOST_REG(model->regs, I2C_TypeDef, CLKDIV) & 0x1FF;
+
+	return (HOST_TIME)pcc * (div + 1) * HOST_TIME_S / host_cmu_freq(model->clock);
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Reads the PG_I2C_FAULTS file
+ *
+ * @details
+ * 	 # starts a comment. An unknown fault ends the run, as in PG_ENERGY.
+ *
+ ******************************************************************************/
+
+static void host_i2c_load_faults(const char *path){
+	char line[HOST_I2C_FAULT_LINE];
+	char bus[HOST_I2C_FAULT_LINE];
+	char kind[HOST_I2C_FAULT_LINE];
+	double start;
+	double duration;
+	FILE *file = fopen(path, "r");
+	int i;
+
+	if(file == NULL){
+		fprintf(stderr, "[host] cannot open PG_I2C_FAULTS file %s\n", path);
+		exit(EXIT_FAILURE);
+	}
+	while(fgets(line, sizeof(line), file) != NULL){
+		line[strcspn(line, "#\r\n")] = '\0';
+		if(sscanf(line, "%127s %127s %lf %lf", bus, kind, &start, &duration) != 4){
+			continue;
+		}
+		for(i = 0; i < HOST_I2C_FAULT_KINDS; i++){
+			if(strcmp(kind, fault_names[i]) == 0){
+				break;
+			}
+		}
+		if(i == HOST_I2C_FAULT_KINDS || fault_count == HOST_I2C_FAULTS || strlen(bus) >= sizeof(faults[0].bus)){
+			fprintf(stderr, "[host] bad PG_I2C_FAULTS line %s\n", line);
+			exit(EXIT_FAILURE);
+		}
+		strcpy(faults[fault_count].bus, bus);
+		faults[fault_count].kind = i;
+		faults[fault_count].start = (HOST_TIME)(start * HOST_TIME_S);
+		faults[fault_count].end = (HOST_TIME)((start + duration) * HOST_TIME_S);
+		fault_count++;
+	}
+	fclose(file);
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Returns the fault of a kind that is in effect on a bus now, if any
+ *
+ * @details
+ * 	 A glitch is in effect from its start until it has happened once.
+ *
+ ******************************************************************************/
+
+static HOST_I2C_FAULT *host_i2c_fault(HOST_I2C_MODEL *model, HOST_I2C_FAULT_KIND kind){
+	HOST_TIME now = host_now();
+
+	for(uint32_t i = 0; i < fault_count; i++){
+		HOST_I2C_FAULT *fault = &faults[i];
+
+		if(fault->kind != kind || now < fault->start || strcmp(fault->bus, model->event.name) != 0){
+			continue;
+		}
+		if(kind == HOST_I2C_FAULT_GLITCH ? !fault->fired : now < fault->end){
+			return fault;
+		}
+	}
+	return NULL;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Arms or disarms the timeout for the state the bus is in
+ *
+ * @details
+ * 	 The master holds SCL low while it waits for data or a command, and a
+ * 	 slave stretching the clock holds it low through a bus phase; CLTO
+ * 	 counts either. A stretch that ends before CLTO would fire is left out,
+ * 	 the phase just takes longer. BITO counts while the bus is seen busy
+ * 	 and SCL is high. A timeout already counting is left alone.
+ *
+ ******************************************************************************/
+
+static void host_i2c_timeouts(HOST_I2C_MODEL *model){
+	uint32_t ctrl = HOST_REG(model->regs, I2C_TypeDef, CTRL);
+	uint32_t clto = clto_pcc[(ctrl & _I2C_CTRL_CLTO_MASK) >> _I2C_CTRL_CLTO_SHIFT];
+	uint32_t bito = bito_pcc[(ctrl & _I2C_CTRL_BITO_MASK) >> _I2C_CTRL_BITO_SHIFT];
+	HOST_I2C_FAULT *stretch = host_i2c_fault(model, HOST_I2C_FAULT_SCL_LOW);
+	uint32_t flag = 0;
+	HOST_TIME after = 0;
+
+	if(clto != 0 && (model->phase == I2C_PHASE_HOLD || model->phase == I2C_PHASE_RX_HOLD)){
+		flag = I2C_IF_CLTO;
+		after = host_i2c_pcc_time(model, clto);
+	}
+	else if(clto != 0 && model->phase != I2C_PHASE_IDLE && stretch != NULL
+			&& stretch->end - host_now() > host_i2c_pcc_time(model, clto)){
+		flag = I2C_IF_CLTO;
+		after = host_i2c_pcc_time(model, clto);
+	}
+	else if(bito != 0 && model->other_busy && model->phase == I2C_PHASE_IDLE){
+		flag = I2C_IF_BITO;
+		after = host_i2c_pcc_time(model, bito);
+	}
+
+	if(flag == model->timeout_flag){
+		return;
+	}
+	model->timeout_flag = flag;
+	if(flag != 0){
+		host_event_schedule(&model->timeout, host_now() + after);
+	}
+	else{
+		host_event_cancel(&model->timeout);
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Recomputes STATE, STATUS and the interrupt line
+ *
+ ******************************************************************************/
+
+static void host_i2c_update(HOST_I2C_MODEL *model){
+	uint32_t state = 0;
+	uint32_t status = 0;
+	uint32_t flags;
+
+	if(model->busy || model->phase != I2C_PHASE_IDLE){
+		state |= I2C_STATE_BUSY | I2C_STATE_MASTER;
+	}
+	if(model->other_busy){
+		state |= I2C_STATE_BUSY;
+	}
+	if(model->transmitter){
+		state |= I2C_STATE_TRANSMITTER;
+	}
+	if(model->nacked){
+		state |= I2C_STATE_NACKED;
+	}
+	switch(model->phase){
+		case I2C_PHASE_HOLD:
+		case I2C_PHASE_RX_HOLD:
+			state |= I2C_STATE_BUSHOLD | I2C_STATE_STATE_WAIT;
+			break;
+		case I2C_PHASE_START:
+			state |= I2C_STATE_STATE_START;
+			break;
+		case I2C_PHASE_ADDR:
+			state |= I2C_STATE_STATE_ADDR;
+			break;
+		case I2C_PHASE_TX:
+		case I2C_PHASE_RX:
+			state |= I2C_STATE_STATE_DATA;
+			break;
+		case I2C_PHASE_ACK:
+			state |= I2C_STATE_STATE_DATAACK;
+			break;
+		case I2C_PHASE_STOP:
+			state |= I2C_STATE_STATE_WAIT;
+			break;
+		default:
+			break;
+	}
+	HOST_REG(model->regs, I2C_TypeDef, STATE) = state;
+
+	flags = HOST_REG(model->regs, I2C_TypeDef, IF);
+	if(!model->tx_full){
+		status |= I2C_STATUS_TXBL;
+		flags |= I2C_IF_TXBL;
+	}
+	else{
+		flags &= ~I2C_IF_TXBL;
+	}
+	if(flags & I2C_IF_TXC){
+		status |= I2C_STATUS_TXC;
+	}
+	if(flags & I2C_IF_RXDATAV){
+		status |= I2C_STATUS_RXDATAV;
+	}
+	HOST_REG(model->regs, I2C_TypeDef, STATUS) = status;
+	HOST_REG(model->regs, I2C_TypeDef, IF) = flags & _I2C_IF_MASK;
+
+	host_i2c_timeouts(model);
+	host_irq_set(model->irq, (flags & HOST_REG(model->regs, I2C_TypeDef, IEN) & _I2C_IF_MASK) != 0);
+	host_ldma_request(model->tx_signal, (status & I2C_STATUS_TXBL) != 0);
+	host_ldma_request(model->rx_signal, (status & I2C_STATUS_RXDATAV) != 0);
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Sets interrupt flags
+ *
+ ******************************************************************************/
+
+static void host_i2c_flag(HOST_I2C_MODEL *model, uint32_t flags){
+	HOST_REG(model->regs, I2C_TypeDef, IF) |= flags;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Starts a bus phase lasting a number of SCL periods
+ *
+ * @details
+ * 	 A phase started while a slave holds SCL low only starts counting once
+ * 	 it lets go.
+ *
+ ******************************************************************************/
+
+static void host_i2c_phase(HOST_I2C_MODEL *model, HOST_I2C_PHASE phase, uint32_t bits){
+	HOST_I2C_FAULT *stretch = host_i2c_fault(model, HOST_I2C_FAULT_SCL_LOW);
+	HOST_TIME start = host_now();
+
+	if(stretch != NULL){
+		start = stretch->end;
+		model->injected++;
+	}
+	model->phase = phase;
+	host_event_schedule(&model->event, start + bits * host_i2c_bit_time(model));
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Moves a held bus on to the next phase the firmware has asked for
+ *
+ * @details
+ * 	 A pending START wins over a pending STOP, which wins over buffered
+ * 	 data. Data is only sent after an address that was acknowledged by a
+ * 	 slave in write mode. A START waits while the bus is seen busy.
+ *
+ ******************************************************************************/
+
+static void host_i2c_kick(HOST_I2C_MODEL *model){
+	HOST_I2C_FAULT *glitch;
+
+	if(model->phase == I2C_PHASE_IDLE){
+		glitch = host_i2c_fault(model, HOST_I2C_FAULT_GLITCH);
+		if(model->start_pending && glitch != NULL){
+			glitch->fired = true;
+			model->other_busy = true;
+			model->injected++;
+		}
+		if(model->start_pending && !model->other_busy){
+			host_i2c_phase(model, I2C_PHASE_START, 1);
+		}
+		else if(model->start_pending){
+			// waits for the bus to be free
+		}
+		else{
+			model->stop_pending = false;
+		}
+		return;
+	}
+
+	if(model->phase != I2C_PHASE_HOLD){
+		return;
+	}
+
+	if(model->start_pending){
+		host_i2c_phase(model, I2C_PHASE_START, 1);
+	}
+	else if(model->stop_pending){
+		host_i2c_phase(model, I2C_PHASE_STOP, 1);
+	}
+	else if(model->tx_full && (model->want_addr || (model->transmitter && !model->nacked))){
+		model->shift = model->tx_byte;
+		model->tx_full = false;
+		if(model->want_addr){
+			host_i2c_phase(model, I2C_PHASE_ADDR, 9);
+		}
+		else{
+			host_i2c_phase(model, I2C_PHASE_TX, 9);
+		}
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Releases the bus and the addressed slave
+ *
+ ******************************************************************************/
+
+static void host_i2c_release(HOST_I2C_MODEL *model){
+	if(model->target != NULL && model->target->stop != NULL){
+		model->target->stop(model->target);
+	}
+	model->target = NULL;
+	model->busy = false;
+	host_load_set(&model->bus_load, false);
+	model->want_addr = false;
+	model->transmitter = false;
+	model->phase = I2C_PHASE_IDLE;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   End of a bus phase
+ *
+ ******************************************************************************/
+
+static void host_i2c_event(HOST_EVENT *event){
+	HOST_I2C_MODEL *model = event->ctx;
+	HOST_I2C_DEVICE *dev;
+	bool read;
+
+	// SCL went high, a clock low timeout starts over
+	host_event_cancel(&model->timeout);
+	model->timeout_flag = 0;
+
+	switch(model->phase){
+		case I2C_PHASE_START:
+			// a repeated START keeps the slave selected until it is addressed again
+			host_i2c_flag(model, model->busy ? I2C_IF_RSTART : I2C_IF_START);
+			model->busy = true;
+			host_load_set(&model->bus_load, true);
+			model->start_pending = false;
+			model->want_addr = true;
+			model->nacked = false;
+			model->phase = I2C_PHASE_HOLD;
+			host_i2c_kick(model);
+			break;
+		case I2C_PHASE_ADDR:
+			read = model->shift & 0x01;
+			model->want_addr = false;
+			for(dev = model->devices; dev != NULL; dev = dev->next){
+				if(dev->address == (model->shift >> 1)){
+					break;
+				}
+			}
+			model->target = NULL;
+			if(dev != NULL && host_i2c_fault(model, HOST_I2C_FAULT_NACK) != NULL){
+				dev = NULL;
+				model->injected++;
+			}
+			if(dev != NULL && dev->start(dev, read)){
+				model->target = dev;
+				model->transmitter = !read;
+				model->nacked = false;
+				host_i2c_flag(model, I2C_IF_ACK);
+				if(read){
+					host_i2c_phase(model, I2C_PHASE_RX, 8);
+					break;
+				}
+			}
+			else{
+				model->nacked = true;
+				host_i2c_flag(model, I2C_IF_NACK);
+			}
+			model->phase = I2C_PHASE_HOLD;
+			host_i2c_kick(model);
+			break;
+		case I2C_PHASE_TX:
+			if(model->target->write(model->target, model->shift)){
+				host_i2c_flag(model, I2C_IF_ACK);
+			}
+			else{
+				model->nacked = true;
+				host_i2c_flag(model, I2C_IF_NACK);
+			}
+			if(!model->tx_full){
+				host_i2c_flag(model, I2C_IF_TXC);
+			}
+			model->phase = I2C_PHASE_HOLD;
+			host_i2c_kick(model);
+			break;
+		case I2C_PHASE_RX:
+			HOST_REG(model->regs, I2C_TypeDef, RXDATA) = model->target->read(model->target);
+			host_i2c_flag(model, I2C_IF_RXDATAV);
+			model->phase = I2C_PHASE_RX_HOLD;
+			break;
+		case I2C_PHASE_ACK:
+			if(model->ack_bit){
+				host_i2c_phase(model, I2C_PHASE_RX, 8);
+			}
+			else{
+				model->phase = I2C_PHASE_HOLD;
+				host_i2c_kick(model);
+			}
+			break;
+		case I2C_PHASE_STOP:
+			host_i2c_flag(model, I2C_IF_MSTOP);
+			model->stop_pending = false;
+			model->transfers++;
+			host_i2c_release(model);
+			host_i2c_kick(model);
+			break;
+		default:
+			EFM_ASSERT(false);
+			break;
+	}
+	host_i2c_update(model);
+}
+
+/***************************************************************************//**
+ * @brief
+ *   CLTO or BITO has run out
+ *
+ * @details
+ * 	 With GIBITO set, BITO also frees the bus, and a START waiting for it
+ * 	 goes out.
+ *
+ ******************************************************************************/
+
+static void host_i2c_timeout(HOST_EVENT *event){
+	HOST_I2C_MODEL *model = event->ctx;
+	uint32_t flag = model->timeout_flag;
+
+	model->timeout_flag = 0;
+	host_i2c_flag(model, flag);
+	if(flag == I2C_IF_CLTO){
+		model->cltos++;
+	}
+	else{
+		model->bitos++;
+		if(HOST_REG(model->regs, I2C_TypeDef, CTRL) & I2C_CTRL_GIBITO){
+			model->other_busy = false;
+			host_i2c_kick(model);
+		}
+	}
+	host_i2c_update(model);
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Executes the commands written to CMD
+ *
+ ******************************************************************************/
+
+static void host_i2c_command(HOST_I2C_MODEL *model, uint32_t cmd){
+	if(cmd & I2C_CMD_ABORT){
+		host_event_cancel(&model->event);
+		model->start_pending = false;
+		model->stop_pending = false;
+		model->nacked = false;
+		model->other_busy = false;
+		host_i2c_release(model);
+	}
+	if(cmd & I2C_CMD_CLEARTX){
+		model->tx_full = false;
+	}
+	if(cmd & I2C_CMD_START){
+		model->start_pending = true;
+	}
+	if(cmd & I2C_CMD_STOP){
+		model->stop_pending = true;
+	}
+	if((cmd & (I2C_CMD_ACK | I2C_CMD_NACK)) && model->phase == I2C_PHASE_RX_HOLD){
+		model->ack_bit = (cmd & I2C_CMD_ACK) != 0;
+		host_i2c_phase(model, I2C_PHASE_ACK, 1);
+	}
+	host_i2c_kick(model);
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Returns the peripheral to its reset state for an EM4H entry
+ *
+ * @details
+ * 	 A transfer in flight is dropped, the slave sees a STOP.
+ *
+ ******************************************************************************/
+
+static void host_i2c_reset(HOST_I2C_MODEL *model){
+	host_event_cancel(&model->event);
+	host_event_cancel(&model->timeout);
+	host_i2c_release(model);
+	model->timeout_flag = 0;
+	model->other_busy = false;
+	model->nacked = false;
+	model->start_pending = false;
+	model->stop_pending = false;
+	model->tx_full = false;
+	memset((void *)model->regs, 0, sizeof(I2C_TypeDef));
+	host_i2c_update(model);
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Register access hook
+ *
+ ******************************************************************************/
+
+static void host_i2c_access(void *ctx, uint32_t offset, HOST_ACCESS access){
+	HOST_I2C_MODEL *model = ctx;
+	uint32_t value;
+
+	if(access == HOST_ACCESS_RESET){
+		host_i2c_reset(model);
+		return;
+	}
+	if(access == HOST_ACCESS_PREREAD){
+		return;
+	}
+
+	if(access == HOST_ACCESS_READ){
+		if(offset == HOST_OFFSET(I2C_TypeDef, RXDATA)){
+			HOST_REG(model->regs, I2C_TypeDef, IF) &= ~I2C_IF_RXDATAV;
+			host_activity();
+			if((HOST_REG(model->regs, I2C_TypeDef, CTRL) & I2C_CTRL_AUTOACK) && model->phase == I2C_PHASE_RX_HOLD){
+				model->ack_bit = true;
+				host_i2c_phase(model, I2C_PHASE_ACK, 1);
+			}
+			host_i2c_update(model);
+		}
+		return;
+	}
+
+	switch(offset){
+		case HOST_OFFSET(I2C_TypeDef, CMD):
+			value = HOST_REG(model->regs, I2C_TypeDef, CMD);
+			HOST_REG(model->regs, I2C_TypeDef, CMD) = 0;
+			host_i2c_command(model, value);
+			break;
+		case HOST_OFFSET(I2C_TypeDef, TXDATA):
+			if(model->tx_full){
+				host_i2c_flag(model, I2C_IF_TXOF);
+			}
+			model->tx_byte = (uint8_t)HOST_REG(model->regs, I2C_TypeDef, TXDATA);
+			model->tx_full = true;
+			HOST_REG(model->regs, I2C_TypeDef, IF) &= ~I2C_IF_TXC;
+			host_i2c_kick(model);
+			break;
+		case HOST_OFFSET(I2C_TypeDef, IFS):
+			host_i2c_flag(model, HOST_REG(model->regs, I2C_TypeDef, IFS) & _I2C_IF_MASK);
+			HOST_REG(model->regs, I2C_TypeDef, IFS) = 0;
+			break;
+		case HOST_OFFSET(I2C_TypeDef, IFC):
+			HOST_REG(model->regs, I2C_TypeDef, IF) &= ~HOST_REG(model->regs, I2C_TypeDef, IFC);
+			HOST_REG(model->regs, I2C_TypeDef, IFC) = 0;
+			break;
+		case HOST_OFFSET(I2C_TypeDef, IEN):
+			HOST_REG(model->regs, I2C_TypeDef, IEN) &= _I2C_IF_MASK;
+			break;
+		case HOST_OFFSET(I2C_TypeDef, STATE):
+		case HOST_OFFSET(I2C_TypeDef, STATUS):
+		case HOST_OFFSET(I2C_TypeDef, IF):
+		case HOST_OFFSET(I2C_TypeDef, RXDATA):
+			// read only, the write is discarded by the update below
+			break;
+		default:
+			break;
+	}
+	host_i2c_update(model);
+}
+
+//***********************************************************************************
+// Global functions
+//***********************************************************************************
+
+/***************************************************************************//**
+ * @brief
+ *   Opens the model for one I2C peripheral
+ *
+ * @param[in] i2c
+ *   Base address of the I2C peripheral
+ *
+ * @param[in] irq
+ *   Interrupt line of the peripheral
+ *
+ * @param[in] clock
+ *   Peripheral clock, sets the SCL rate together with CLKDIV
+ *
+ ******************************************************************************/
+
+void host_i2c_model_open(I2C_TypeDef *i2c, IRQn_Type irq, CMU_Clock_TypeDef clock){
+	const char *path = getenv("PG_I2C_FAULTS");
+	HOST_I2C_MODEL *model;
+
+	if(model_count == 0 && path != NULL){
+		host_i2c_load_faults(path);
+	}
+	EFM_ASSERT(model_count < HOST_I2C_INSTANCES);
+	model = &models[model_count++];
+
+	model->regs = host_bus_alias((uint32_t)(uintptr_t)i2c);
+	model->irq = irq;
+	model->clock = clock;
+	model->phase = I2C_PHASE_IDLE;
+	model->tx_signal = (i2c == I2C0) ? ldmaPeripheralSignal_I2C0_TXBL : ldmaPeripheralSignal_I2C1_TXBL;
+	model->rx_signal = (i2c == I2C0) ? ldmaPeripheralSignal_I2C0_RXDATAV : ldmaPeripheralSignal_I2C1_RXDATAV;
+	host_event_init(&model->event, i2c == I2C0 ? "I2C0" : "I2C1", host_cmu_lowest_em(clock), host_i2c_event, model);
+	host_event_init(&model->timeout, model->event.name, host_cmu_lowest_em(clock), host_i2c_timeout, model);
+	host_load_init(&model->bus_load, model->event.name, HOST_PARAM_I2C_BUS_UA, HOST_PARAM_COUNT);
+
+	host_bus_attach((uint32_t)(uintptr_t)i2c, sizeof(I2C_TypeDef), clock, host_i2c_access, model);
+	host_i2c_update(model);
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Connects a slave to the bus of an I2C peripheral
+ *
+ ******************************************************************************/
+
+void host_i2c_attach(I2C_TypeDef *i2c, HOST_I2C_DEVICE *dev){
+	uint32_t i;
+
+	for(i = 0; i < model_count; i++){
+		if(models[i].regs == host_bus_alias((uint32_t)(uintptr_t)i2c)){
+			dev->next = models[i].devices;
+			models[i].devices = dev;
+			return;
+		}
+	}
+	EFM_ASSERT(false);
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Adds the transfers of each bus to the end of run report
+ *
+ * @details
+ * 	 Interrupts and handler time are given per transfer, so the byte by
+ * 	 byte interrupt driver and the LDMA driver can be compared directly.
+ * 	 A bus that had faults injected or timeouts also gets a count of them.
+ *
+ ******************************************************************************/
+
+void host_i2c_report(void){
+	HOST_TIME time;
+	uint32_t count;
+
+	for(uint32_t i = 0; i < model_count; i++){
+		if(models[i].transfers == 0){
+			continue;
+		}
+		count = host_irq_stats(models[i].irq, &time);
+		fprintf(stderr, "[host]   %-8s %10lu transfers %8.2f interrupts/transfer %8.2f us in handler/transfer\n",
+				models[i].event.name, (unsigned long)models[i].transfers,
+				(double)count / models[i].transfers, (double)time / HOST_TIME_US / models[i].transfers);
+		if(models[i].injected == 0 && models[i].cltos == 0 && models[i].bitos == 0){
+			continue;
+		}
+		fprintf(stderr, "[host]   %-8s %10lu phases faulted %6lu clock low timeouts %6lu bus idle timeouts\n",
+				models[i].event.name, (unsigned long)models[i].injected,
+				(unsigned long)models[i].cltos, (unsigned long)models[i].bitos);
+	}
+}
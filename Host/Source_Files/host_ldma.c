@@ -0,0 +1,412 @@
+/**
+ * @file host_ldma.c
+ * @author James Brennan
+ * @date October 17th, 2026
+ * @brief LDMA model for the host build.
+ *
+ * @details
+ * Channels run their descriptor lists a unit at a time while the peripheral
+ * request they are wired to is raised, or straight away for a descriptor
+ * with structReq set. Peripheral models report their request lines with
+ * host_ldma_request(), and the channels move on a few HFCLK cycles later,
+ * without the CPU. Peripheral registers are read and written through the
+ * bus, so the peripheral models see the same accesses the firmware would
+ * make. XFER and WRITE descriptors with relative links are modeled. Of the
+ * interrupt flags only DONE is raised, and the LDMA line follows IF and IEN
+ * as for the other peripherals.
+ *
+ */
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+
+//** Standard Libraries
+#include <stdio.h>
+#include <string.h>
+
+//** Silicon Lab include files
+#include "em_assert.h"
+#include "em_ldma.h"
+
+//** User/developer include files
+#include "host_bus.h"
+#include "host_engine.h"
+#include "host_models.h"
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+
+// Request lines the model can follow, two per I2C
+#define HOST_LDMA_REQUESTS		8
+
+// HFCLK cycles from a request to the first unit moved
+#define HOST_LDMA_LATENCY_CYCLES	4
+
+typedef struct {
+	const LDMA_Descriptor_t		*link;		// descriptor given by LDMA_StartTransfer(), loaded by LINKLOAD
+	const LDMA_Descriptor_t		*desc;		// descriptor being run, NULL when the channel is idle
+	uint32_t					moved;		// units of desc moved
+} HOST_LDMA_CHANNEL;
+
+typedef struct {
+	volatile void		*regs;				// model view of the register block
+	IRQn_Type			irq;				// interrupt line
+	HOST_EVENT			event;				// channels move on after a request
+	bool				running;			// channels are being run, requests need no event
+	HOST_LDMA_CHANNEL	ch[DMA_CHAN_COUNT];
+	uint32_t			signals[HOST_LDMA_REQUESTS];	// REQSEL value of each request line
+	bool				levels[HOST_LDMA_REQUESTS];
+	uint32_t			request_count;
+	uint64_t			units;				// units moved, for the report
+	uint64_t			writes;				// WRITE descriptors run
+} HOST_LDMA_MODEL;
+
+//***********************************************************************************
+// Private variables
+//***********************************************************************************
+static HOST_LDMA_MODEL model;
+
+//***********************************************************************************
+// Private functions
+//***********************************************************************************
+
+/***************************************************************************//**
+ * @brief
+ *   Returns true if a request line is raised
+ *
+ ******************************************************************************/
+
+static bool host_ldma_level(uint32_t signal){
+	for(uint32_t i = 0; i < model.request_count; i++){
+		if(model.signals[i] == signal){
+			return model.levels[i];
+		}
+	}
+	return false;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Recomputes the interrupt line
+ *
+ ******************************************************************************/
+
+static void host_ldma_irq(void){
+	host_irq_set(model.irq, (HOST_REG(model.regs, LDMA_TypeDef, IF) &
+			HOST_REG(model.regs, LDMA_TypeDef, IEN) & _LDMA_IF_MASK) != 0);
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Reads a unit from memory or, through the bus, from a peripheral
+ *
+ ******************************************************************************/
+
+static uint32_t host_ldma_read(uintptr_t address, uint32_t size){
+	if(address >= PERIPH_BASE && address < PERIPH_BASE + PERIPH_SIZE){
+		return host_bus_master_read((uint32_t)address) >> (8 * (address & 3));
+	}
+	switch(size){
+		case ldmaCtrlSizeByte:
+			return *(volatile uint8_t *)address;
+		case ldmaCtrlSizeHalf:
+			return *(volatile uint16_t *)address;
+		default:
+			return *(volatile uint32_t *)address;
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Writes a unit to memory or, through the bus, to a peripheral
+ *
+ ******************************************************************************/
+
+static void host_ldma_write(uintptr_t address, uint32_t value, uint32_t size){
+	if(address >= PERIPH_BASE && address < PERIPH_BASE + PERIPH_SIZE){
+		host_bus_master_write((uint32_t)address, value);
+		return;
+	}
+	switch(size){
+		case ldmaCtrlSizeByte:
+			*(volatile uint8_t *)address = (uint8_t)value;
+			break;
+		case ldmaCtrlSizeHalf:
+			*(volatile uint16_t *)address = (uint16_t)value;
+			break;
+		default:
+			*(volatile uint32_t *)address = value;
+			break;
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Ends the descriptor a channel is running and loads the one it links to
+ *
+ * @details
+ * 	 A channel that reaches a descriptor without a link is done: it is
+ * 	 disabled and its CHDONE bit is set.
+ *
+ ******************************************************************************/
+
+static void host_ldma_next(uint32_t ch){
+	HOST_LDMA_CHANNEL *channel = &model.ch[ch];
+	const LDMA_Descriptor_t *desc = channel->desc;
+	bool write = (desc->xfer.structType == ldmaCtrlStructTypeWrite);
+	uint32_t mask = 1UL << ch;
+
+	if(desc->xfer.doneIfs){
+		HOST_REG(model.regs, LDMA_TypeDef, IF) |= mask;
+	}
+	channel->moved = 0;
+	// the link word follows the addresses, so it sits elsewhere in a WRITE
+	if(write ? desc->wri.link : desc->xfer.link){
+		EFM_ASSERT((write ? desc->wri.linkMode : desc->xfer.linkMode) == ldmaLinkModeRel);
+		channel->desc = desc + (write ? desc->wri.linkAddr : desc->xfer.linkAddr) / 4;
+		return;
+	}
+	channel->desc = NULL;
+	HOST_REG(model.regs, LDMA_TypeDef, CHEN) &= ~mask;
+	HOST_REG(model.regs, LDMA_TypeDef, CHDONE) |= mask;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Moves one unit on a channel if its request allows it
+ *
+ * @return
+ *   true if the channel moved
+ *
+ ******************************************************************************/
+
+static bool host_ldma_step(uint32_t ch){
+	HOST_LDMA_CHANNEL *channel = &model.ch[ch];
+	const LDMA_Descriptor_t *desc = channel->desc;
+	static const uint32_t inc[4] = { 1, 2, 4, 0 };
+	uint32_t reqsel;
+	uint32_t unit;
+	uint32_t value;
+
+	if(desc == NULL || !(HOST_REG(model.regs, LDMA_TypeDef, CHEN) & (1UL << ch))){
+		return false;
+	}
+	reqsel = HOST_REG(model.regs, LDMA_TypeDef, CH[ch].REQSEL);
+	if(!desc->xfer.structReq && !host_ldma_level(reqsel)){
+		return false;
+	}
+
+	if(desc->xfer.structType == ldmaCtrlStructTypeWrite){
+		host_ldma_write(desc->wri.dstAddr, desc->wri.immVal, ldmaCtrlSizeWord);
+		model.writes++;
+		host_ldma_next(ch);
+		return true;
+	}
+	EFM_ASSERT(desc->xfer.structType == ldmaCtrlStructTypeXfer);
+
+	unit = 1UL << desc->xfer.size;
+	value = host_ldma_read(desc->xfer.srcAddr + channel->moved * unit * inc[desc->xfer.srcInc], desc->xfer.size);
+	host_ldma_write(desc->xfer.dstAddr + channel->moved * unit * inc[desc->xfer.dstInc], value, desc->xfer.size);
+	model.units++;
+	if(++channel->moved > desc->xfer.xferCnt){
+		host_ldma_next(ch);
+	}
+	return true;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Runs the channels until none of them can move
+ *
+ * @details
+ * 	 Each unit written to a peripheral can change its request lines, which
+ * 	 are read again before the next unit.
+ *
+ ******************************************************************************/
+
+static void host_ldma_run(HOST_EVENT *event){
+	bool moved;
+
+	(void)event;
+	model.running = true;
+	do{
+		moved = false;
+		for(uint32_t ch = 0; ch < DMA_CHAN_COUNT; ch++){
+			moved |= host_ldma_step(ch);
+		}
+	}while(moved);
+	model.running = false;
+	host_ldma_irq();
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Lets the channels move after the request latency
+ *
+ ******************************************************************************/
+
+static void host_ldma_kick(void){
+	if(!model.running && !model.event.armed){
+		host_event_schedule(&model.event, host_now() +
+				HOST_LDMA_LATENCY_CYCLES * HOST_TIME_S / host_cmu_freq(cmuClock_HF));
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Returns the block to its reset state for an EM4H entry
+ *
+ ******************************************************************************/
+
+static void host_ldma_reset(void){
+	host_event_cancel(&model.event);
+	for(uint32_t ch = 0; ch < DMA_CHAN_COUNT; ch++){
+		model.ch[ch].link = NULL;
+		model.ch[ch].desc = NULL;
+		model.ch[ch].moved = 0;
+	}
+	memset((void *)model.regs, 0, sizeof(LDMA_TypeDef));
+	host_ldma_irq();
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Register access hook
+ *
+ ******************************************************************************/
+
+static void host_ldma_access(void *ctx, uint32_t offset, HOST_ACCESS access){
+	uint32_t value;
+
+	(void)ctx;
+	if(access == HOST_ACCESS_RESET){
+		host_ldma_reset();
+		return;
+	}
+	if(access != HOST_ACCESS_WRITE){
+		return;
+	}
+
+	switch(offset){
+		case HOST_OFFSET(LDMA_TypeDef, CHEN):
+			value = HOST_REG(model.regs, LDMA_TypeDef, CHEN) & 0xFF;
+			HOST_REG(model.regs, LDMA_TypeDef, CHEN) = value;
+			for(uint32_t ch = 0; ch < DMA_CHAN_COUNT; ch++){
+				if(!(value & (1UL << ch))){
+					model.ch[ch].desc = NULL;
+				}
+			}
+			break;
+		case HOST_OFFSET(LDMA_TypeDef, LINKLOAD):
+			value = HOST_REG(model.regs, LDMA_TypeDef, LINKLOAD) & 0xFF;
+			HOST_REG(model.regs, LDMA_TypeDef, LINKLOAD) = 0;
+			for(uint32_t ch = 0; ch < DMA_CHAN_COUNT; ch++){
+				if(value & (1UL << ch)){
+					EFM_ASSERT(model.ch[ch].link != NULL);
+					model.ch[ch].desc = model.ch[ch].link;
+					model.ch[ch].moved = 0;
+					HOST_REG(model.regs, LDMA_TypeDef, CHEN) |= 1UL << ch;
+					HOST_REG(model.regs, LDMA_TypeDef, CHDONE) &= ~(1UL << ch);
+				}
+			}
+			host_ldma_kick();
+			break;
+		case HOST_OFFSET(LDMA_TypeDef, IFS):
+			HOST_REG(model.regs, LDMA_TypeDef, IF) |= HOST_REG(model.regs, LDMA_TypeDef, IFS) & _LDMA_IF_MASK;
+			HOST_REG(model.regs, LDMA_TypeDef, IFS) = 0;
+			break;
+		case HOST_OFFSET(LDMA_TypeDef, IFC):
+			HOST_REG(model.regs, LDMA_TypeDef, IF) &= ~HOST_REG(model.regs, LDMA_TypeDef, IFC);
+			HOST_REG(model.regs, LDMA_TypeDef, IFC) = 0;
+			break;
+		default:
+			break;
+	}
+	host_ldma_irq();
+}
+
+//***********************************************************************************
+// Global functions
+//***********************************************************************************
+
+/***************************************************************************//**
+ * @brief
+ *   Opens the LDMA model
+ *
+ * @param[in] irq
+ *   Interrupt line the DONE and ERROR flags are routed to
+ *
+ ******************************************************************************/
+
+void host_ldma_model_open(IRQn_Type irq){
+	model.regs = host_bus_alias(LDMA_BASE);
+	model.irq = irq;
+	host_event_init(&model.event, "LDMA", HOST_EM1, host_ldma_run, &model);
+	host_bus_attach(LDMA_BASE, sizeof(LDMA_TypeDef), cmuClock_LDMA, host_ldma_access, &model);
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Hands the model the first descriptor of a channel
+ *
+ * @details
+ * 	 Called by LDMA_StartTransfer() ahead of the LINKLOAD write, in place of
+ * 	 the LINK register, which cannot hold a host pointer
+ *
+ ******************************************************************************/
+
+void host_ldma_link(uint32_t ch, const void *descriptor){
+	EFM_ASSERT(ch < DMA_CHAN_COUNT);
+	model.ch[ch].link = descriptor;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Reports the level of a peripheral's DMA request line
+ *
+ * @details
+ * 	 Called by the peripheral models whenever their status changes. A
+ * 	 raised line lets the channels that select it move.
+ *
+ * @param[in] signal
+ *   Line, as the REQSEL value a channel selects it with
+ *
+ * @param[in] level
+ *   true while the peripheral requests
+ *
+ ******************************************************************************/
+
+void host_ldma_request(uint32_t signal, bool level){
+	uint32_t i;
+
+	for(i = 0; i < model.request_count; i++){
+		if(model.signals[i] == signal){
+			break;
+		}
+	}
+	if(i == model.request_count){
+		EFM_ASSERT(model.request_count < HOST_LDMA_REQUESTS);
+		model.signals[model.request_count++] = signal;
+	}
+	model.levels[i] = level;
+
+	if(level && (HOST_REG(model.regs, LDMA_TypeDef, CHEN) & 0xFF)){
+		host_ldma_kick();
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Adds the units moved to the end of run report, if the LDMA was used
+ *
+ ******************************************************************************/
+
+void host_ldma_report(void){
+	if(model.units == 0 && model.writes == 0){
+		return;
+	}
+	fprintf(stderr, "[host]   LDMA     %10lu units moved %10lu register writes\n",
+			(unsigned long)model.units, (unsigned long)model.writes);
+}
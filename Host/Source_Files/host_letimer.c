@@ -0,0 +1,341 @@
+/**
+ * @file host_letimer.c
+ * @author James Brennan
+ * @date October 16th, 2026
+ * @brief LETIMER model for the host build.
+ *
+ * @details
+ * The counter is not ticked one count at a time. Its value is derived from
+ * the time of the last synchronization, and a single event is kept at the
+ * next tick that sets a flag: a compare match or the underflow. Outputs are
+ * not modeled.
+ *
+ * A read of CNT also arms an event at the next tick, as in the RTCC model,
+ * so two reads that see the same count are not taken for a busy-wait that
+ * can skip ahead to the next flag.
+ *
+ */
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+
+//** Standard Libraries
+#include <string.h>
+
+//** Silicon Lab include files
+#include "em_assert.h"
+#include "em_letimer.h"
+
+//** User/developer include files
+#include "host_bus.h"
+#include "host_energy.h"
+#include "host_engine.h"
+#include "host_models.h"
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+#define HOST_LETIMER_IF_MASK		0x0000001FUL
+
+typedef struct {
+	volatile void		*regs;			// model view of the register block
+	IRQn_Type			irq;			// interrupt line
+	CMU_Clock_TypeDef	clock;			// peripheral clock
+	HOST_EVENT			event;			// next flag setting tick
+	HOST_EVENT			tick;			// next tick after a read of CNT
+	bool				running;		// counter is counting
+	uint32_t			cnt;			// counter value at sync_time
+	HOST_TIME			sync_time;		// tick boundary the counter value belongs to
+} HOST_LETIMER_MODEL;
+
+//***********************************************************************************
+// Private variables
+//***********************************************************************************
+static HOST_LETIMER_MODEL letimer0_model;
+
+//***********************************************************************************
+// Private functions
+//***********************************************************************************
+
+/***************************************************************************//**
+ * @brief
+ *   Value loaded into the counter on underflow
+ *
+ ******************************************************************************/
+
+static uint32_t host_letimer_top(HOST_LETIMER_MODEL *model){
+	if(HOST_REG(model->regs, LETIMER_TypeDef, CTRL) & LETIMER_CTRL_COMP0TOP){
+		return HOST_REG(model->regs, LETIMER_TypeDef, COMP0) & _LETIMER_CNT_MASK;
+	}
+	return _LETIMER_CNT_MASK;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Sets a compare flag if the counter passed through its compare value
+ *
+ * @details
+ * 	 The flag is set when a tick moves the counter onto the compare value,
+ * 	 i.e. the value is in [to, from).
+ *
+ ******************************************************************************/
+
+static void host_letimer_match(HOST_LETIMER_MODEL *model, uint32_t from, uint32_t to){
+	uint32_t comp0 = HOST_REG(model->regs, LETIMER_TypeDef, COMP0) & _LETIMER_CNT_MASK;
+	uint32_t comp1 = HOST_REG(model->regs, LETIMER_TypeDef, COMP1) & _LETIMER_CNT_MASK;
+
+	if(comp0 >= to && comp0 < from){
+		HOST_REG(model->regs, LETIMER_TypeDef, IF) |= LETIMER_IF_COMP0;
+	}
+	if(comp1 >= to && comp1 < from){
+		HOST_REG(model->regs, LETIMER_TypeDef, IF) |= LETIMER_IF_COMP1;
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Counts a number of ticks down, handling underflows
+ *
+ * @details
+ * 	 In free mode the counter reloads forever. In the other repeat modes
+ * 	 REP0 is decremented on each underflow and the counter stops when it
+ * 	 reaches zero.
+ *
+ ******************************************************************************/
+
+static void host_letimer_count(HOST_LETIMER_MODEL *model, uint64_t ticks){
+	uint32_t top;
+
+	while(ticks > 0 && model->running){
+		if(ticks <= model->cnt){
+			host_letimer_match(model, model->cnt, model->cnt - (uint32_t)ticks);
+			model->cnt -= (uint32_t)ticks;
+			return;
+		}
+
+		ticks -= model->cnt + 1;
+		host_letimer_match(model, model->cnt, 0);
+		top = host_letimer_top(model);
+		model->cnt = top;
+		host_letimer_match(model, top + 1, top);
+		HOST_REG(model->regs, LETIMER_TypeDef, IF) |= LETIMER_IF_UF;
+		host_energy_underflow();
+
+		if((HOST_REG(model->regs, LETIMER_TypeDef, CTRL) & _LETIMER_CTRL_REPMODE_MASK) != letimerRepeatFree){
+			uint32_t rep0 = HOST_REG(model->regs, LETIMER_TypeDef, REP0) & 0xFF;
+
+			if(rep0 > 0){
+				HOST_REG(model->regs, LETIMER_TypeDef, REP0) = --rep0;
+				HOST_REG(model->regs, LETIMER_TypeDef, IF) |= rep0 == 0 ? LETIMER_IF_REP0 : 0;
+			}
+			if(rep0 == 0){
+				model->running = false;
+			}
+		}
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Brings the counter up to the current time
+ *
+ ******************************************************************************/
+
+static void host_letimer_sync(HOST_LETIMER_MODEL *model){
+	uint32_t hz = host_cmu_freq(model->clock);
+	uint64_t ticks;
+
+	if(model->running && hz != 0){
+		ticks = host_time_to_ticks(host_now() - model->sync_time, hz, 1);
+		model->sync_time += host_ticks_to_time(ticks, hz, 1);
+		host_letimer_count(model, ticks);
+	}
+	else{
+		model->sync_time = host_now();
+	}
+	HOST_REG(model->regs, LETIMER_TypeDef, CNT) = model->cnt;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Ticks until the counter next moves onto a value
+ *
+ ******************************************************************************/
+
+static uint64_t host_letimer_ticks_to(HOST_LETIMER_MODEL *model, uint32_t value){
+	uint32_t top = host_letimer_top(model);
+
+	if(value < model->cnt){
+		return model->cnt - value;
+	}
+	if(value <= top){
+		return (uint64_t)model->cnt + 1 + (top - value);
+	}
+	return UINT64_MAX;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Recomputes STATUS, the interrupt line and the next event
+ *
+ ******************************************************************************/
+
+static void host_letimer_update(HOST_LETIMER_MODEL *model){
+	uint32_t hz = host_cmu_freq(model->clock);
+	uint64_t ticks;
+	uint64_t comp;
+
+	HOST_REG(model->regs, LETIMER_TypeDef, STATUS) = model->running ? LETIMER_STATUS_RUNNING : 0;
+	HOST_REG(model->regs, LETIMER_TypeDef, SYNCBUSY) = 0;
+	HOST_REG(model->regs, LETIMER_TypeDef, IF) &= HOST_LETIMER_IF_MASK;
+	host_irq_set(model->irq, (HOST_REG(model->regs, LETIMER_TypeDef, IF) &
+			HOST_REG(model->regs, LETIMER_TypeDef, IEN) & HOST_LETIMER_IF_MASK) != 0);
+
+	if(!model->running || hz == 0){
+		host_event_cancel(&model->event);
+		return;
+	}
+
+	ticks = (uint64_t)model->cnt + 1;
+	comp = host_letimer_ticks_to(model, HOST_REG(model->regs, LETIMER_TypeDef, COMP0) & _LETIMER_CNT_MASK);
+	if(comp < ticks){
+		ticks = comp;
+	}
+	comp = host_letimer_ticks_to(model, HOST_REG(model->regs, LETIMER_TypeDef, COMP1) & _LETIMER_CNT_MASK);
+	if(comp < ticks){
+		ticks = comp;
+	}
+
+	model->event.lowest_em = host_cmu_lowest_em(model->clock);
+	host_event_schedule(&model->event, model->sync_time + host_ticks_to_time(ticks, hz, 1));
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Flag setting tick
+ *
+ ******************************************************************************/
+
+static void host_letimer_event(HOST_EVENT *event){
+	HOST_LETIMER_MODEL *model = event->ctx;
+
+	host_letimer_sync(model);
+	host_letimer_update(model);
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Returns the peripheral to its reset state for an EM4H entry
+ *
+ ******************************************************************************/
+
+static void host_letimer_reset(HOST_LETIMER_MODEL *model){
+	host_event_cancel(&model->tick);
+	model->running = false;
+	model->cnt = 0;
+	model->sync_time = host_now();
+	memset((void *)model->regs, 0, sizeof(LETIMER_TypeDef));
+	host_letimer_update(model);
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Register access hook
+ *
+ ******************************************************************************/
+
+static void host_letimer_access(void *ctx, uint32_t offset, HOST_ACCESS access){
+	HOST_LETIMER_MODEL *model = ctx;
+	uint32_t value;
+
+	if(access == HOST_ACCESS_RESET){
+		host_letimer_reset(model);
+		return;
+	}
+	if(access == HOST_ACCESS_PREREAD){
+		if(offset == HOST_OFFSET(LETIMER_TypeDef, CNT)){
+			host_letimer_sync(model);
+			if(model->running && host_cmu_freq(model->clock) != 0){
+				model->tick.lowest_em = host_cmu_lowest_em(model->clock);
+				host_event_schedule(&model->tick, model->sync_time + host_ticks_to_time(1, host_cmu_freq(model->clock), 1));
+			}
+		}
+		return;
+	}
+	if(access == HOST_ACCESS_READ){
+		return;
+	}
+
+	// the written value is taken before the counter sync rewrites CNT
+	value = *(volatile uint32_t *)((volatile uint8_t *)model->regs + offset);
+	host_letimer_sync(model);
+	switch(offset){
+		case HOST_OFFSET(LETIMER_TypeDef, CMD):
+			HOST_REG(model->regs, LETIMER_TypeDef, CMD) = 0;
+			if(value & LETIMER_CMD_CLEAR){
+				model->cnt = 0;
+			}
+			if(value & LETIMER_CMD_STOP){
+				model->running = false;
+			}
+			else if((value & LETIMER_CMD_START) && !model->running){
+				model->running = true;
+				model->sync_time = host_now();
+			}
+			HOST_REG(model->regs, LETIMER_TypeDef, CNT) = model->cnt;
+			break;
+		case HOST_OFFSET(LETIMER_TypeDef, CNT):
+			model->cnt = value & _LETIMER_CNT_MASK;
+			HOST_REG(model->regs, LETIMER_TypeDef, CNT) = model->cnt;
+			break;
+		case HOST_OFFSET(LETIMER_TypeDef, IFS):
+			HOST_REG(model->regs, LETIMER_TypeDef, IF) |= HOST_REG(model->regs, LETIMER_TypeDef, IFS);
+			HOST_REG(model->regs, LETIMER_TypeDef, IFS) = 0;
+			break;
+		case HOST_OFFSET(LETIMER_TypeDef, IFC):
+			HOST_REG(model->regs, LETIMER_TypeDef, IF) &= ~HOST_REG(model->regs, LETIMER_TypeDef, IFC);
+			HOST_REG(model->regs, LETIMER_TypeDef, IFC) = 0;
+			break;
+		case HOST_OFFSET(LETIMER_TypeDef, IEN):
+			HOST_REG(model->regs, LETIMER_TypeDef, IEN) &= HOST_LETIMER_IF_MASK;
+			break;
+		default:
+			break;
+	}
+	host_letimer_update(model);
+}
+
+//***********************************************************************************
+// Global functions
+//***********************************************************************************
+
+/***************************************************************************//**
+ * @brief
+ *   Opens the LETIMER model
+ *
+ * @param[in] letimer
+ *   Base address of the LETIMER peripheral
+ *
+ * @param[in] irq
+ *   Interrupt line of the peripheral
+ *
+ * @param[in] clock
+ *   Peripheral clock, one count per period
+ *
+ ******************************************************************************/
+
+void host_letimer_model_open(LETIMER_TypeDef *letimer, IRQn_Type irq, CMU_Clock_TypeDef clock){
+	HOST_LETIMER_MODEL *model = &letimer0_model;
+
+	EFM_ASSERT(letimer == LETIMER0);
+
+	model->regs = host_bus_alias((uint32_t)(uintptr_t)letimer);
+	model->irq = irq;
+	model->clock = clock;
+	host_event_init(&model->event, "LETIMER0", host_cmu_lowest_em(clock), host_letimer_event, model);
+	host_event_init(&model->tick, "LETIMER0", host_cmu_lowest_em(clock), host_letimer_event, model);
+
+	host_bus_attach((uint32_t)(uintptr_t)letimer, sizeof(LETIMER_TypeDef), clock, host_letimer_access, model);
+	host_letimer_update(model);
+}
@@ -0,0 +1,285 @@
+/**
+ * @file host_leuart.c
+ * @author James Brennan
+ * @date October 16th, 2026
+ * @brief LEUART transmitter model for the host build.
+ *
+ * @details
+ * Frames leave the transmit shifter at the baudrate programmed in CLKDIV and
+ * are written to stdout, standing in for the HM-10 forwarding them over BLE.
+ * Nothing is received on the host.
+ *
+ */
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+
+//** Standard Libraries
+#include <stdio.h>
+#include <string.h>
+
+//** Silicon Lab include files
+#include "em_assert.h"
+
+//** User/developer include files
+#include "host_bus.h"
+#include "host_energy.h"
+#include "host_engine.h"
+#include "host_models.h"
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+#define HOST_LEUART_IF_MASK		0x000007FFUL
+
+typedef struct {
+	volatile void		*regs;			// model view of the register block
+	IRQn_Type			irq;			// interrupt line
+	CMU_Clock_TypeDef	clock;			// peripheral clock
+	HOST_EVENT			event;			// end of the frame in the shifter
+	bool				shifting;		// shifter is sending a frame
+	uint8_t				shift;			// frame in the shifter
+	bool				tx_full;		// transmit buffer holds a frame
+	uint8_t				tx_byte;		// transmit buffer
+	HOST_LOAD			ble_load;		// BLE module, busy while a frame is sent to it
+} HOST_LEUART_MODEL;
+
+//***********************************************************************************
+// Private variables
+//***********************************************************************************
+static HOST_LEUART_MODEL leuart0_model;
+
+//***********************************************************************************
+// Private functions
+//***********************************************************************************
+
+/***************************************************************************//**
+ * @brief
+ *   Duration of one frame
+ *
+ * @details
+ * 	 baudrate = fLEUART / (1 + CLKDIV / 256), a frame is a start bit, the
+ * 	 data bits, an optional parity bit and the stop bits.
+ *
+ ******************************************************************************/
+
+static HOST_TIME host_leuart_frame_time(HOST_LEUART_MODEL *model){
+	uint32_t ctrl = HOST_REG(model->regs, LEUART_TypeDef, CTRL);
+	uint32_t clkdiv = HOST_REG(model->regs, LEUART_TypeDef, CLKDIV);
+	uint32_t bits = 1 + 8 + 1;
+
+	if(ctrl & LEUART_CTRL_DATABITS){
+		bits++;
+	}
+	if(ctrl & _LEUART_CTRL_PARITY_MASK){
+		bits++;
+	}
+	if(ctrl & LEUART_CTRL_STOPBITS){
+		bits++;
+	}
+
+	return (HOST_TIME)bits * (256 + clkdiv) * HOST_TIME_S / (256ULL * host_cmu_freq(model->clock));
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Recomputes STATUS, the level sensitive flags and the interrupt line
+ *
+ ******************************************************************************/
+
+static void host_leuart_update(HOST_LEUART_MODEL *model){
+	uint32_t status = HOST_REG(model->regs, LEUART_TypeDef, STATUS) & (LEUART_STATUS_RXENS | LEUART_STATUS_TXENS);
+	uint32_t flags = HOST_REG(model->regs, LEUART_TypeDef, IF);
+
+	// TXBL follows the buffer level and cannot be cleared through IFC
+	if(!model->tx_full){
+		status |= LEUART_STATUS_TXBL;
+		flags |= LEUART_IF_TXBL;
+	}
+	else{
+		flags &= ~LEUART_IF_TXBL;
+	}
+	if(!model->shifting && !model->tx_full){
+		status |= LEUART_STATUS_TXIDLE;
+	}
+	if(flags & LEUART_IF_TXC){
+		status |= LEUART_STATUS_TXC;
+	}
+
+	HOST_REG(model->regs, LEUART_TypeDef, STATUS) = status;
+	HOST_REG(model->regs, LEUART_TypeDef, IF) = flags & HOST_LEUART_IF_MASK;
+	HOST_REG(model->regs, LEUART_TypeDef, SYNCBUSY) = 0;
+
+	host_irq_set(model->irq, (flags & HOST_REG(model->regs, LEUART_TypeDef, IEN) & HOST_LEUART_IF_MASK) != 0);
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Moves the buffered frame into the shifter if the transmitter can take it
+ *
+ ******************************************************************************/
+
+static void host_leuart_kick(HOST_LEUART_MODEL *model){
+	if(model->shifting || !model->tx_full){
+		return;
+	}
+	if(!(HOST_REG(model->regs, LEUART_TypeDef, STATUS) & LEUART_STATUS_TXENS)){
+		return;
+	}
+	model->shift = model->tx_byte;
+	model->tx_full = false;
+	model->shifting = true;
+	host_load_set(&model->ble_load, true);
+	model->event.lowest_em = host_cmu_lowest_em(model->clock);
+	host_event_schedule(&model->event, host_now() + host_leuart_frame_time(model));
+}
+
+/***************************************************************************//**
+ * @brief
+ *   End of a frame
+ *
+ ******************************************************************************/
+
+static void host_leuart_event(HOST_EVENT *event){
+	HOST_LEUART_MODEL *model = event->ctx;
+
+	putchar(model->shift);
+	if(model->shift == '\n'){
+		fflush(stdout);
+	}
+
+	model->shifting = false;
+	host_leuart_kick(model);
+	host_load_set(&model->ble_load, model->shifting);
+	if(!model->shifting){
+		HOST_REG(model->regs, LEUART_TypeDef, IF) |= LEUART_IF_TXC;
+	}
+	host_leuart_update(model);
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Executes the commands written to CMD
+ *
+ ******************************************************************************/
+
+static void host_leuart_command(HOST_LEUART_MODEL *model, uint32_t cmd){
+	volatile uint32_t *status = &HOST_REG(model->regs, LEUART_TypeDef, STATUS);
+
+	if(cmd & LEUART_CMD_RXEN){
+		*status |= LEUART_STATUS_RXENS;
+	}
+	if(cmd & LEUART_CMD_RXDIS){
+		*status &= ~LEUART_STATUS_RXENS;
+	}
+	if(cmd & LEUART_CMD_TXEN){
+		*status |= LEUART_STATUS_TXENS;
+	}
+	if(cmd & LEUART_CMD_TXDIS){
+		// the frame in the shifter is completed, the buffer is kept
+		*status &= ~LEUART_STATUS_TXENS;
+	}
+	if(cmd & LEUART_CMD_CLEARTX){
+		model->tx_full = false;
+	}
+	host_leuart_kick(model);
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Returns the peripheral to its reset state for an EM4H entry
+ *
+ ******************************************************************************/
+
+static void host_leuart_reset(HOST_LEUART_MODEL *model){
+	host_event_cancel(&model->event);
+	model->shifting = false;
+	model->tx_full = false;
+	host_load_set(&model->ble_load, false);
+	memset((void *)model->regs, 0, sizeof(LEUART_TypeDef));
+	host_leuart_update(model);
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Register access hook
+ *
+ ******************************************************************************/
+
+static void host_leuart_access(void *ctx, uint32_t offset, HOST_ACCESS access){
+	HOST_LEUART_MODEL *model = ctx;
+	uint32_t value;
+
+	if(access == HOST_ACCESS_RESET){
+		host_leuart_reset(model);
+		return;
+	}
+	if(access != HOST_ACCESS_WRITE){
+		return;
+	}
+
+	switch(offset){
+		case HOST_OFFSET(LEUART_TypeDef, CMD):
+			value = HOST_REG(model->regs, LEUART_TypeDef, CMD);
+			HOST_REG(model->regs, LEUART_TypeDef, CMD) = 0;
+			host_leuart_command(model, value);
+			break;
+		case HOST_OFFSET(LEUART_TypeDef, TXDATA):
+			if(model->tx_full){
+				HOST_REG(model->regs, LEUART_TypeDef, IF) |= LEUART_IF_TXOF;
+			}
+			model->tx_byte = (uint8_t)HOST_REG(model->regs, LEUART_TypeDef, TXDATA);
+			model->tx_full = true;
+			host_leuart_kick(model);
+			break;
+		case HOST_OFFSET(LEUART_TypeDef, IFS):
+			HOST_REG(model->regs, LEUART_TypeDef, IF) |= HOST_REG(model->regs, LEUART_TypeDef, IFS);
+			HOST_REG(model->regs, LEUART_TypeDef, IFS) = 0;
+			break;
+		case HOST_OFFSET(LEUART_TypeDef, IFC):
+			HOST_REG(model->regs, LEUART_TypeDef, IF) &= ~HOST_REG(model->regs, LEUART_TypeDef, IFC);
+			HOST_REG(model->regs, LEUART_TypeDef, IFC) = 0;
+			break;
+		case HOST_OFFSET(LEUART_TypeDef, IEN):
+			HOST_REG(model->regs, LEUART_TypeDef, IEN) &= HOST_LEUART_IF_MASK;
+			break;
+		default:
+			break;
+	}
+	host_leuart_update(model);
+}
+
+//***********************************************************************************
+// Global functions
+//***********************************************************************************
+
+/***************************************************************************//**
+ * @brief
+ *   Opens the LEUART model
+ *
+ * @param[in] leuart
+ *   Base address of the LEUART peripheral
+ *
+ * @param[in] irq
+ *   Interrupt line of the peripheral
+ *
+ * @param[in] clock
+ *   Peripheral clock, sets the baudrate together with CLKDIV
+ *
+ ******************************************************************************/
+
+void host_leuart_model_open(LEUART_TypeDef *leuart, IRQn_Type irq, CMU_Clock_TypeDef clock){
+	HOST_LEUART_MODEL *model = &leuart0_model;
+
+	EFM_ASSERT(leuart == LEUART0);
+
+	model->regs = host_bus_alias((uint32_t)(uintptr_t)leuart);
+	model->irq = irq;
+	model->clock = clock;
+	host_event_init(&model->event, "LEUART0", host_cmu_lowest_em(clock), host_leuart_event, model);
+	host_load_init(&model->ble_load, "BLE", HOST_PARAM_BLE_TX_UA, HOST_PARAM_BLE_IDLE_UA);
+
+	host_bus_attach((uint32_t)(uintptr_t)leuart, sizeof(LEUART_TypeDef), clock, host_leuart_access, model);
+	host_leuart_update(model);
+}
@@ -0,0 +1,250 @@
+/**
+ * @file host_rtcc.c
+ * @author James Brennan
+ * @date October 16th, 2026
+ * @brief RTCC model for the host build.
+ *
+ * @details
+ * The counter runs free in normal mode. As with the LETIMER model its value
+ * is derived from the time of the last synchronization, so reading CNT costs
+ * nothing while the core sleeps. The retention registers are plain memory.
+ *
+ * A read of CNT counts as activity. The firmware only reads it for
+ * timestamps, often twice from the same place within one tick, and those
+ * reads must not be taken for a busy-wait and fast-forwarded.
+ *
+ * The capture/compare channels are modeled in output compare mode, a match
+ * sets the channel's flag. The RTCC is in the EM4H domain: it keeps its
+ * registers through an EM4H entry, and an enabled flag wakes the chip when
+ * EM4WUEN is set.
+ *
+ */
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+
+//** Standard Libraries
+
+//** Silicon Lab include files
+#include "em_assert.h"
+
+//** User/developer include files
+#include "host_bus.h"
+#include "host_engine.h"
+#include "host_models.h"
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+#define HOST_RTCC_IF_MASK			0x000000FFUL
+#define HOST_RTCC_CHANNELS			3
+
+typedef struct {
+	volatile void		*regs;			// model view of the register block
+	CMU_Clock_TypeDef	clock;			// peripheral clock
+	HOST_EVENT			event;			// next compare match
+	uint32_t			ctrl;			// CTRL the counter last ran with
+	uint32_t			cnt;			// counter value at sync_time
+	HOST_TIME			sync_time;		// tick boundary the counter value belongs to
+} HOST_RTCC_MODEL;
+
+//***********************************************************************************
+// Private variables
+//***********************************************************************************
+static HOST_RTCC_MODEL rtcc_model;
+
+//***********************************************************************************
+// Private functions
+//***********************************************************************************
+
+/***************************************************************************//**
+ * @brief
+ *   Returns true if the counter is counting
+ *
+ ******************************************************************************/
+
+static bool host_rtcc_counting(HOST_RTCC_MODEL *model){
+	return (model->ctrl & RTCC_CTRL_ENABLE) && host_cmu_freq(model->clock) != 0 && host_cmu_enabled(model->clock);
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Brings the counter up to the current time
+ *
+ * @details
+ * 	 Uses the CTRL value the counter was running with, so a write to CTRL
+ * 	 only takes effect from the moment it is made.
+ *
+ ******************************************************************************/
+
+static void host_rtcc_sync(HOST_RTCC_MODEL *model){
+	uint32_t hz = host_cmu_freq(model->clock);
+	uint32_t div = 1UL << ((model->ctrl & _RTCC_CTRL_CNTPRESC_MASK) >> _RTCC_CTRL_CNTPRESC_SHIFT);
+	uint64_t ticks;
+
+	if(host_rtcc_counting(model)){
+		ticks = host_time_to_ticks(host_now() - model->sync_time, hz, div);
+		model->sync_time += host_ticks_to_time(ticks, hz, div);
+		if(ticks > UINT32_MAX - model->cnt){
+			HOST_REG(model->regs, RTCC_TypeDef, IF) |= RTCC_IF_OF;
+		}
+		model->cnt += (uint32_t)ticks;
+	}
+	else{
+		model->sync_time = host_now();
+	}
+	HOST_REG(model->regs, RTCC_TypeDef, CNT) = model->cnt;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Returns true if a channel is in output compare mode
+ *
+ ******************************************************************************/
+
+static bool host_rtcc_compare(HOST_RTCC_MODEL *model, uint32_t ch){
+	return (HOST_REG(model->regs, RTCC_TypeDef, CC[ch].CTRL) & _RTCC_CC_CTRL_MODE_MASK) == RTCC_CC_CTRL_MODE_OUTPUTCOMPARE;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Drives the EM4 wake-up line and aims the event at the next compare match
+ *
+ * @details
+ * 	 A channel matches when the counter steps onto its CCV, so a CCV equal
+ * 	 to the current count is next matched after the counter wraps.
+ *
+ ******************************************************************************/
+
+static void host_rtcc_update(HOST_RTCC_MODEL *model){
+	uint32_t hz = host_cmu_freq(model->clock);
+	uint32_t div = 1UL << ((model->ctrl & _RTCC_CTRL_CNTPRESC_MASK) >> _RTCC_CTRL_CNTPRESC_SHIFT);
+	uint64_t ticks = UINT64_MAX;
+	uint64_t match;
+
+	host_em4_wakeup((HOST_REG(model->regs, RTCC_TypeDef, IF) & HOST_REG(model->regs, RTCC_TypeDef, IEN) & HOST_RTCC_IF_MASK) &&
+			(HOST_REG(model->regs, RTCC_TypeDef, EM4WUEN) & RTCC_EM4WUEN_EM4WU));
+
+	if(host_rtcc_counting(model)){
+		for(uint32_t ch = 0; ch < HOST_RTCC_CHANNELS; ch++){
+			if(!host_rtcc_compare(model, ch)){
+				continue;
+			}
+			match = (uint32_t)(HOST_REG(model->regs, RTCC_TypeDef, CC[ch].CCV) - model->cnt);
+			if(match == 0){
+				match = 1ULL << 32;
+			}
+			if(match < ticks){
+				ticks = match;
+			}
+		}
+	}
+	if(ticks == UINT64_MAX){
+		host_event_cancel(&model->event);
+		return;
+	}
+	model->event.lowest_em = host_cmu_lowest_em(model->clock);
+	host_event_schedule(&model->event, model->sync_time + host_ticks_to_time(ticks, hz, div));
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Compare match
+ *
+ ******************************************************************************/
+
+static void host_rtcc_event(HOST_EVENT *event){
+	HOST_RTCC_MODEL *model = event->ctx;
+
+	host_rtcc_sync(model);
+	for(uint32_t ch = 0; ch < HOST_RTCC_CHANNELS; ch++){
+		if(host_rtcc_compare(model, ch) && HOST_REG(model->regs, RTCC_TypeDef, CC[ch].CCV) == model->cnt){
+			HOST_REG(model->regs, RTCC_TypeDef, IF) |= RTCC_IF_CC0 << ch;
+		}
+	}
+	host_rtcc_update(model);
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Register access hook
+ *
+ ******************************************************************************/
+
+static void host_rtcc_access(void *ctx, uint32_t offset, HOST_ACCESS access){
+	HOST_RTCC_MODEL *model = ctx;
+	uint32_t value;
+
+	if(access == HOST_ACCESS_RESET){
+		// the RTCC keeps counting and keeps its registers through EM4H
+		host_rtcc_sync(model);
+		host_rtcc_update(model);
+		return;
+	}
+	if(access == HOST_ACCESS_PREREAD){
+		if(offset == HOST_OFFSET(RTCC_TypeDef, CNT)){
+			host_rtcc_sync(model);
+			host_activity();
+		}
+		return;
+	}
+	if(access == HOST_ACCESS_READ){
+		return;
+	}
+
+	// the written value is taken before the counter sync rewrites CNT
+	value = *(volatile uint32_t *)((volatile uint8_t *)model->regs + offset);
+	host_rtcc_sync(model);
+	switch(offset){
+		case HOST_OFFSET(RTCC_TypeDef, CTRL):
+			model->ctrl = value;
+			break;
+		case HOST_OFFSET(RTCC_TypeDef, CNT):
+			model->cnt = value;
+			HOST_REG(model->regs, RTCC_TypeDef, CNT) = model->cnt;
+			break;
+		case HOST_OFFSET(RTCC_TypeDef, IFS):
+			HOST_REG(model->regs, RTCC_TypeDef, IF) |= value;
+			HOST_REG(model->regs, RTCC_TypeDef, IFS) = 0;
+			break;
+		case HOST_OFFSET(RTCC_TypeDef, IFC):
+			HOST_REG(model->regs, RTCC_TypeDef, IF) &= ~value;
+			HOST_REG(model->regs, RTCC_TypeDef, IFC) = 0;
+			break;
+		default:
+			break;
+	}
+	HOST_REG(model->regs, RTCC_TypeDef, IF) &= HOST_RTCC_IF_MASK;
+	HOST_REG(model->regs, RTCC_TypeDef, SYNCBUSY) = 0;
+	host_rtcc_update(model);
+}
+
+//***********************************************************************************
+// Global functions
+//***********************************************************************************
+
+/***************************************************************************//**
+ * @brief
+ *   Opens the RTCC model
+ *
+ * @param[in] rtcc
+ *   Base address of the RTCC peripheral
+ *
+ * @param[in] clock
+ *   Peripheral clock, divided by the counter prescaler
+ *
+ ******************************************************************************/
+
+void host_rtcc_model_open(RTCC_TypeDef *rtcc, CMU_Clock_TypeDef clock){
+	HOST_RTCC_MODEL *model = &rtcc_model;
+
+	EFM_ASSERT(rtcc == RTCC);
+
+	model->regs = host_bus_alias((uint32_t)(uintptr_t)rtcc);
+	model->clock = clock;
+	model->sync_time = host_now();
+	host_event_init(&model->event, "RTCC", host_cmu_lowest_em(clock), host_rtcc_event, model);
+
+	host_bus_attach((uint32_t)(uintptr_t)rtcc, sizeof(RTCC_TypeDef), clock, host_rtcc_access, model);
+}
@@ -0,0 +1,622 @@
+/**
+ * @file host_sensors.c
+ * @author James Brennan
+ * @date October 16th, 2026
+ * @brief Si7021 and VEML6030 slave models for the host build.
+ *
+ * @details
+ * The Si7021 conversion time follows the resolution in its user register,
+ * and reads are NACKed until the conversion is done, which is how the part
+ * behaves in no hold master mode. Measurements carry the CRC byte. The
+ * VEML6030 integrates for the time set in ALS_CONF and only updates its ALS
+ * and WHITE registers at the end of each integration, scaled by the gain.
+ *
+ * The readings come from PG_SENSORS if it names a file, and are otherwise
+ * fixed values that fall inside the ranges si7021_test() checks. The file
+ * is CSV: a header names the columns, time in seconds then any of humidity
+ * (%RH), temperature (C), lux and white (lux), and each row gives their
+ * values at that time. Values are interpolated between rows and held after
+ * the last one, a column left out keeps its fixed value.
+ *
+ *   time,humidity,temperature,lux
+ *   0,40,24,300
+ *   30,65,21.5,20      # dusk and rising humidity over half a minute
+ *
+ */
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+
+//** Standard Libraries
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+//** Silicon Lab include files
+
+//** User/developer include files
+#include "host_energy.h"
+#include "host_engine.h"
+#include "host_models.h"
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+#define SI7021_MODEL_ADDRESS		0x40
+#define SI7021_MODEL_MEASURE_RH		0xF5		// measure humidity, no hold master
+#define SI7021_MODEL_MEASURE_TEMP	0xF3		// measure temperature, no hold master
+#define SI7021_MODEL_READ_TEMP		0xE0		// temperature of the last humidity measurement
+#define SI7021_MODEL_WRITE_USER		0xE6
+#define SI7021_MODEL_READ_USER		0xE7
+#define SI7021_MODEL_RESET			0xFE
+#define SI7021_MODEL_USER_RESET		0x3A		// user register after power up
+#define SI7021_MODEL_USER_MASK		0x85		// writable bits: RES1, HTRE, RES0
+
+#define VEML6030_MODEL_ADDRESS		0x48
+#define VEML6030_MODEL_ALS_CONF		0x00
+#define VEML6030_MODEL_ALS			0x04
+#define VEML6030_MODEL_WHITE		0x05
+#define VEML6030_MODEL_REGISTERS	0x08
+#define VEML6030_MODEL_SD			0x0001		// ALS_CONF shutdown bit
+#define VEML6030_MODEL_IT_SHIFT		6			// ALS_CONF integration time field
+#define VEML6030_MODEL_IT_MASK		0xF
+#define VEML6030_MODEL_GAIN_SHIFT	11			// ALS_CONF gain field
+#define VEML6030_MODEL_GAIN_MASK	0x3
+#define VEML6030_MODEL_LUX_PER_CODE	0.0036		// resolution at gain 2 and 800 ms
+
+// Rows PG_SENSORS can hold, and the longest line it may have
+#define HOST_SENSOR_ROWS			4096
+#define HOST_SENSOR_LINE			256
+
+// Quantities the sensors measure, the columns of PG_SENSORS
+typedef enum {
+	HOST_SENSOR_HUMIDITY,
+	HOST_SENSOR_TEMPERATURE,
+	HOST_SENSOR_LUX,
+	HOST_SENSOR_WHITE,
+	HOST_SENSOR_COUNT
+} HOST_SENSOR_QUANTITY;
+
+// Values of every quantity at one time of the script
+typedef struct {
+	HOST_TIME			time;
+	double				value[HOST_SENSOR_COUNT];
+} HOST_SENSOR_ROW;
+
+typedef struct {
+	HOST_I2C_DEVICE		dev;			// must be first, the I2C model hands this back
+	uint8_t				user_reg;		// user register 1
+	uint8_t				command;		// last command byte
+	bool				command_done;	// command byte received in this transaction
+	HOST_TIME			started;		// start of the running conversion
+	HOST_TIME			ready;			// end of the running conversion
+	bool				converted;		// a measurement waits to be read
+	uint16_t			temp_code;		// temperature of the last humidity measurement
+	uint8_t				out[3];			// bytes returned on the next read
+	uint32_t			out_len;
+	uint32_t			out_pos;
+	HOST_LOAD			load;			// supply current, raised during a conversion
+	uint32_t			conversions;
+	uint32_t			polls;			// read addresses NACKed during a conversion
+	HOST_TIME			overshoot;		// time measurements waited to be read
+	HOST_TIME			overshoot_max;
+	HOST_TIME			latency;		// time from command to read out
+	HOST_TIME			latency_max;
+} SI7021_MODEL;
+
+typedef struct {
+	HOST_I2C_DEVICE		dev;			// must be first, the I2C model hands this back
+	uint16_t			regs[VEML6030_MODEL_REGISTERS];
+	uint8_t				command;		// register pointer
+	uint32_t			count;			// bytes written in this transaction
+	uint32_t			out_pos;
+	HOST_TIME			integrating;	// start of the first integration since ALS_CONF changed
+	HOST_LOAD			load;			// supply current, raised out of shutdown
+	uint32_t			reads;			// reads of ALS or WHITE
+	uint32_t			empty;			// of which came before the first integration ended
+} VEML6030_MODEL;
+
+//***********************************************************************************
+// Private variables
+//***********************************************************************************
+static SI7021_MODEL si7021_model;
+static VEML6030_MODEL veml6030_model;
+
+static const char *const sensor_names[HOST_SENSOR_COUNT] = {
+	[HOST_SENSOR_HUMIDITY]		= "humidity",
+	[HOST_SENSOR_TEMPERATURE]	= "temperature",
+	[HOST_SENSOR_LUX]			= "lux",
+	[HOST_SENSOR_WHITE]			= "white",
+};
+
+// readings without a script: 40 %RH, 24 C and about 300 lux
+static const double sensor_defaults[HOST_SENSOR_COUNT] = { 40.0, 24.0, 300.0, 300.0 };
+
+static HOST_SENSOR_ROW sensor_rows[HOST_SENSOR_ROWS];
+static uint32_t sensor_row_count;
+
+//***********************************************************************************
+// Private functions
+//***********************************************************************************
+
+/***************************************************************************//**
+ * @brief
+ *   Reads the PG_SENSORS file
+ *
+ * @details
+ * 	 # starts a comment. The first line that is not empty is the header,
+ * 	 columns are separated by commas or white space. It must have a time
+ * 	 column. An unknown or repeated column, a field that is not a number, a
+ * 	 row of the wrong length or rows out of time order end the run, as in
+ * 	 PG_ENERGY.
+ *
+ ******************************************************************************/
+
+static void host_sensors_load(const char *path){
+	char line[HOST_SENSOR_LINE];
+	int columns[HOST_SENSOR_COUNT + 1];
+	int column_count = 0;
+	FILE *file = fopen(path, "r");
+
+	if(file == NULL){
+		fprintf(stderr, "[host] cannot open PG_SENSORS file %s\n", path);
+		exit(EXIT_FAILURE);
+	}
+	while(fgets(line, sizeof(line), file) != NULL){
+		HOST_SENSOR_ROW *row = &sensor_rows[sensor_row_count];
+		char *field;
+		int n = 0;
+
+		line[strcspn(line, "#\r\n")] = '\0';
+		if(strspn(line, " \t,") == strlen(line)){
+			continue;
+		}
+
+		// the header maps each column to a quantity, -1 for the time, and
+		// names each at most once
+		if(column_count == 0){
+			bool timed = false;
+
+			for(field = strtok(line, " \t,"); field != NULL; field = strtok(NULL, " \t,")){
+				int i = -1;
+				int seen;
+
+				if(strcmp(field, "time") != 0){
+					for(i = 0; i < HOST_SENSOR_COUNT && strcmp(field, sensor_names[i]) != 0; i++);
+				}
+				for(seen = 0; seen < column_count && columns[seen] != i; seen++);
+				if(i == HOST_SENSOR_COUNT || seen != column_count){
+					fprintf(stderr, "[host] bad PG_SENSORS column %s\n", field);
+					exit(EXIT_FAILURE);
+				}
+				columns[column_count++] = i;
+				timed |= (i < 0);
+			}
+			if(!timed){
+				fprintf(stderr, "[host] bad PG_SENSORS header, no time column\n");
+				exit(EXIT_FAILURE);
+			}
+			continue;
+		}
+
+		if(sensor_row_count == HOST_SENSOR_ROWS){
+			fprintf(stderr, "[host] PG_SENSORS has more than %d rows\n", HOST_SENSOR_ROWS);
+			exit(EXIT_FAILURE);
+		}
+		memcpy(row->value, sensor_defaults, sizeof(row->value));
+		for(field = strtok(line, " \t,"); field != NULL && n < column_count; field = strtok(NULL, " \t,"), n++){
+			char *end;
+			double value = strtod(field, &end);
+
+			if(*end != '\0' || !isfinite(value) || (columns[n] < 0 && value < 0.0)){
+				fprintf(stderr, "[host] bad PG_SENSORS value %s\n", field);
+				exit(EXIT_FAILURE);
+			}
+			if(columns[n] < 0){
+				row->time = (HOST_TIME)(value * HOST_TIME_S);
+			}
+			else{
+				row->value[columns[n]] = value;
+			}
+		}
+		if(n != column_count || field != NULL || (sensor_row_count != 0 && row->time < sensor_rows[sensor_row_count - 1].time)){
+			fprintf(stderr, "[host] bad PG_SENSORS row at %.3f s\n", (double)row->time / HOST_TIME_S);
+			exit(EXIT_FAILURE);
+		}
+		sensor_row_count++;
+	}
+	fclose(file);
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Returns a quantity at a time, from the script or its fixed value
+ *
+ ******************************************************************************/
+
+static double host_sensor_value(HOST_SENSOR_QUANTITY quantity, HOST_TIME time){
+	HOST_SENSOR_ROW *before;
+	HOST_SENSOR_ROW *after;
+	double fraction;
+	uint32_t i;
+
+	if(sensor_row_count == 0){
+		return sensor_defaults[quantity];
+	}
+	for(i = 0; i < sensor_row_count && sensor_rows[i].time <= time; i++);
+	if(i == 0){
+		return sensor_rows[0].value[quantity];
+	}
+	if(i == sensor_row_count){
+		return sensor_rows[i - 1].value[quantity];
+	}
+
+	// between rows i - 1 and i
+	before = &sensor_rows[i - 1];
+	after = &sensor_rows[i];
+	fraction = (double)(time - before->time) / (double)(after->time - before->time);
+
+	return before->value[quantity] + fraction * (after->value[quantity] - before->value[quantity]);
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Rounds a reading to the nearest 16-bit code, clamped to the range
+ *
+ ******************************************************************************/
+
+static uint16_t host_sensor_code(double code){
+	if(code <= 0.0){
+		return 0;
+	}
+	if(code >= 65535.0){
+		return 65535;
+	}
+	return (uint16_t)(code + 0.5);
+}
+
+/***************************************************************************//**
+ * @brief
+ *   CRC-8 the Si7021 appends to measurements, polynomial x^8 + x^5 + x^4 + 1
+ *
+ ******************************************************************************/
+
+static uint8_t si7021_model_crc(const uint8_t *data, uint32_t len){
+	uint8_t crc = 0;
+
+	for(uint32_t i = 0; i < len; i++){
+		crc ^= data[i];
+		for(uint32_t bit = 0; bit < 8; bit++){
+			crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x31) : (uint8_t)(crc << 1);
+		}
+	}
+	return crc;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Conversion time at the current resolution, the temperature alone or
+ *   humidity plus the temperature measured with it
+ *
+ ******************************************************************************/
+
+static HOST_TIME si7021_model_conversion(SI7021_MODEL *model, bool humidity){
+	static const HOST_TIME rh_us[4] = {
+		12000,		// RH 12 bit, T 14 bit
+		3100,		// RH 8 bit, T 12 bit
+		4500,		// RH 10 bit, T 13 bit
+		7000,		// RH 11 bit, T 11 bit
+	};
+	static const HOST_TIME temp_us[4] = { 10800, 3800, 6200, 2400 };
+	uint32_t res = ((model->user_reg >> 6) & 0x2) | (model->user_reg & 0x1);
+
+	return ((humidity ? rh_us[res] : 0) + temp_us[res]) * HOST_TIME_US;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Temperature code of the datasheet's conversion, at a time
+ *
+ ******************************************************************************/
+
+static uint16_t si7021_model_temp_code(HOST_TIME time){
+	return host_sensor_code((host_sensor_value(HOST_SENSOR_TEMPERATURE, time) + 46.85) * 65536.0 / 175.72);
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Queues the bytes returned on the next read
+ *
+ ******************************************************************************/
+
+static void si7021_model_output(SI7021_MODEL *model, uint16_t code, bool crc){
+	model->out[0] = (uint8_t)(code >> 8);
+	model->out[1] = (uint8_t)code;
+	model->out[2] = si7021_model_crc(model->out, 2);
+	model->out_len = crc ? 3 : 2;
+	model->out_pos = 0;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Starts a measurement, whose result is what the part sees at its end
+ *
+ ******************************************************************************/
+
+static void si7021_model_measure(SI7021_MODEL *model, bool humidity){
+	uint16_t code;
+
+	model->started = host_now();
+	model->ready = model->started + si7021_model_conversion(model, humidity);
+	model->converted = true;
+	model->conversions++;
+	host_load_until(&model->load, model->ready);
+	if(humidity){
+		host_energy_sample();
+	}
+
+	model->temp_code = si7021_model_temp_code(model->ready);
+	if(humidity){
+		code = host_sensor_code((host_sensor_value(HOST_SENSOR_HUMIDITY, model->ready) + 6.0) * 65536.0 / 125.0);
+	}
+	else{
+		code = model->temp_code;
+	}
+	si7021_model_output(model, code, true);
+}
+
+static bool si7021_model_start(HOST_I2C_DEVICE *dev, bool read){
+	SI7021_MODEL *model = (SI7021_MODEL *)dev;
+	HOST_TIME now = host_now();
+
+	if(read){
+		if(model->converted){
+			// no hold master: the read address is NACKed until the conversion ends
+			if(now < model->ready){
+				model->polls++;
+				return false;
+			}
+			model->converted = false;
+			model->overshoot += now - model->ready;
+			model->latency += now - model->started;
+			if(now - model->ready > model->overshoot_max){
+				model->overshoot_max = now - model->ready;
+			}
+			if(now - model->started > model->latency_max){
+				model->latency_max = now - model->started;
+			}
+		}
+		model->out_pos = 0;
+	}
+	else{
+		model->command_done = false;
+	}
+	return true;
+}
+
+static bool si7021_model_write(HOST_I2C_DEVICE *dev, uint8_t data){
+	SI7021_MODEL *model = (SI7021_MODEL *)dev;
+
+	if(!model->command_done){
+		model->command = data;
+		model->command_done = true;
+		model->converted = false;
+		switch(data){
+			case SI7021_MODEL_MEASURE_RH:
+				si7021_model_measure(model, true);
+				break;
+			case SI7021_MODEL_MEASURE_TEMP:
+				si7021_model_measure(model, false);
+				break;
+			case SI7021_MODEL_READ_TEMP:
+				si7021_model_output(model, model->temp_code, false);
+				break;
+			case SI7021_MODEL_READ_USER:
+				model->out[0] = model->user_reg;
+				model->out_len = 1;
+				model->out_pos = 0;
+				break;
+			case SI7021_MODEL_RESET:
+				model->user_reg = SI7021_MODEL_USER_RESET;
+				break;
+			case SI7021_MODEL_WRITE_USER:
+				break;
+			default:
+				return false;
+		}
+		return true;
+	}
+
+	if(model->command == SI7021_MODEL_WRITE_USER){
+		model->user_reg = (uint8_t)((model->user_reg & ~SI7021_MODEL_USER_MASK) | (data & SI7021_MODEL_USER_MASK));
+		return true;
+	}
+	return false;
+}
+
+static uint8_t si7021_model_read(HOST_I2C_DEVICE *dev){
+	SI7021_MODEL *model = (SI7021_MODEL *)dev;
+
+	if(model->out_pos < model->out_len){
+		return model->out[model->out_pos++];
+	}
+	return 0xFF;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Integration time set in ALS_CONF, 0 for a reserved setting
+ *
+ ******************************************************************************/
+
+static HOST_TIME veml6030_model_integration(VEML6030_MODEL *model){
+	static const uint32_t it_ms[VEML6030_MODEL_IT_MASK + 1] = {
+		[0x0] = 100, [0x1] = 200, [0x2] = 400, [0x3] = 800, [0x8] = 50, [0xC] = 25,
+	};
+
+	return it_ms[(model->regs[VEML6030_MODEL_ALS_CONF] >> VEML6030_MODEL_IT_SHIFT) & VEML6030_MODEL_IT_MASK] * HOST_TIME_MS;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   ALS or WHITE code of the last integration that has ended
+ *
+ * @details
+ * 	 Integrations run back to back from when the sensor was last powered on
+ * 	 or reconfigured. A code is lux over the resolution, which doubles with
+ * 	 each halving of the integration time and scales with the gain. Before
+ * 	 the first integration ends the registers read 0.
+ *
+ ******************************************************************************/
+
+static uint16_t veml6030_model_code(VEML6030_MODEL *model, HOST_SENSOR_QUANTITY quantity){
+	static const double gain[VEML6030_MODEL_GAIN_MASK + 1] = { 1.0, 2.0, 0.125, 0.25 };
+	uint16_t conf = model->regs[VEML6030_MODEL_ALS_CONF];
+	HOST_TIME it = veml6030_model_integration(model);
+	HOST_TIME now = host_now();
+	HOST_TIME end;
+	double resolution;
+
+	model->reads++;
+	if((conf & VEML6030_MODEL_SD) || it == 0 || now < model->integrating + it){
+		model->empty++;
+		return 0;
+	}
+	end = model->integrating + (now - model->integrating) / it * it;
+	resolution = VEML6030_MODEL_LUX_PER_CODE * (2.0 / gain[(conf >> VEML6030_MODEL_GAIN_SHIFT) & VEML6030_MODEL_GAIN_MASK])
+			* (800.0 * HOST_TIME_MS / it);
+	return host_sensor_code(host_sensor_value(quantity, end) / resolution);
+}
+
+static bool veml6030_model_start(HOST_I2C_DEVICE *dev, bool read){
+	VEML6030_MODEL *model = (VEML6030_MODEL *)dev;
+
+	if(read){
+		model->out_pos = 0;
+	}
+	else{
+		model->count = 0;
+	}
+	return true;
+}
+
+static bool veml6030_model_write(HOST_I2C_DEVICE *dev, uint8_t data){
+	VEML6030_MODEL *model = (VEML6030_MODEL *)dev;
+	uint16_t *reg;
+
+	if(model->count == 0){
+		model->count++;
+		if(data >= VEML6030_MODEL_REGISTERS){
+			return false;
+		}
+		model->command = data;
+		return true;
+	}
+
+	// register writes are LSB then MSB
+	reg = &model->regs[model->command];
+	if(model->count == 1){
+		*reg = (uint16_t)((*reg & 0xFF00) | data);
+	}
+	else if(model->count == 2){
+		*reg = (uint16_t)((*reg & 0x00FF) | (data << 8));
+	}
+	else{
+		return false;
+	}
+	model->count++;
+	if(model->command == VEML6030_MODEL_ALS_CONF){
+		model->integrating = host_now();
+	}
+	host_load_set(&model->load, !(model->regs[VEML6030_MODEL_ALS_CONF] & VEML6030_MODEL_SD));
+	return true;
+}
+
+static uint8_t veml6030_model_read(HOST_I2C_DEVICE *dev){
+	VEML6030_MODEL *model = (VEML6030_MODEL *)dev;
+	uint16_t value = model->regs[model->command];
+
+	// the result is latched with the low byte, the high byte follows it
+	if(model->out_pos == 0 && model->command == VEML6030_MODEL_ALS){
+		value = model->regs[VEML6030_MODEL_ALS] = veml6030_model_code(model, HOST_SENSOR_LUX);
+	}
+	else if(model->out_pos == 0 && model->command == VEML6030_MODEL_WHITE){
+		value = model->regs[VEML6030_MODEL_WHITE] = veml6030_model_code(model, HOST_SENSOR_WHITE);
+	}
+
+	// register reads are LSB then MSB
+	return (uint8_t)(model->out_pos++ == 0 ? value : value >> 8);
+}
+
+//***********************************************************************************
+// Global functions
+//***********************************************************************************
+
+/***************************************************************************//**
+ * @brief
+ *   Attaches the sensors to the buses the firmware expects them on
+ *
+ * @details
+ * 	 The Si7021 sits on I2C1 and the VEML6030 on I2C0, as in brd_config.h.
+ * 	 If PG_SENSORS names a file, the readings follow it.
+ *
+ ******************************************************************************/
+
+void host_sensors_open(void){
+	const char *path = getenv("PG_SENSORS");
+
+	if(path != NULL){
+		host_sensors_load(path);
+	}
+
+	si7021_model.dev.address = SI7021_MODEL_ADDRESS;
+	si7021_model.dev.start = si7021_model_start;
+	si7021_model.dev.write = si7021_model_write;
+	si7021_model.dev.read = si7021_model_read;
+	si7021_model.user_reg = SI7021_MODEL_USER_RESET;
+	host_load_init(&si7021_model.load, "Si7021", HOST_PARAM_SI7021_CONV_UA, HOST_PARAM_SI7021_IDLE_UA);
+	host_i2c_attach(I2C1, &si7021_model.dev);
+
+	veml6030_model.dev.address = VEML6030_MODEL_ADDRESS;
+	veml6030_model.dev.start = veml6030_model_start;
+	veml6030_model.dev.write = veml6030_model_write;
+	veml6030_model.dev.read = veml6030_model_read;
+	veml6030_model.regs[VEML6030_MODEL_ALS_CONF] = VEML6030_MODEL_SD;
+	host_load_init(&veml6030_model.load, "VEML6030", HOST_PARAM_VEML6030_ON_UA, HOST_PARAM_VEML6030_SD_UA);
+	host_i2c_attach(I2C0, &veml6030_model.dev);
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Prints how the firmware kept up with the sensors
+ *
+ * @details
+ * 	 For the Si7021, the read addresses NACKed while it converted, how long
+ * 	 each measurement waited to be read once it was done, and the time from
+ * 	 its command to its read out, which is most of a sample's latency. For
+ * 	 the VEML6030, the reads that came before its first integration ended.
+ *
+ ******************************************************************************/
+
+void host_sensors_report(void){
+	SI7021_MODEL *si7021 = &si7021_model;
+	uint32_t read = si7021->conversions - (si7021->converted ? 1 : 0);
+
+	if(sensor_row_count != 0){
+		fprintf(stderr, "[host]   sensors  %10lu script rows over %.3f s\n", (unsigned long)sensor_row_count,
+				(double)sensor_rows[sensor_row_count - 1].time / HOST_TIME_S);
+	}
+	if(read != 0){
+		fprintf(stderr, "[host]   Si7021   %10lu conversions %6lu polls NACKed %8.3f ms avg %8.3f ms max read out late"
+				" %8.3f ms avg %8.3f ms max command to read out\n",
+				(unsigned long)si7021->conversions, (unsigned long)si7021->polls,
+				(double)si7021->overshoot / read / HOST_TIME_MS, (double)si7021->overshoot_max / HOST_TIME_MS,
+				(double)si7021->latency / read / HOST_TIME_MS, (double)si7021->latency_max / HOST_TIME_MS);
+	}
+	if(veml6030_model.reads != 0){
+		fprintf(stderr, "[host]   VEML6030 %10lu reads %6lu before the first integration ended\n",
+				(unsigned long)veml6030_model.reads, (unsigned long)veml6030_model.empty);
+	}
+}
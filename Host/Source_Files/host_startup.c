@@ -0,0 +1,419 @@
+/**
+ * @file host_startup.c
+ * @author James Brennan
+ * @date October 16th, 2026
+ * @brief Reset and vector table for the host build.
+ *
+ * @details
+ * Takes the place of the startup file: the peripheral models are opened
+ * before main() runs, and the interrupt handlers the firmware defines are
+ * collected into the table the engine dispatches from.
+ *
+ * main() is wrapped so that an EM4H wake-up can restart the firmware. The
+ * firmware's .data and .bss are renamed fw_data and fw_bss by the Makefile,
+ * so they can be put back to their load image as the startup file would.
+ *
+ */
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+
+//** Standard Libraries
+#include <setjmp.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+//** Silicon Lab include files
+#include "em_device.h"
+
+//** User/developer include files
+#include "host_bus.h"
+#include "host_energy.h"
+#include "host_engine.h"
+#include "host_models.h"
+#include "scheduler.h"
+#include "work_queue.h"
+#include "trace.h"
+#include "sleep_routines.h"
+#include "i2c.h"
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+
+// Rows of the Chrome trace, one per kind of activity
+#define HOST_TRACE_TID_IRQ			1
+#define HOST_TRACE_TID_MAIN			2
+#define HOST_TRACE_TID_SLEEP		3
+
+
+//***********************************************************************************
+// function prototypes
+//***********************************************************************************
+void TIMER0_IRQHandler(void)	__attribute__((weak, alias("host_default_handler")));
+void LDMA_IRQHandler(void)		__attribute__((weak, alias("host_default_handler")));
+void I2C0_IRQHandler(void)		__attribute__((weak, alias("host_default_handler")));
+void LEUART0_IRQHandler(void)	__attribute__((weak, alias("host_default_handler")));
+void LETIMER0_IRQHandler(void)	__attribute__((weak, alias("host_default_handler")));
+void I2C1_IRQHandler(void)		__attribute__((weak, alias("host_default_handler")));
+
+bool __real_check_scheduled_event(uint32_t event);
+bool __wrap_check_scheduled_event(uint32_t event);
+int __real_main(void);
+int __wrap_main(void);
+
+// Bounds of the firmware RAM, weak as a build may leave a section empty
+extern uint8_t __start_fw_data[] __attribute__((weak));
+extern uint8_t __stop_fw_data[] __attribute__((weak));
+extern uint8_t __start_fw_bss[] __attribute__((weak));
+extern uint8_t __stop_fw_bss[] __attribute__((weak));
+
+//***********************************************************************************
+// Private variables
+//***********************************************************************************
+static const char *event_names[SCHEDULER_EVENT_COUNT] = {
+#define HOST_EVENT_NAME(event, kind, handler, priority, budget)		[event] = #event,
+	SCHEDULER_EVENT_LIST(HOST_EVENT_NAME)
+#undef HOST_EVENT_NAME
+};
+
+static const char *owner_names[SLEEP_OWNER_COUNT] = {
+#define HOST_OWNER_NAME(owner)		[owner] = #owner,
+	SLEEP_OWNER_LIST(HOST_OWNER_NAME)
+#undef HOST_OWNER_NAME
+};
+
+// load image of the firmware's initialized data and the restart point in main
+static uint8_t *fw_data_image;
+static jmp_buf fw_reset;
+
+//***********************************************************************************
+// Private functions
+//***********************************************************************************
+
+/***************************************************************************//**
+ * @brief
+ *   Handler for interrupts the firmware enables without defining a handler
+ *
+ ******************************************************************************/
+
+static void host_default_handler(void){
+	fprintf(stderr, "[host] unhandled interrupt\n");
+	exit(EXIT_FAILURE);
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Writes the firmware trace ring as Chrome trace JSON
+ *
+ * @details
+ * 	 The file loads in chrome://tracing or Perfetto. Interrupt handlers,
+ * 	 scheduler handlers and sleep each get a row of spans, posts are
+ * 	 instants on the scheduler row and the energy mode blocks a counter.
+ * 	 RTCC timestamps are unwrapped from the first entry, so the time axis
+ * 	 starts at the oldest entry the ring still holds.
+ *
+ * @param[in] path
+ *   File to write, from PG_TRACE
+ *
+ ******************************************************************************/
+
+static void host_firmware_trace(const char *path){
+	TRACE_ENTRY *entries = malloc(TRACE_RING_SIZE * sizeof(TRACE_ENTRY));
+	uint32_t count;
+	uint64_t ticks = 0;
+	FILE *file;
+
+	if(entries == NULL || (file = fopen(path, "w")) == NULL){
+		fprintf(stderr, "[host] cannot write trace to %s\n", path);
+		free(entries);
+		return;
+	}
+
+	trace_stop();
+	count = trace_snapshot(entries, TRACE_RING_SIZE);
+
+	fprintf(file, "{\"traceEvents\":[\n");
+	fprintf(file, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"interrupts\"}},\n", HOST_TRACE_TID_IRQ);
+	fprintf(file, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"scheduler\"}},\n", HOST_TRACE_TID_MAIN);
+	fprintf(file, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"sleep\"}}", HOST_TRACE_TID_SLEEP);
+
+	for(uint32_t i = 0; i < count; i++){
+		TRACE_ENTRY *entry = &entries[i];
+		const char *event = (entry->source < SCHEDULER_EVENT_COUNT) ? event_names[entry->source] : "?";
+		double us;
+
+		if(i > 0){
+			ticks += (uint32_t)(entry->timestamp - entries[i - 1].timestamp);
+		}
+		us = 1e6 * ticks / RTCC_HZ;
+
+		switch(entry->id){
+			case TRACE_IRQ_ENTER:
+			case TRACE_IRQ_EXIT:
+				fprintf(file, ",\n{\"name\":\"%s\",\"ph\":\"%s\",\"ts\":%.1f,\"pid\":1,\"tid\":%d,\"args\":{\"flags\":%u}}",
+						host_irq_name(entry->source), (entry->id == TRACE_IRQ_ENTER) ? "B" : "E", us,
+						HOST_TRACE_TID_IRQ, (unsigned)entry->arg);
+				break;
+			case TRACE_HANDLER_BEGIN:
+			case TRACE_HANDLER_END:
+				fprintf(file, ",\n{\"name\":\"%s\",\"ph\":\"%s\",\"ts\":%.1f,\"pid\":1,\"tid\":%d}",
+						event, (entry->id == TRACE_HANDLER_BEGIN) ? "B" : "E", us, HOST_TRACE_TID_MAIN);
+				break;
+			case TRACE_POST:
+				fprintf(file, ",\n{\"name\":\"post %s\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%.1f,\"pid\":1,\"tid\":%d,\"args\":{\"payload\":%u}}",
+						event, us, HOST_TRACE_TID_MAIN, (unsigned)entry->arg);
+				break;
+			case TRACE_SLEEP:
+			case TRACE_WAKE:
+				fprintf(file, ",\n{\"name\":\"EM%u\",\"ph\":\"%s\",\"ts\":%.1f,\"pid\":1,\"tid\":%d}",
+						(unsigned)entry->source, (entry->id == TRACE_SLEEP) ? "B" : "E", us, HOST_TRACE_TID_SLEEP);
+				break;
+			case TRACE_BLOCK:
+			case TRACE_UNBLOCK:
+				fprintf(file, ",\n{\"name\":\"EM blocks\",\"ph\":\"C\",\"ts\":%.1f,\"pid\":1,\"args\":{\"EM%u\":%u}}",
+						us, (unsigned)entry->source, (unsigned)entry->arg);
+				break;
+			default:
+				break;
+		}
+	}
+	fprintf(file, "\n]}\n");
+	fclose(file);
+	free(entries);
+
+	fprintf(stderr, "[host]   %lu trace entries written to %s\n", (unsigned long)count, path);
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Opens the engine and the peripheral models ahead of main()
+ *
+ ******************************************************************************/
+
+static void __attribute__((constructor)) host_reset(void){
+	host_energy_open();
+	host_engine_open();
+	host_bus_open();
+
+	// the I2C models report their request lines to it as they open
+	host_ldma_model_open(LDMA_IRQn);
+	host_i2c_model_open(I2C0, I2C0_IRQn, cmuClock_I2C0);
+	host_i2c_model_open(I2C1, I2C1_IRQn, cmuClock_I2C1);
+	host_leuart_model_open(LEUART0, LEUART0_IRQn, cmuClock_LEUART0);
+	host_letimer_model_open(LETIMER0, LETIMER0_IRQn, cmuClock_LETIMER0);
+	host_timer_model_open(TIMER0, TIMER0_IRQn, cmuClock_TIMER0);
+	host_rtcc_model_open(RTCC, cmuClock_RTCC);
+	host_sensors_open();
+}
+
+//***********************************************************************************
+// Global variables
+//***********************************************************************************
+
+void (* const host_vector_table[HOST_IRQ_COUNT])(void) = {
+	[TIMER0_IRQn]	= TIMER0_IRQHandler,
+	[LDMA_IRQn]		= LDMA_IRQHandler,
+	[I2C0_IRQn]		= I2C0_IRQHandler,
+	[LEUART0_IRQn]	= LEUART0_IRQHandler,
+	[LETIMER0_IRQn]	= LETIMER0_IRQHandler,
+	[I2C1_IRQn]		= I2C1_IRQHandler,
+};
+
+//***********************************************************************************
+// Global functions
+//***********************************************************************************
+
+/***************************************************************************//**
+ * @brief
+ *   Keeps the load image of the firmware RAM and runs the firmware main()
+ *
+ * @details
+ * 	 host_warm_reset() returns here, puts the RAM back and calls main()
+ * 	 again, as the board does after an EM4H wake-up.
+ *
+ ******************************************************************************/
+
+int __wrap_main(void){
+	size_t size = __stop_fw_data - __start_fw_data;
+
+	fw_data_image = malloc(size ? size : 1);
+	if(fw_data_image == NULL){
+		perror("malloc");
+		exit(EXIT_FAILURE);
+	}
+	memcpy(fw_data_image, __start_fw_data, size);
+
+	if(setjmp(fw_reset)){
+		memcpy(__start_fw_data, fw_data_image, size);
+		memset(__start_fw_bss, 0, __stop_fw_bss - __start_fw_bss);
+	}
+	return __real_main();
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Restarts the firmware from main() with its RAM reset
+ *
+ * @details
+ * 	 Called on the EM4H wake-up, once the peripherals and the clock tree
+ * 	 have been reset. The firmware stack is dropped.
+ *
+ ******************************************************************************/
+
+void host_warm_reset(void){
+	longjmp(fw_reset, 1);
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Intercepts check_scheduled_event() to catch busy-waits on an event
+ *
+ * @details
+ * 	 A loop polling an event that has no handler only reads a variable, so
+ * 	 it never reaches a trapped register. A repeated call from the same place that
+ * 	 returns the same value with nothing having happened in between is a
+ * 	 spin, and virtual time is moved on to the next peripheral event.
+ *
+ ******************************************************************************/
+
+bool __wrap_check_scheduled_event(uint32_t event){
+	static void *last_caller;
+	static uint32_t last_epoch;
+	static bool last_value;
+	void *caller = __builtin_return_address(0);
+	bool value;
+
+	host_cpu_cycles(HOST_CALL_CYCLES);
+	host_irq_poll();
+	value = __real_check_scheduled_event(event);
+
+	if(caller == last_caller && host_activity_epoch() == last_epoch && value == last_value && !host_irq_active()){
+		host_spin();
+		value = __real_check_scheduled_event(event);
+	}
+
+	last_caller = caller;
+	last_epoch = host_activity_epoch();
+	last_value = value;
+	return value;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Adds the firmware's energy mode, work queue, I2C and scheduler event
+ *   counters to the end of run report
+ *
+ * @details
+ * 	 The firmware's own energy mode residency, timed with the RTCC, comes
+ * 	 first so it can be checked against the engine's figures above it. The
+ * 	 sleep block owners follow, with the time each held a block and the
+ * 	 blocks still held at the end of the run. Each kind of I2C transaction
+ * 	 has a line with its retries and its average and longest time on the bus.
+ * 	 Events are listed by name, from events.h. A pending time close to the LETIMER
+ * 	 period, or any coalesced posts, means the sample period is overrunning
+ * 	 the I2C and BLE work. Each event is followed by its latency histogram,
+ * 	 one column per bucket that was used, headed by the bound on the waits
+ * 	 it holds. If PG_TRACE names a file, the trace ring is written to it.
+ *
+ ******************************************************************************/
+
+void host_firmware_report(void){
+	const char *trace_path = getenv("PG_TRACE");
+	SCHEDULER_STATS stats[SCHEDULER_EVENT_COUNT];
+	WORK_QUEUE_STATS work;
+	SLEEP_STATS sleep;
+	SLEEP_OWNER_STATS owners[SLEEP_OWNER_COUNT];
+	I2C_STATS i2c[I2C_STATS_SIZE];
+	uint32_t i2c_used;
+	uint32_t i2c_untracked;
+	uint64_t total = 0;
+
+	sleep_stats_snapshot(&sleep);
+	for(int em = EM0; em < MAX_ENERGY_MODES; em++){
+		total += sleep.ticks[em];
+	}
+	for(int em = EM0; em < MAX_ENERGY_MODES; em++){
+		if(sleep.entries[em] == 0 && sleep.ticks[em] == 0){
+			continue;
+		}
+		fprintf(stderr, "[host]   firmware EM%d %10.6f s %6.2f %% %10lu entries\n", em,
+				(double)sleep.ticks[em] / RTCC_HZ, total ? 100.0 * sleep.ticks[em] / total : 0.0,
+				(unsigned long)sleep.entries[em]);
+	}
+
+	sleep_owner_snapshot(owners);
+	for(int i = 0; i < SLEEP_OWNER_COUNT; i++){
+		fprintf(stderr, "[host]   %-26s %10.6f s blocking %6lu blocks %6lu unbalanced, holds", owner_names[i],
+				(double)owners[i].ticks / RTCC_HZ, (unsigned long)owners[i].block_calls,
+				(unsigned long)owners[i].unbalanced);
+		bool held = false;
+		for(int em = EM0; em < MAX_ENERGY_MODES; em++){
+			if(owners[i].blocks[em] != 0){
+				fprintf(stderr, " EM%d:%lu", em, (unsigned long)owners[i].blocks[em]);
+				held = true;
+			}
+		}
+		fprintf(stderr, held ? "\n" : " none\n");
+	}
+
+	work_queue_stats(&work);
+	fprintf(stderr, "[host]   %-26s %6lu submitted %6lu dropped %6lu max depth\n", "work queue",
+			(unsigned long)work.submitted, (unsigned long)work.dropped, (unsigned long)work.max_depth);
+
+	i2c_used = i2c_stats_snapshot(i2c, &i2c_untracked);
+	for(uint32_t i = 0; i < i2c_used; i++){
+		char name[32];
+
+		if(i2c[i].command == I2C_STATS_NO_COMMAND){
+			snprintf(name, sizeof(name), "I2C%u 0x%02x read", (unsigned)i2c[i].bus, (unsigned)i2c[i].address);
+		}
+		else{
+			snprintf(name, sizeof(name), "I2C%u 0x%02x cmd 0x%02x", (unsigned)i2c[i].bus, (unsigned)i2c[i].address,
+					(unsigned)i2c[i].command);
+		}
+		fprintf(stderr, "[host]   %-26s %6lu done %6lu failed %6lu nack %6lu error retries %8lu bytes %8.3f ms avg %8.3f ms max\n",
+				name, (unsigned long)i2c[i].count, (unsigned long)i2c[i].failed,
+				(unsigned long)i2c[i].nack_retries, (unsigned long)i2c[i].error_retries, (unsigned long)i2c[i].bytes,
+				i2c[i].count ? 1000.0 * i2c[i].ticks / i2c[i].count / RTCC_HZ : 0.0, 1000.0 * i2c[i].max_ticks / RTCC_HZ);
+	}
+	if(i2c_untracked != 0){
+		fprintf(stderr, "[host]   %-26s %6lu untracked\n", "I2C", (unsigned long)i2c_untracked);
+	}
+
+	scheduler_stats_snapshot(stats);
+	for(int i = 0; i < SCHEDULER_EVENT_COUNT; i++){
+		if(stats[i].posted == 0 && stats[i].dispatched == 0){
+			continue;
+		}
+		fprintf(stderr, "[host]   %-26s %6lu posted %6lu coalesced %6lu dropped %8lu dispatched %10.3f ms max pending\n",
+				event_names[i], (unsigned long)stats[i].posted, (unsigned long)stats[i].coalesced,
+				(unsigned long)stats[i].dropped, (unsigned long)stats[i].dispatched,
+				1000.0 * stats[i].max_pending / RTCC_HZ);
+		if(stats[i].dispatched == 0){
+			continue;
+		}
+		fprintf(stderr, "[host]     %10.3f ms max run, latency", 1000.0 * stats[i].max_run / RTCC_HZ);
+		for(int bucket = 0; bucket < SCHEDULER_LATENCY_BUCKETS; bucket++){
+			if(stats[i].latency[bucket] == 0){
+				continue;
+			}
+			// a wait of n whole ticks is shorter than n + 1 ticks
+			if(bucket == SCHEDULER_LATENCY_BUCKETS - 1){
+				fprintf(stderr, " >=%.0fus:%lu", 1e6 * (1UL << (bucket - 1)) / RTCC_HZ,
+						(unsigned long)stats[i].latency[bucket]);
+			}
+			else{
+				fprintf(stderr, " <%.0fus:%lu", 1e6 * (1UL << bucket) / RTCC_HZ,
+						(unsigned long)stats[i].latency[bucket]);
+			}
+		}
+		fprintf(stderr, "\n");
+	}
+
+	if(trace_path != NULL){
+		host_firmware_trace(trace_path);
+	}
+}
@@ -0,0 +1,286 @@
+/**
+ * @file host_timer.c
+ * @author James Brennan
+ * @date October 16th, 2026
+ * @brief TIMER model for the host build.
+ *
+ * @details
+ * Up and down counting with TOP, the prescaler and one-shot mode, which is
+ * what HW_delay.c uses. As with the LETIMER model the counter value is
+ * derived from time, with events only where the firmware can observe a
+ * change worth waiting for: the counter reaching its end value and the
+ * wrap that follows one count later.
+ *
+ */
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+
+//** Standard Libraries
+#include <string.h>
+
+//** Silicon Lab include files
+#include "em_assert.h"
+#include "em_timer.h"
+
+//** User/developer include files
+#include "host_bus.h"
+#include "host_engine.h"
+#include "host_models.h"
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+#define HOST_TIMER_IF_MASK			0x00000FF3UL
+
+typedef struct {
+	volatile void		*regs;			// model view of the register block
+	IRQn_Type			irq;			// interrupt line
+	CMU_Clock_TypeDef	clock;			// peripheral clock
+	HOST_EVENT			event;			// counter reaches its end value or wraps
+	bool				running;		// counter is counting
+	uint32_t			cnt;			// counter value at sync_time
+	HOST_TIME			sync_time;		// tick boundary the counter value belongs to
+} HOST_TIMER_MODEL;
+
+//***********************************************************************************
+// Private variables
+//***********************************************************************************
+static HOST_TIMER_MODEL timer0_model;
+
+//***********************************************************************************
+// Private functions
+//***********************************************************************************
+
+/***************************************************************************//**
+ * @brief
+ *   Returns true if the counter counts down
+ *
+ ******************************************************************************/
+
+static bool host_timer_down(HOST_TIMER_MODEL *model){
+	return (HOST_REG(model->regs, TIMER_TypeDef, CTRL) & _TIMER_CTRL_MODE_MASK) == timerModeDown;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Prescaler division factor
+ *
+ ******************************************************************************/
+
+static uint32_t host_timer_div(HOST_TIMER_MODEL *model){
+	return 1UL << ((HOST_REG(model->regs, TIMER_TypeDef, CTRL) & _TIMER_CTRL_PRESC_MASK) >> _TIMER_CTRL_PRESC_SHIFT);
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Counts a number of ticks, handling wraps
+ *
+ * @details
+ * 	 Counting down past zero sets UF and reloads TOP, counting up past TOP
+ * 	 sets OF and restarts from zero. In one-shot mode the wrap stops the
+ * 	 counter.
+ *
+ ******************************************************************************/
+
+static void host_timer_count(HOST_TIMER_MODEL *model, uint64_t ticks){
+	uint32_t top = HOST_REG(model->regs, TIMER_TypeDef, TOP) & _TIMER_CNT_MASK;
+	bool one_shot = HOST_REG(model->regs, TIMER_TypeDef, CTRL) & TIMER_CTRL_OSMEN;
+
+	while(ticks > 0 && model->running){
+		if(host_timer_down(model)){
+			if(ticks <= model->cnt){
+				model->cnt -= (uint32_t)ticks;
+				return;
+			}
+			ticks -= model->cnt + 1;
+			model->cnt = top;
+			HOST_REG(model->regs, TIMER_TypeDef, IF) |= TIMER_IF_UF;
+		}
+		else{
+			if(model->cnt <= top && ticks <= top - model->cnt){
+				model->cnt += (uint32_t)ticks;
+				return;
+			}
+			ticks -= model->cnt <= top ? top - model->cnt + 1 : 1;
+			model->cnt = 0;
+			HOST_REG(model->regs, TIMER_TypeDef, IF) |= TIMER_IF_OF;
+		}
+		if(one_shot){
+			model->running = false;
+		}
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Brings the counter up to the current time
+ *
+ ******************************************************************************/
+
+static void host_timer_sync(HOST_TIMER_MODEL *model){
+	uint32_t hz = host_cmu_freq(model->clock);
+	uint32_t div = host_timer_div(model);
+	uint64_t ticks;
+
+	if(model->running && hz != 0){
+		ticks = host_time_to_ticks(host_now() - model->sync_time, hz, div);
+		model->sync_time += host_ticks_to_time(ticks, hz, div);
+		host_timer_count(model, ticks);
+	}
+	else{
+		model->sync_time = host_now();
+	}
+	HOST_REG(model->regs, TIMER_TypeDef, CNT) = model->cnt;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Recomputes STATUS, the interrupt line and the next event
+ *
+ ******************************************************************************/
+
+static void host_timer_update(HOST_TIMER_MODEL *model){
+	uint32_t hz = host_cmu_freq(model->clock);
+	uint32_t top = HOST_REG(model->regs, TIMER_TypeDef, TOP) & _TIMER_CNT_MASK;
+	uint64_t ticks;
+
+	HOST_REG(model->regs, TIMER_TypeDef, STATUS) = model->running ? TIMER_STATUS_RUNNING : 0;
+	HOST_REG(model->regs, TIMER_TypeDef, IF) &= HOST_TIMER_IF_MASK;
+	host_irq_set(model->irq, (HOST_REG(model->regs, TIMER_TypeDef, IF) &
+			HOST_REG(model->regs, TIMER_TypeDef, IEN) & HOST_TIMER_IF_MASK) != 0);
+
+	if(!model->running || hz == 0){
+		host_event_cancel(&model->event);
+		return;
+	}
+
+	if(host_timer_down(model)){
+		ticks = model->cnt > 0 ? model->cnt : 1;
+	}
+	else{
+		ticks = model->cnt < top ? top - model->cnt : 1;
+	}
+	host_event_schedule(&model->event, model->sync_time + host_ticks_to_time(ticks, hz, host_timer_div(model)));
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Counter reaches its end value or wraps
+ *
+ ******************************************************************************/
+
+static void host_timer_event(HOST_EVENT *event){
+	HOST_TIMER_MODEL *model = event->ctx;
+
+	host_timer_sync(model);
+	host_timer_update(model);
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Returns the peripheral to its reset state for an EM4H entry
+ *
+ ******************************************************************************/
+
+static void host_timer_reset(HOST_TIMER_MODEL *model){
+	model->running = false;
+	model->cnt = 0;
+	model->sync_time = host_now();
+	memset((void *)model->regs, 0, sizeof(TIMER_TypeDef));
+	host_timer_update(model);
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Register access hook
+ *
+ ******************************************************************************/
+
+static void host_timer_access(void *ctx, uint32_t offset, HOST_ACCESS access){
+	HOST_TIMER_MODEL *model = ctx;
+	uint32_t value;
+
+	if(access == HOST_ACCESS_RESET){
+		host_timer_reset(model);
+		return;
+	}
+	if(access == HOST_ACCESS_PREREAD){
+		if(offset == HOST_OFFSET(TIMER_TypeDef, CNT)){
+			host_timer_sync(model);
+		}
+		return;
+	}
+	if(access == HOST_ACCESS_READ){
+		return;
+	}
+
+	// the written value is taken before the counter sync rewrites CNT
+	value = *(volatile uint32_t *)((volatile uint8_t *)model->regs + offset);
+	host_timer_sync(model);
+	switch(offset){
+		case HOST_OFFSET(TIMER_TypeDef, CMD):
+			HOST_REG(model->regs, TIMER_TypeDef, CMD) = 0;
+			if(value & TIMER_CMD_STOP){
+				model->running = false;
+			}
+			else if((value & TIMER_CMD_START) && !model->running){
+				model->running = true;
+				model->sync_time = host_now();
+			}
+			break;
+		case HOST_OFFSET(TIMER_TypeDef, CNT):
+			model->cnt = value & _TIMER_CNT_MASK;
+			HOST_REG(model->regs, TIMER_TypeDef, CNT) = model->cnt;
+			break;
+		case HOST_OFFSET(TIMER_TypeDef, IFS):
+			HOST_REG(model->regs, TIMER_TypeDef, IF) |= value;
+			HOST_REG(model->regs, TIMER_TypeDef, IFS) = 0;
+			break;
+		case HOST_OFFSET(TIMER_TypeDef, IFC):
+			HOST_REG(model->regs, TIMER_TypeDef, IF) &= ~value;
+			HOST_REG(model->regs, TIMER_TypeDef, IFC) = 0;
+			break;
+		case HOST_OFFSET(TIMER_TypeDef, IEN):
+			HOST_REG(model->regs, TIMER_TypeDef, IEN) &= HOST_TIMER_IF_MASK;
+			break;
+		default:
+			break;
+	}
+	host_timer_update(model);
+}
+
+//***********************************************************************************
+// Global functions
+//***********************************************************************************
+
+/***************************************************************************//**
+ * @brief
+ *   Opens the TIMER model
+ *
+ * @param[in] timer
+ *   Base address of the TIMER peripheral
+ *
+ * @param[in] irq
+ *   Interrupt line of the peripheral
+ *
+ * @param[in] clock
+ *   Peripheral clock, divided by the prescaler
+ *
+ ******************************************************************************/
+
+void host_timer_model_open(TIMER_TypeDef *timer, IRQn_Type irq, CMU_Clock_TypeDef clock){
+	HOST_TIMER_MODEL *model = &timer0_model;
+
+	EFM_ASSERT(timer == TIMER0);
+
+	model->regs = host_bus_alias((uint32_t)(uintptr_t)timer);
+	model->irq = irq;
+	model->clock = clock;
+	host_event_init(&model->event, "TIMER0", host_cmu_lowest_em(clock), host_timer_event, model);
+
+	HOST_REG(model->regs, TIMER_TypeDef, TOP) = _TIMER_TOP_RESETVALUE;
+	host_bus_attach((uint32_t)(uintptr_t)timer, sizeof(TIMER_TypeDef), clock, host_timer_access, model);
+	host_timer_update(model);
+}
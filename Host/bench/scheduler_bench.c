@@ -0,0 +1,242 @@
+/**
+ * @file scheduler_bench.c
+ * @author James Brennan
+ * @date October 16th, 2026
+ * @brief Stress benchmark of the lock-free scheduler and sleep paths.
+ *
+ * @details
+ * Links the firmware scheduler.c and sleep_routines.c on their own, without
+ * the engine, and runs add_scheduled_event(), remove_scheduled_event() and
+ * sleep_block_mode() / sleep_unblock_mode() from several threads at once.
+ * Each thread owns a set of events spread over the bitmap, so every bitmap
+ * word and the summary word are shared, but none of its posts may be lost,
+ * coalesced or seen by another thread. Threads share the sleep block owners,
+ * so the owners' counts are contended too. Any lost update shows up as an error
+ * and the benchmark fails.
+ *
+ * Run with make -C Host bench, or build/scheduler_bench [threads] [iterations].
+ *
+ */
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+
+//** Standard Libraries
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+//** Silicon Lab include files
+#include "em_core.h"
+#include "em_emu.h"
+
+//** User/developer include files
+#include "scheduler.h"
+#include "sleep_routines.h"
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+#define BENCH_THREADS			4
+#define BENCH_ITERATIONS		2000000UL
+
+typedef struct {
+	pthread_t		thread;
+	uint32_t		first;			// first event owned, the others follow every threads IDs
+	uint32_t		threads;		// stride between owned events
+	unsigned long	iterations;		// add/remove pairs to run
+	unsigned long	errors;			// own bit found in the wrong state
+} BENCH_WORKER;
+
+//***********************************************************************************
+// Global variables
+//***********************************************************************************
+
+// No handlers, scheduler_dispatch() is never called
+const SCHEDULER_EVENT_ENTRY scheduler_event_table[SCHEDULER_EVENT_COUNT];
+
+//***********************************************************************************
+// Private functions
+//***********************************************************************************
+
+/***************************************************************************//**
+ * @brief
+ *   Posts and clears the worker's events, checking each step
+ *
+ ******************************************************************************/
+
+static void *bench_worker(void *ctx){
+	BENCH_WORKER *worker = ctx;
+	uint32_t event = worker->first;
+	SLEEP_OWNER owner = worker->first % SLEEP_OWNER_COUNT;
+
+	for(unsigned long i = 0; i < worker->iterations; i++){
+		sleep_block_mode(EM2, owner);
+		add_scheduled_event(event);
+		if(!check_scheduled_event(event)){
+			worker->errors++;
+		}
+		remove_scheduled_event(event);
+		if(check_scheduled_event(event)){
+			worker->errors++;
+		}
+		sleep_unblock_mode(EM2, owner);
+
+		event += worker->threads;
+		if(event >= SCHEDULER_EVENT_COUNT){
+			event = worker->first;
+		}
+	}
+	return NULL;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Runs one round with the given number of threads
+ *
+ * @return
+ *   Number of errors found, by the workers or in the final state
+ *
+ ******************************************************************************/
+
+static unsigned long bench_round(uint32_t threads, unsigned long iterations){
+	BENCH_WORKER workers[SCHEDULER_EVENT_COUNT];
+	SCHEDULER_STATS stats[SCHEDULER_EVENT_COUNT];
+	SLEEP_OWNER_STATS owners[SLEEP_OWNER_COUNT];
+	struct timespec start, end;
+	unsigned long errors = 0;
+	uint64_t posted = 0;
+	uint64_t coalesced = 0;
+	double seconds;
+
+	scheduler_open();
+	sleep_open();
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for(uint32_t t = 0; t < threads; t++){
+		workers[t] = (BENCH_WORKER){ .first = t, .threads = threads, .iterations = iterations };
+		if(pthread_create(&workers[t].thread, NULL, bench_worker, &workers[t]) != 0){
+			perror("pthread_create");
+			exit(EXIT_FAILURE);
+		}
+	}
+	for(uint32_t t = 0; t < threads; t++){
+		pthread_join(workers[t].thread, NULL);
+		errors += workers[t].errors;
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	seconds = (end.tv_sec - start.tv_sec) + 1e-9 * (end.tv_nsec - start.tv_nsec);
+
+	scheduler_stats_snapshot(stats);
+	for(int i = 0; i < SCHEDULER_EVENT_COUNT; i++){
+		posted += stats[i].posted;
+		coalesced += stats[i].coalesced;
+	}
+	if(posted != (uint64_t)threads * iterations){
+		fprintf(stderr, "[bench] %llu posts counted, %llu made\n",
+				(unsigned long long)posted, (unsigned long long)threads * iterations);
+		errors++;
+	}
+	if(coalesced != 0){
+		fprintf(stderr, "[bench] %llu posts coalesced\n", (unsigned long long)coalesced);
+		errors++;
+	}
+	if(scheduler_pending()){
+		fprintf(stderr, "[bench] events left pending\n");
+		errors++;
+	}
+	if(current_block_energy_mode() != MAX_ENERGY_MODES - 1 || sleep_blocked_modes() != 0){
+		fprintf(stderr, "[bench] EM%lu left blocked\n", (unsigned long)current_block_energy_mode());
+		errors++;
+	}
+	sleep_owner_snapshot(owners);
+	for(int i = 0; i < SLEEP_OWNER_COUNT; i++){
+		if(owners[i].blocks[EM2] != 0 || owners[i].unbalanced != 0){
+			fprintf(stderr, "[bench] owner %d left %lu blocks, %lu unbalanced\n", i,
+					(unsigned long)owners[i].blocks[EM2], (unsigned long)owners[i].unbalanced);
+			errors++;
+		}
+	}
+
+	printf("[bench] %2u threads %10lu iterations %8.3f s %8.1f ns/iteration %8.2f M iterations/s %lu errors\n",
+			(unsigned)threads, iterations, seconds, 1e9 * seconds / iterations,
+			threads * iterations / seconds / 1e6, errors);
+	return errors;
+}
+
+//***********************************************************************************
+// Global functions
+//***********************************************************************************
+
+/***************************************************************************//**
+ * @brief
+ *   Stand-ins for the calls the scheduler makes outside the measured paths
+ *
+ * @details
+ * 	 Critical sections are only entered by scheduler_open() and the stats
+ * 	 snapshot, which run while no worker does. Timestamps and trace entries
+ * 	 are not measured.
+ *
+ ******************************************************************************/
+
+uint32_t rtcc_timestamp(void){
+	return 0;
+}
+
+void trace_write(uint32_t id, uint32_t source, uint32_t arg){
+	(void)id;
+	(void)source;
+	(void)arg;
+}
+
+CORE_irqState_t CORE_EnterCritical(void){
+	return 0;
+}
+
+void CORE_ExitCritical(CORE_irqState_t irqState){
+	(void)irqState;
+}
+
+bool CORE_InIrqContext(void){
+	return false;
+}
+
+bool CORE_IrqIsDisabled(void){
+	return false;
+}
+
+void EMU_EnterEM1(void){
+}
+
+void EMU_EnterEM2(bool restore){
+	(void)restore;
+}
+
+void EMU_EnterEM3(bool restore){
+	(void)restore;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Runs a single thread round as the reference, then the contended round
+ *
+ ******************************************************************************/
+
+int main(int argc, char **argv){
+	uint32_t threads = (argc > 1) ? strtoul(argv[1], NULL, 0) : BENCH_THREADS;
+	unsigned long iterations = (argc > 2) ? strtoul(argv[2], NULL, 0) : BENCH_ITERATIONS;
+	unsigned long errors = 0;
+
+	if(threads < 1 || threads > SCHEDULER_EVENT_COUNT || iterations < 1){
+		fprintf(stderr, "usage: %s [threads 1-%d] [iterations]\n", argv[0], SCHEDULER_EVENT_COUNT);
+		return EXIT_FAILURE;
+	}
+
+	errors += bench_round(1, iterations);
+	if(threads > 1){
+		errors += bench_round(threads, iterations);
+	}
+	return (errors == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
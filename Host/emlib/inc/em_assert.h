@@ -0,0 +1,32 @@
+/**
+ * @file em_assert.h
+ * @author James Brennan
+ * @date October 16th, 2026
+ * @brief Host stand-in for the emlib assert module. As on the board, asserts
+ * are only live when DEBUG_EFM is defined; they then report the virtual time
+ * at which they fired.
+ *
+ */
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#ifndef	EM_ASSERT_HG
+#define	EM_ASSERT_HG
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+
+#if defined(DEBUG_EFM) || defined(DEBUG_EFM_USER)
+#define EFM_ASSERT(expr)	((expr) ? ((void)0) : assertEFM(__FILE__, __LINE__))
+#else
+#define EFM_ASSERT(expr)	((void)(expr))
+#endif
+
+//***********************************************************************************
+// function prototypes
+//***********************************************************************************
+void assertEFM(const char *file, int line);
+
+#endif
@@ -0,0 +1,24 @@
+/**
+ * @file em_chip.h
+ * @author James Brennan
+ * @date October 16th, 2026
+ * @brief Host stand-in for the emlib chip errata module.
+ *
+ */
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#ifndef	EM_CHIP_HG
+#define	EM_CHIP_HG
+
+#include "em_device.h"
+
+//***********************************************************************************
+// function prototypes
+//***********************************************************************************
+
+/* There is no silicon errata to apply on the host */
+static inline void CHIP_Init(void) {}
+
+#endif
@@ -0,0 +1,93 @@
+/**
+ * @file em_cmu.h
+ * @author James Brennan
+ * @date October 16th, 2026
+ * @brief Host stand-in for the emlib CMU module. The clock tree is kept as
+ * plain state that the peripheral models read to derive their bit, baud and
+ * tick rates.
+ *
+ */
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#ifndef	EM_CMU_HG
+#define	EM_CMU_HG
+
+#include "em_device.h"
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+typedef enum {
+	cmuClock_HF,
+	cmuClock_HFPER,
+	cmuClock_CORELE,
+	cmuClock_LFA,
+	cmuClock_LFB,
+	cmuClock_LFE,
+	cmuClock_GPIO,
+	cmuClock_TIMER0,
+	cmuClock_I2C0,
+	cmuClock_I2C1,
+	cmuClock_LETIMER0,
+	cmuClock_LEUART0,
+	cmuClock_RTCC,
+	cmuClock_LDMA,
+	cmuClock_COUNT
+} CMU_Clock_TypeDef;
+
+typedef enum {
+	cmuOsc_LFXO,
+	cmuOsc_LFRCO,
+	cmuOsc_HFXO,
+	cmuOsc_HFRCO,
+	cmuOsc_ULFRCO,
+	cmuOsc_COUNT
+} CMU_Osc_TypeDef;
+
+typedef enum {
+	cmuSelect_Disabled,
+	cmuSelect_LFXO,
+	cmuSelect_LFRCO,
+	cmuSelect_HFXO,
+	cmuSelect_HFRCO,
+	cmuSelect_ULFRCO
+} CMU_Select_TypeDef;
+
+/* HFRCO bands carry their frequency in Hz, as they do in emlib */
+typedef enum {
+	cmuHFRCOFreq_1M0Hz		= 1000000U,
+	cmuHFRCOFreq_4M0Hz		= 4000000U,
+	cmuHFRCOFreq_19M0Hz		= 19000000U,
+	cmuHFRCOFreq_26M0Hz		= 26000000U,
+	cmuHFRCOFreq_32M0Hz		= 32000000U,
+	cmuHFRCOFreq_38M0Hz		= 38000000U
+} CMU_HFRCOFreq_TypeDef;
+
+typedef struct {
+	bool		lowPowerMode;		// run the HFXO in low power mode
+	uint16_t	ctuneStartup;		// tuning capacitance during startup
+	uint16_t	ctuneSteadyState;	// tuning capacitance in steady state
+} CMU_HFXOInit_TypeDef;
+
+#define CMU_HFXOINIT_DEFAULT	{ false, 0x142, 0x142 }
+
+#define CMU_LFXO_HZ				32768U
+#define CMU_LFRCO_HZ			32768U
+#define CMU_ULFRCO_HZ			1000U
+#define CMU_HFXO_HZ				38400000U
+
+//***********************************************************************************
+// function prototypes
+//***********************************************************************************
+void CMU_HFXOInit(const CMU_HFXOInit_TypeDef *hfxoInit);
+void CMU_HFRCOBandSet(CMU_HFRCOFreq_TypeDef setFreq);
+void CMU_OscillatorEnable(CMU_Osc_TypeDef osc, bool enable, bool wait);
+void CMU_ClockSelectSet(CMU_Clock_TypeDef clock, CMU_Select_TypeDef ref);
+CMU_Select_TypeDef CMU_ClockSelectGet(CMU_Clock_TypeDef clock);
+void CMU_ClockEnable(CMU_Clock_TypeDef clock, bool enable);
+bool CMU_ClockEnabled(CMU_Clock_TypeDef clock);
+uint32_t CMU_ClockFreqGet(CMU_Clock_TypeDef clock);
+
+#endif
@@ -0,0 +1,40 @@
+/**
+ * @file em_core.h
+ * @author James Brennan
+ * @date October 16th, 2026
+ * @brief Host stand-in for the emlib CORE module. PRIMASK is modeled by the
+ * host interrupt controller, so critical sections defer interrupt delivery
+ * exactly like they do on the Cortex-M4.
+ *
+ */
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#ifndef	EM_CORE_HG
+#define	EM_CORE_HG
+
+#include "em_device.h"
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+typedef uint32_t CORE_irqState_t;
+
+#define CORE_DECLARE_IRQ_STATE		CORE_irqState_t irqState
+#define CORE_ENTER_CRITICAL()		irqState = CORE_EnterCritical()
+#define CORE_EXIT_CRITICAL()		CORE_ExitCritical(irqState)
+#define CORE_ENTER_ATOMIC()			irqState = CORE_EnterAtomic()
+#define CORE_EXIT_ATOMIC()			CORE_ExitAtomic(irqState)
+
+//***********************************************************************************
+// function prototypes
+//***********************************************************************************
+CORE_irqState_t CORE_EnterCritical(void);
+void CORE_ExitCritical(CORE_irqState_t irqState);
+CORE_irqState_t CORE_EnterAtomic(void);
+void CORE_ExitAtomic(CORE_irqState_t irqState);
+bool CORE_InIrqContext(void);
+bool CORE_IrqIsDisabled(void);
+
+#endif
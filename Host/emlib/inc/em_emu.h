@@ -0,0 +1,82 @@
+/**
+ * @file em_emu.h
+ * @author James Brennan
+ * @date October 16th, 2026
+ * @brief Host stand-in for the emlib EMU module. Entering an energy mode hands
+ * control to the virtual-time engine, which runs the peripheral models forward
+ * until an enabled interrupt is pending.
+ *
+ */
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#ifndef	EM_EMU_HG
+#define	EM_EMU_HG
+
+#include "em_device.h"
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+typedef enum {
+	emuDcdcMode_Bypass,
+	emuDcdcMode_LowNoise,
+	emuDcdcMode_LowPower
+} EMU_DcdcMode_TypeDef;
+
+typedef enum {
+	emuVScaleEM23_FastWakeup,
+	emuVScaleEM23_LowPower
+} EMU_VScaleEM23_TypeDef;
+
+typedef struct {
+	EMU_DcdcMode_TypeDef	dcdcMode;			// DCDC regulator operating mode
+	uint16_t				mVout;				// target output voltage in mV
+	uint16_t				em01LoadCurrent_mA;	// estimated EM0/EM1 load current
+	uint16_t				em234LoadCurrent_uA;	// estimated EM2/EM3/EM4 load current
+} EMU_DCDCInit_TypeDef;
+
+#define EMU_DCDCINIT_DEFAULT	{ emuDcdcMode_LowNoise, 1800, 5, 10 }
+
+typedef struct {
+	bool					em23VregFullEn;		// keep the regulator in full drive in EM2/EM3
+	EMU_VScaleEM23_TypeDef	vScaleEM23Voltage;	// voltage scaling applied in EM2/EM3
+} EMU_EM23Init_TypeDef;
+
+#define EMU_EM23INIT_DEFAULT	{ false, emuVScaleEM23_FastWakeup }
+
+typedef enum {
+	emuEM4Shutoff,
+	emuEM4Hibernate
+} EMU_EM4State_TypeDef;
+
+typedef enum {
+	emuPinRetentionDisable,
+	emuPinRetentionEm4Exit,
+	emuPinRetentionLatch
+} EMU_EM4PinRetention_TypeDef;
+
+typedef struct {
+	EMU_EM4State_TypeDef		em4State;			// EM4H or EM4S
+	bool						retainLfrco;		// keep the LFRCO running in EM4H
+	bool						retainLfxo;			// keep the LFXO running in EM4H
+	bool						retainUlfrco;		// keep the ULFRCO running in EM4S
+	EMU_EM4PinRetention_TypeDef	pinRetentionMode;	// GPIO state held through EM4
+} EMU_EM4Init_TypeDef;
+
+#define EMU_EM4INIT_DEFAULT	{ emuEM4Shutoff, false, false, false, emuPinRetentionDisable }
+
+//***********************************************************************************
+// function prototypes
+//***********************************************************************************
+bool EMU_DCDCInit(const EMU_DCDCInit_TypeDef *dcdcInit);
+void EMU_EM23Init(const EMU_EM23Init_TypeDef *em23Init);
+void EMU_EnterEM1(void);
+void EMU_EnterEM2(bool restore);
+void EMU_EnterEM3(bool restore);
+void EMU_EM4Init(const EMU_EM4Init_TypeDef *em4Init);
+void EMU_EnterEM4H(void);
+void EMU_UnlatchPinRetention(void);
+
+#endif
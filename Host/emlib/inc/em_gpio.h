@@ -0,0 +1,56 @@
+/**
+ * @file em_gpio.h
+ * @author James Brennan
+ * @date October 16th, 2026
+ * @brief Host stand-in for the emlib GPIO module. Pin modes and output levels
+ * are recorded so the host can report LED and sensor-enable state.
+ *
+ */
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#ifndef	EM_GPIO_HG
+#define	EM_GPIO_HG
+
+#include "em_device.h"
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+typedef enum {
+	gpioPortA,
+	gpioPortB,
+	gpioPortC,
+	gpioPortD,
+	gpioPortE,
+	gpioPortF,
+	GPIO_PORT_COUNT
+} GPIO_Port_TypeDef;
+
+#define GPIO_PIN_COUNT		16
+
+typedef enum {
+	gpioModeDisabled,
+	gpioModeInput,
+	gpioModeInputPull,
+	gpioModePushPull,
+	gpioModeWiredAnd,
+	gpioModeWiredAndPullUp
+} GPIO_Mode_TypeDef;
+
+typedef enum {
+	gpioDriveStrengthWeakAlternateWeak,
+	gpioDriveStrengthWeakAlternateStrong,
+	gpioDriveStrengthStrongAlternateWeak,
+	gpioDriveStrengthStrongAlternateStrong
+} GPIO_DriveStrength_TypeDef;
+
+//***********************************************************************************
+// function prototypes
+//***********************************************************************************
+void GPIO_PinModeSet(GPIO_Port_TypeDef port, unsigned int pin, GPIO_Mode_TypeDef mode, unsigned int out);
+void GPIO_DriveStrengthSet(GPIO_Port_TypeDef port, GPIO_DriveStrength_TypeDef strength);
+unsigned int GPIO_PinOutGet(GPIO_Port_TypeDef port, unsigned int pin);
+
+#endif
@@ -0,0 +1,51 @@
+/**
+ * @file em_i2c.h
+ * @author James Brennan
+ * @date October 16th, 2026
+ * @brief Host stand-in for the emlib I2C module.
+ *
+ */
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#ifndef	EM_I2C_HG
+#define	EM_I2C_HG
+
+#include "em_device.h"
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+#define I2C_FREQ_STANDARD_MAX		92000
+#define I2C_FREQ_FAST_MAX			392157
+#define I2C_FREQ_FASTPLUS_MAX		987167
+
+typedef enum {
+	i2cClockHLRStandard,		// Nlow = 4, Nhigh = 4
+	i2cClockHLRAsymetric,		// Nlow = 6, Nhigh = 3
+	i2cClockHLRFast				// Nlow = 11, Nhigh = 6
+} I2C_ClockHLR_TypeDef;
+
+typedef struct {
+	bool					enable;		// enable the peripheral when init completes
+	bool					master;		// master (true) or slave (false) mode
+	uint32_t				refFreq;	// reference clock, 0 selects the current HFPER clock
+	uint32_t				freq;		// (max) bus frequency
+	I2C_ClockHLR_TypeDef	clhr;		// clock low/high ratio
+} I2C_Init_TypeDef;
+
+#define I2C_INIT_DEFAULT	{ true, true, 0, I2C_FREQ_STANDARD_MAX, i2cClockHLRStandard }
+
+//***********************************************************************************
+// function prototypes
+//***********************************************************************************
+void I2C_Init(I2C_TypeDef *i2c, const I2C_Init_TypeDef *init);
+void I2C_BusFreqSet(I2C_TypeDef *i2c, uint32_t freqRef, uint32_t freqScl, I2C_ClockHLR_TypeDef i2cMode);
+uint32_t I2C_BusFreqGet(I2C_TypeDef *i2c);
+void I2C_Enable(I2C_TypeDef *i2c, bool enable);
+void I2C_IntClear(I2C_TypeDef *i2c, uint32_t flags);
+void I2C_IntEnable(I2C_TypeDef *i2c, uint32_t flags);
+void I2C_IntDisable(I2C_TypeDef *i2c, uint32_t flags);
+
+#endif
@@ -0,0 +1,18 @@
+/**
+ * @file em_int.h
+ * @author James Brennan
+ * @date October 16th, 2026
+ * @brief Host stand-in for the deprecated emlib INT module, kept because the
+ * firmware headers still include it.
+ *
+ */
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#ifndef	EM_INT_HG
+#define	EM_INT_HG
+
+#include "em_core.h"
+
+#endif
@@ -0,0 +1,170 @@
+/**
+ * @file em_ldma.h
+ * @author James Brennan
+ * @date October 17th, 2026
+ * @brief Host stand-in for the emlib LDMA module.
+ *
+ * @details
+ * Descriptors keep the emlib field names and macros. Their addresses are
+ * host pointers, which do not fit the 32-bit words of the device layout, so
+ * the address fields are pointer sized and a relative link counts whole
+ * descriptors, four words each as on the device.
+ *
+ */
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#ifndef	EM_LDMA_HG
+#define	EM_LDMA_HG
+
+#include "em_device.h"
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+
+typedef enum {
+	ldmaPeripheralSignal_NONE				= LDMA_CH_REQSEL_SOURCESEL_NONE,
+	ldmaPeripheralSignal_I2C0_RXDATAV		= LDMA_CH_REQSEL_SIGSEL_I2C0RXDATAV | LDMA_CH_REQSEL_SOURCESEL_I2C0,
+	ldmaPeripheralSignal_I2C0_TXBL			= LDMA_CH_REQSEL_SIGSEL_I2C0TXBL | LDMA_CH_REQSEL_SOURCESEL_I2C0,
+	ldmaPeripheralSignal_I2C1_RXDATAV		= LDMA_CH_REQSEL_SIGSEL_I2C1RXDATAV | LDMA_CH_REQSEL_SOURCESEL_I2C1,
+	ldmaPeripheralSignal_I2C1_TXBL			= LDMA_CH_REQSEL_SIGSEL_I2C1TXBL | LDMA_CH_REQSEL_SOURCESEL_I2C1
+} LDMA_PeripheralSignal_t;
+
+typedef enum {
+	ldmaCtrlStructTypeXfer,			// copy xferCnt + 1 units from src to dst
+	ldmaCtrlStructTypeSync,			// not modeled
+	ldmaCtrlStructTypeWrite			// write immVal to dstAddr
+} LDMA_CtrlStructType_t;
+
+typedef enum {
+	ldmaCtrlBlockSizeUnit1			= 0			// one unit per request, the only size modeled
+} LDMA_CtrlBlockSize_t;
+
+typedef enum {
+	ldmaCtrlReqModeBlock,
+	ldmaCtrlReqModeAll
+} LDMA_CtrlReqMode_t;
+
+typedef enum {
+	ldmaCtrlSrcIncOne,
+	ldmaCtrlSrcIncTwo,
+	ldmaCtrlSrcIncFour,
+	ldmaCtrlSrcIncNone
+} LDMA_CtrlSrcInc_t;
+
+typedef enum {
+	ldmaCtrlSizeByte,
+	ldmaCtrlSizeHalf,
+	ldmaCtrlSizeWord
+} LDMA_CtrlSize_t;
+
+typedef enum {
+	ldmaCtrlDstIncOne,
+	ldmaCtrlDstIncTwo,
+	ldmaCtrlDstIncFour,
+	ldmaCtrlDstIncNone
+} LDMA_CtrlDstInc_t;
+
+typedef enum {
+	ldmaLinkModeAbs,
+	ldmaLinkModeRel					// the only mode modeled
+} LDMA_LinkMode_t;
+
+typedef union {
+	struct {
+		uint32_t	structType	: 2;
+		uint32_t	reserved0	: 1;
+		uint32_t	structReq	: 1;		// start without waiting for the request
+		uint32_t	xferCnt		: 11;		// units to move, minus one
+		uint32_t	byteSwap	: 1;
+		uint32_t	blockSize	: 4;
+		uint32_t	doneIfs		: 1;		// set the channel's DONE flag when done
+		uint32_t	reqMode		: 1;
+		uint32_t	decLoopCnt	: 1;
+		uint32_t	ignoreSrec	: 1;
+		uint32_t	srcInc		: 2;
+		uint32_t	size		: 2;
+		uint32_t	dstInc		: 2;
+		uint32_t	srcAddrMode	: 1;
+		uint32_t	dstAddrMode	: 1;
+		uintptr_t	srcAddr;
+		uintptr_t	dstAddr;
+		uint32_t	linkMode	: 1;
+		uint32_t	link		: 1;		// load the descriptor linkAddr points to when done
+		int32_t		linkAddr	: 30;		// words from this descriptor
+	} xfer;
+	struct {
+		uint32_t	structType	: 2;
+		uint32_t	reserved0	: 1;
+		uint32_t	structReq	: 1;
+		uint32_t	xferCnt		: 11;
+		uint32_t	byteSwap	: 1;
+		uint32_t	blockSize	: 4;
+		uint32_t	doneIfs		: 1;
+		uint32_t	reqMode		: 1;
+		uint32_t	decLoopCnt	: 1;
+		uint32_t	ignoreSrec	: 1;
+		uint32_t	srcInc		: 2;
+		uint32_t	size		: 2;
+		uint32_t	dstInc		: 2;
+		uint32_t	srcAddrMode	: 1;
+		uint32_t	dstAddrMode	: 1;
+		uint32_t	immVal;
+		uintptr_t	dstAddr;
+		uint32_t	linkMode	: 1;
+		uint32_t	link		: 1;
+		int32_t		linkAddr	: 30;
+	} wri;
+} LDMA_Descriptor_t;
+
+typedef struct {
+	uint32_t	ldmaReqSel;			// LDMA_PeripheralSignal_t
+} LDMA_TransferCfg_t;
+
+typedef struct {
+	uint8_t		ldmaInitCtrlNumFixed;
+	uint8_t		ldmaInitIrqPriority;
+} LDMA_Init_t;
+
+#define LDMA_INIT_DEFAULT		{ 8, 3 }
+
+#define LDMA_TRANSFER_CFG_PERIPHERAL(signal)	{ .ldmaReqSel = (signal) }
+
+#define LDMA_DESCRIPTOR_BYTE(src, dest, count, srcinc, dstinc, linkjmp, dolink)	\
+	{ .xfer = { .structType = ldmaCtrlStructTypeXfer, .structReq = 0,			\
+		.xferCnt = (count) - 1, .blockSize = ldmaCtrlBlockSizeUnit1,			\
+		.doneIfs = 1, .reqMode = ldmaCtrlReqModeBlock, .srcInc = (srcinc),		\
+		.size = ldmaCtrlSizeByte, .dstInc = (dstinc),							\
+		.srcAddrMode = 0, .dstAddrMode = 0,										\
+		.srcAddr = (uintptr_t)(src), .dstAddr = (uintptr_t)(dest),				\
+		.linkMode = ldmaLinkModeRel, .link = (dolink), .linkAddr = (linkjmp) * 4 } }
+
+#define LDMA_DESCRIPTOR_WRITE(value, address, linkjmp, dolink)				\
+	{ .wri = { .structType = ldmaCtrlStructTypeWrite, .structReq = 1,			\
+		.doneIfs = 1, .immVal = (value), .dstAddr = (uintptr_t)(address),		\
+		.linkMode = ldmaLinkModeRel, .link = (dolink), .linkAddr = (linkjmp) * 4 } }
+
+#define LDMA_DESCRIPTOR_SINGLE_M2P_BYTE(src, dest, count)				\
+	LDMA_DESCRIPTOR_BYTE(src, dest, count, ldmaCtrlSrcIncOne, ldmaCtrlDstIncNone, 0, 0)
+#define LDMA_DESCRIPTOR_LINKREL_M2P_BYTE(src, dest, count, linkjmp)		\
+	LDMA_DESCRIPTOR_BYTE(src, dest, count, ldmaCtrlSrcIncOne, ldmaCtrlDstIncNone, linkjmp, 1)
+#define LDMA_DESCRIPTOR_SINGLE_P2M_BYTE(src, dest, count)				\
+	LDMA_DESCRIPTOR_BYTE(src, dest, count, ldmaCtrlSrcIncNone, ldmaCtrlDstIncOne, 0, 0)
+#define LDMA_DESCRIPTOR_LINKREL_P2M_BYTE(src, dest, count, linkjmp)		\
+	LDMA_DESCRIPTOR_BYTE(src, dest, count, ldmaCtrlSrcIncNone, ldmaCtrlDstIncOne, linkjmp, 1)
+#define LDMA_DESCRIPTOR_SINGLE_WRITE(value, address)					\
+	LDMA_DESCRIPTOR_WRITE(value, address, 0, 0)
+#define LDMA_DESCRIPTOR_LINKREL_WRITE(value, address, linkjmp)			\
+	LDMA_DESCRIPTOR_WRITE(value, address, linkjmp, 1)
+
+//***********************************************************************************
+// function prototypes
+//***********************************************************************************
+void LDMA_Init(const LDMA_Init_t *init);
+void LDMA_StartTransfer(int ch, const LDMA_TransferCfg_t *transfer, const LDMA_Descriptor_t *descriptor);
+void LDMA_StopTransfer(int ch);
+bool LDMA_TransferDone(int ch);
+
+#endif
@@ -0,0 +1,57 @@
+/**
+ * @file em_letimer.h
+ * @author James Brennan
+ * @date October 16th, 2026
+ * @brief Host stand-in for the emlib LETIMER module.
+ *
+ */
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#ifndef	EM_LETIMER_HG
+#define	EM_LETIMER_HG
+
+#include "em_device.h"
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+typedef enum {
+	letimerRepeatFree,
+	letimerRepeatOneshot,
+	letimerRepeatBuffered,
+	letimerRepeatDouble
+} LETIMER_RepeatMode_TypeDef;
+
+typedef enum {
+	letimerUFOANone,
+	letimerUFOAToggle,
+	letimerUFOAPulse,
+	letimerUFOAPwm
+} LETIMER_UFOA_TypeDef;
+
+typedef struct {
+	bool						enable;		// start counting when init completes
+	bool						debugRun;	// keep counting during debug halt
+	bool						comp0Top;	// load COMP0 into CNT on underflow
+	bool						bufTop;		// load COMP1 into COMP0 when REP0 reaches 0
+	uint8_t						out0Pol;	// idle value for output 0
+	uint8_t						out1Pol;	// idle value for output 1
+	LETIMER_UFOA_TypeDef		ufoa0;		// underflow output action 0
+	LETIMER_UFOA_TypeDef		ufoa1;		// underflow output action 1
+	LETIMER_RepeatMode_TypeDef	repMode;	// repeat mode
+} LETIMER_Init_TypeDef;
+
+//***********************************************************************************
+// function prototypes
+//***********************************************************************************
+void LETIMER_Init(LETIMER_TypeDef *letimer, const LETIMER_Init_TypeDef *init);
+void LETIMER_CompareSet(LETIMER_TypeDef *letimer, unsigned int comp, uint32_t value);
+uint32_t LETIMER_CompareGet(LETIMER_TypeDef *letimer, unsigned int comp);
+void LETIMER_Enable(LETIMER_TypeDef *letimer, bool enable);
+void LETIMER_IntClear(LETIMER_TypeDef *letimer, uint32_t flags);
+void LETIMER_IntEnable(LETIMER_TypeDef *letimer, uint32_t flags);
+void LETIMER_IntDisable(LETIMER_TypeDef *letimer, uint32_t flags);
+
+#endif
@@ -0,0 +1,62 @@
+/**
+ * @file em_leuart.h
+ * @author James Brennan
+ * @date October 16th, 2026
+ * @brief Host stand-in for the emlib LEUART module.
+ *
+ */
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#ifndef	EM_LEUART_HG
+#define	EM_LEUART_HG
+
+#include "em_device.h"
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+typedef enum {
+	leuartDatabits8		= 0,
+	leuartDatabits9		= LEUART_CTRL_DATABITS
+} LEUART_Databits_TypeDef;
+
+typedef enum {
+	leuartDisable		= 0,
+	leuartEnableRx		= LEUART_CMD_RXEN,
+	leuartEnableTx		= LEUART_CMD_TXEN,
+	leuartEnable		= (LEUART_CMD_RXEN | LEUART_CMD_TXEN)
+} LEUART_Enable_TypeDef;
+
+typedef enum {
+	leuartNoParity		= (0x0UL << _LEUART_CTRL_PARITY_SHIFT),
+	leuartEvenParity	= (0x2UL << _LEUART_CTRL_PARITY_SHIFT),
+	leuartOddParity		= (0x3UL << _LEUART_CTRL_PARITY_SHIFT)
+} LEUART_Parity_TypeDef;
+
+typedef enum {
+	leuartStopbits1		= 0,
+	leuartStopbits2		= LEUART_CTRL_STOPBITS
+} LEUART_Stopbits_TypeDef;
+
+typedef struct {
+	LEUART_Enable_TypeDef	enable;		// enable RX/TX when init completes
+	uint32_t				refFreq;	// reference clock, 0 selects the LEUART clock
+	uint32_t				baudrate;	// desired baudrate
+	LEUART_Databits_TypeDef	databits;	// number of data bits in frame
+	LEUART_Parity_TypeDef	parity;		// parity mode
+	LEUART_Stopbits_TypeDef	stopbits;	// number of stop bits
+} LEUART_Init_TypeDef;
+
+//***********************************************************************************
+// function prototypes
+//***********************************************************************************
+void LEUART_Init(LEUART_TypeDef *leuart, const LEUART_Init_TypeDef *init);
+void LEUART_BaudrateSet(LEUART_TypeDef *leuart, uint32_t refFreq, uint32_t baudrate);
+void LEUART_Enable(LEUART_TypeDef *leuart, LEUART_Enable_TypeDef enable);
+void LEUART_IntClear(LEUART_TypeDef *leuart, uint32_t flags);
+void LEUART_IntEnable(LEUART_TypeDef *leuart, uint32_t flags);
+void LEUART_IntDisable(LEUART_TypeDef *leuart, uint32_t flags);
+
+#endif
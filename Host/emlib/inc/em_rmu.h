@@ -0,0 +1,23 @@
+/**
+ * @file em_rmu.h
+ * @author James Brennan
+ * @date October 16th, 2026
+ * @brief Host stand-in for the emlib RMU module.
+ *
+ */
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#ifndef	EM_RMU_HG
+#define	EM_RMU_HG
+
+#include "em_device.h"
+
+//***********************************************************************************
+// function prototypes
+//***********************************************************************************
+uint32_t RMU_ResetCauseGet(void);
+void RMU_ResetCauseClear(void);
+
+#endif
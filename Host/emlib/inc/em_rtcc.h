@@ -0,0 +1,183 @@
+/**
+ * @file em_rtcc.h
+ * @author James Brennan
+ * @date October 16th, 2026
+ * @brief Host stand-in for the emlib RTCC module.
+ *
+ */
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#ifndef	EM_RTCC_HG
+#define	EM_RTCC_HG
+
+#include "em_device.h"
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+typedef enum {
+	rtccCntPresc_1 = 0,
+	rtccCntPresc_2,
+	rtccCntPresc_4,
+	rtccCntPresc_8,
+	rtccCntPresc_16,
+	rtccCntPresc_32,
+	rtccCntPresc_64,
+	rtccCntPresc_128,
+	rtccCntPresc_256,
+	rtccCntPresc_512,
+	rtccCntPresc_1024,
+	rtccCntPresc_2048,
+	rtccCntPresc_4096,
+	rtccCntPresc_8192,
+	rtccCntPresc_16384,
+	rtccCntPresc_32768
+} RTCC_CntPresc_TypeDef;
+
+typedef enum {
+	rtccCntTickPresc,
+	rtccCntTickCCV0Match
+} RTCC_PrescMode_TypeDef;
+
+typedef enum {
+	rtccCntModeNormal,
+	rtccCntModeCalendar
+} RTCC_CntMode_TypeDef;
+
+typedef struct {
+	bool					enable;				// start counting when init completes
+	bool					debugRun;			// keep counting during debug halt
+	bool					precntWrapOnCCV0;	// wrap the pre-counter on CCV0
+	bool					cntWrapOnCCV1;		// wrap the counter on CCV1
+	RTCC_CntPresc_TypeDef	presc;				// counter prescaler
+	RTCC_PrescMode_TypeDef	prescMode;			// counter tick source
+	bool					enaOSCFailDetect;	// oscillator failure detection
+	RTCC_CntMode_TypeDef	cntMode;			// normal or calendar mode
+	bool					disLeapYearCorr;	// disable leap year correction
+} RTCC_Init_TypeDef;
+
+#define RTCC_INIT_DEFAULT					\
+{											\
+	true,									\
+	false,									\
+	false,									\
+	false,									\
+	rtccCntPresc_32,						\
+	rtccCntTickPresc,						\
+	false,									\
+	rtccCntModeNormal,						\
+	false									\
+}
+
+typedef enum {
+	rtccCapComModeOff,
+	rtccCapComModeInputCapture,
+	rtccCapComModeOutputCompare
+} RTCC_CapComMode_TypeDef;
+
+typedef enum {
+	rtccCompMatchOutActionPulse,
+	rtccCompMatchOutActionToggle,
+	rtccCompMatchOutActionClear,
+	rtccCompMatchOutActionSet
+} RTCC_CompMatchOutAction_TypeDef;
+
+typedef enum {
+	rtccPRSCh0,
+	rtccPRSCh1,
+	rtccPRSCh2,
+	rtccPRSCh3
+} RTCC_PRSSel_TypeDef;
+
+typedef enum {
+	rtccInEdgeRising,
+	rtccInEdgeFalling,
+	rtccInEdgeBoth,
+	rtccInEdgeNone
+} RTCC_InEdgeSel_TypeDef;
+
+typedef enum {
+	rtccCompBaseCnt,
+	rtccCompBasePreCnt
+} RTCC_CompBase_TypeDef;
+
+typedef enum {
+	rtccDayCompareModeMonth,
+	rtccDayCompareModeWeek
+} RTCC_DayCompareMode_TypeDef;
+
+typedef struct {
+	RTCC_CapComMode_TypeDef			chMode;				// off, input capture or output compare
+	RTCC_CompMatchOutAction_TypeDef	compMatchOutAction;	// output action on a compare match
+	RTCC_PRSSel_TypeDef				prsSel;				// PRS input of input capture
+	RTCC_InEdgeSel_TypeDef			inputEdgeSel;		// edge of input capture
+	RTCC_CompBase_TypeDef			compBase;			// counter compared against CCV
+	uint8_t							compMask;			// low bits left out of the compare
+	RTCC_DayCompareMode_TypeDef		dayCompMode;		// calendar mode day compare
+} RTCC_CCChConf_TypeDef;
+
+#define RTCC_CH_INIT_COMPARE_DEFAULT		\
+{											\
+	rtccCapComModeOutputCompare,			\
+	rtccCompMatchOutActionPulse,			\
+	rtccPRSCh0,								\
+	rtccInEdgeNone,							\
+	rtccCompBaseCnt,						\
+	0,										\
+	rtccDayCompareModeMonth					\
+}
+
+//***********************************************************************************
+// function prototypes
+//***********************************************************************************
+void RTCC_Init(const RTCC_Init_TypeDef *init);
+void RTCC_Enable(bool enable);
+void RTCC_ChannelInit(int ch, const RTCC_CCChConf_TypeDef *confPtr);
+
+static inline uint32_t RTCC_CounterGet(void){
+	return RTCC->CNT;
+}
+
+static inline void RTCC_CounterSet(uint32_t value){
+	RTCC->CNT = value;
+}
+
+static inline uint32_t RTCC_ChannelCCVGet(int ch){
+	return RTCC->CC[ch].CCV;
+}
+
+static inline void RTCC_ChannelCCVSet(int ch, uint32_t value){
+	RTCC->CC[ch].CCV = value;
+}
+
+static inline uint32_t RTCC_IntGet(void){
+	return RTCC->IF;
+}
+
+static inline void RTCC_IntClear(uint32_t flags){
+	RTCC->IFC = flags;
+}
+
+static inline void RTCC_IntEnable(uint32_t flags){
+	RTCC->IEN |= flags;
+}
+
+static inline void RTCC_IntDisable(uint32_t flags){
+	RTCC->IEN &= ~flags;
+}
+
+static inline void RTCC_EM4WakeupEnable(bool enable){
+	RTCC->EM4WUEN = enable ? RTCC_EM4WUEN_EM4WU : 0;
+}
+
+static inline uint32_t RTCC_RetentionRegGet(uint32_t reg){
+	return RTCC->RET[reg].REG;
+}
+
+static inline void RTCC_RetentionRegSet(uint32_t reg, uint32_t value){
+	RTCC->RET[reg].REG = value;
+}
+
+#endif
@@ -0,0 +1,81 @@
+/**
+ * @file em_timer.h
+ * @author James Brennan
+ * @date October 16th, 2026
+ * @brief Host stand-in for the emlib TIMER module.
+ *
+ */
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#ifndef	EM_TIMER_HG
+#define	EM_TIMER_HG
+
+#include "em_device.h"
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+typedef enum {
+	timerModeUp,
+	timerModeDown,
+	timerModeUpDown,
+	timerModeQDec
+} TIMER_Mode_TypeDef;
+
+/* Prescaler field values, the division factor is 2^value */
+typedef enum {
+	timerPrescale1,
+	timerPrescale2,
+	timerPrescale4,
+	timerPrescale8,
+	timerPrescale16,
+	timerPrescale32,
+	timerPrescale64,
+	timerPrescale128,
+	timerPrescale256,
+	timerPrescale512,
+	timerPrescale1024
+} TIMER_Prescale_TypeDef;
+
+typedef enum {
+	timerClkSelHFPerClk,
+	timerClkSelCC1,
+	timerClkSelCascade
+} TIMER_ClkSel_TypeDef;
+
+typedef enum {
+	timerInputActionNone,
+	timerInputActionStart,
+	timerInputActionStop,
+	timerInputActionReloadStart
+} TIMER_InputAction_TypeDef;
+
+typedef struct {
+	bool						enable;		// start counting when init completes
+	bool						debugRun;	// keep counting during debug halt
+	TIMER_Prescale_TypeDef		prescale;	// prescaling factor
+	TIMER_ClkSel_TypeDef		clkSel;		// clock selection
+	bool						count2x;	// 2x count mode
+	bool						ati;		// always track inputs
+	TIMER_InputAction_TypeDef	fallAction;	// action on falling input edge
+	TIMER_InputAction_TypeDef	riseAction;	// action on rising input edge
+	TIMER_Mode_TypeDef			mode;		// counting mode
+	bool						dmaClrAct;	// DMA request clear on active
+	bool						quadModeX4;	// quadrature decoding mode
+	bool						oneShot;	// stop counting on the first wrap
+	bool						sync;		// start/stop/reload by other timers
+} TIMER_Init_TypeDef;
+
+#define TIMER_INIT_DEFAULT	{ true, false, timerPrescale1, timerClkSelHFPerClk, false, false,	\
+							  timerInputActionNone, timerInputActionNone, timerModeUp,			\
+							  false, false, false, false }
+
+//***********************************************************************************
+// function prototypes
+//***********************************************************************************
+void TIMER_Init(TIMER_TypeDef *timer, const TIMER_Init_TypeDef *init);
+void TIMER_Enable(TIMER_TypeDef *timer, bool enable);
+
+#endif
@@ -0,0 +1,333 @@
+/**
+ * @file em_cmu.c
+ * @author James Brennan
+ * @date October 16th, 2026
+ * @brief Host stand-in for the emlib CMU module.
+ *
+ * @details
+ * The clock tree is plain state. The host_cmu_* functions give the peripheral
+ * models the same view without counting as firmware activity.
+ *
+ */
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+
+//** Standard Libraries
+
+//** Silicon Lab include files
+#include "em_cmu.h"
+#include "em_assert.h"
+
+//** User/developer include files
+#include "host_engine.h"
+#include "host_models.h"
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+#define CMU_HFRCO_RESET_FREQ		cmuHFRCOFreq_19M0Hz
+
+//***********************************************************************************
+// Private variables
+//***********************************************************************************
+static CMU_HFRCOFreq_TypeDef hfrco_freq = CMU_HFRCO_RESET_FREQ;
+
+static bool osc_enabled[cmuOsc_COUNT] = {
+	[cmuOsc_HFRCO] = true,
+	[cmuOsc_ULFRCO] = true,
+};
+
+static CMU_Select_TypeDef clock_select[cmuClock_COUNT] = {
+	[cmuClock_HF] = cmuSelect_HFRCO,
+};
+
+static bool clock_enabled[cmuClock_COUNT] = {
+	[cmuClock_HF] = true,
+};
+
+//***********************************************************************************
+// Private functions
+//***********************************************************************************
+
+/***************************************************************************//**
+ * @brief
+ *   Frequency of a clock source, zero while the oscillator is off
+ *
+ ******************************************************************************/
+
+static uint32_t cmu_select_freq(CMU_Select_TypeDef select){
+	switch(select){
+		case cmuSelect_LFXO:
+			return osc_enabled[cmuOsc_LFXO] ? CMU_LFXO_HZ : 0;
+		case cmuSelect_LFRCO:
+			return osc_enabled[cmuOsc_LFRCO] ? CMU_LFRCO_HZ : 0;
+		case cmuSelect_HFXO:
+			return osc_enabled[cmuOsc_HFXO] ? CMU_HFXO_HZ : 0;
+		case cmuSelect_HFRCO:
+			return osc_enabled[cmuOsc_HFRCO] ? (uint32_t)hfrco_freq : 0;
+		case cmuSelect_ULFRCO:
+			return CMU_ULFRCO_HZ;
+		default:
+			return 0;
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Low frequency branch feeding a low energy peripheral clock
+ *
+ ******************************************************************************/
+
+static CMU_Clock_TypeDef cmu_lf_branch(CMU_Clock_TypeDef clock){
+	switch(clock){
+		case cmuClock_LETIMER0:
+			return cmuClock_LFA;
+		case cmuClock_LEUART0:
+			return cmuClock_LFB;
+		case cmuClock_RTCC:
+			return cmuClock_LFE;
+		default:
+			return clock;
+	}
+}
+
+//***********************************************************************************
+// Global functions
+//***********************************************************************************
+
+/***************************************************************************//**
+ * @brief
+ *   Returns the frequency of a clock for the peripheral models
+ *
+ * @details
+ * 	 Unlike CMU_ClockFreqGet() this is not a firmware call, so it does not
+ * 	 charge any time or deliver interrupts.
+ *
+ ******************************************************************************/
+
+uint32_t host_cmu_freq(CMU_Clock_TypeDef clock){
+	switch(clock){
+		case cmuClock_HF:
+		case cmuClock_HFPER:
+		case cmuClock_CORELE:
+		case cmuClock_GPIO:
+		case cmuClock_TIMER0:
+		case cmuClock_I2C0:
+		case cmuClock_I2C1:
+		case cmuClock_LDMA:
+			return cmu_select_freq(clock_select[cmuClock_HF]);
+		case cmuClock_LFA:
+		case cmuClock_LFB:
+		case cmuClock_LFE:
+			return cmu_select_freq(clock_select[clock]);
+		case cmuClock_LETIMER0:
+		case cmuClock_LEUART0:
+		case cmuClock_RTCC:
+			return cmu_select_freq(clock_select[cmu_lf_branch(clock)]);
+		default:
+			return 0;
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Returns true if a peripheral clock reaches its peripheral
+ *
+ * @details
+ * 	 High frequency peripherals also need the HFPER branch, low energy
+ * 	 peripherals need the CORELE interface clock and a running source on
+ * 	 their low frequency branch. The RTCC only needs CORELE for register
+ * 	 access, so it keeps counting in EM4H.
+ *
+ ******************************************************************************/
+
+bool host_cmu_enabled(CMU_Clock_TypeDef clock){
+	switch(clock){
+		case cmuClock_HF:
+			return true;
+		case cmuClock_TIMER0:
+		case cmuClock_I2C0:
+		case cmuClock_I2C1:
+			return clock_enabled[clock] && clock_enabled[cmuClock_HFPER];
+		case cmuClock_LETIMER0:
+		case cmuClock_LEUART0:
+			return clock_enabled[clock] && clock_enabled[cmuClock_CORELE] && host_cmu_freq(clock) != 0;
+		case cmuClock_RTCC:
+			return clock_enabled[clock] && host_cmu_freq(clock) != 0;
+		default:
+			return clock_enabled[clock];
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Returns true if an oscillator is running, for the energy model
+ *
+ ******************************************************************************/
+
+bool host_cmu_osc_enabled(CMU_Osc_TypeDef osc){
+	return osc_enabled[osc];
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Returns the deepest energy mode a peripheral clock keeps running in
+ *
+ * @details
+ * 	 High frequency clocks stop below EM1. The LFXO and LFRCO run down to
+ * 	 EM2 and the ULFRCO down to EM3.
+ *
+ ******************************************************************************/
+
+uint32_t host_cmu_lowest_em(CMU_Clock_TypeDef clock){
+	switch(cmu_lf_branch(clock)){
+		case cmuClock_LFA:
+		case cmuClock_LFB:
+		case cmuClock_LFE:
+			return clock_select[cmu_lf_branch(clock)] == cmuSelect_ULFRCO ? HOST_EM3 : HOST_EM2;
+		default:
+			return HOST_EM1;
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Resets the clock tree for an EM4H entry
+ *
+ * @details
+ * 	 Everything returns to its reset state except the EM4H domain: the LFE
+ * 	 branch and the RTCC clock, and the LFRCO or LFXO if EMU_EM4Init()
+ * 	 retained them. Whether the RTCC counts through EM4H follows from that.
+ *
+ * @param[in] retain_lfrco
+ *   Keep the LFRCO running
+ *
+ * @param[in] retain_lfxo
+ *   Keep the LFXO running
+ *
+ ******************************************************************************/
+
+void host_cmu_em4(bool retain_lfrco, bool retain_lfxo){
+	CMU_Select_TypeDef lfe = clock_select[cmuClock_LFE];
+	bool rtcc = clock_enabled[cmuClock_RTCC];
+
+	for(int i = 0; i < cmuOsc_COUNT; i++){
+		osc_enabled[i] = false;
+	}
+	for(int i = 0; i < cmuClock_COUNT; i++){
+		clock_select[i] = cmuSelect_Disabled;
+		clock_enabled[i] = false;
+	}
+	osc_enabled[cmuOsc_HFRCO] = true;
+	osc_enabled[cmuOsc_ULFRCO] = true;
+	osc_enabled[cmuOsc_LFRCO] = retain_lfrco;
+	osc_enabled[cmuOsc_LFXO] = retain_lfxo;
+	hfrco_freq = CMU_HFRCO_RESET_FREQ;
+	clock_select[cmuClock_HF] = cmuSelect_HFRCO;
+	clock_enabled[cmuClock_HF] = true;
+	clock_select[cmuClock_LFE] = lfe;
+	clock_enabled[cmuClock_RTCC] = rtcc;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Configures the HFXO
+ *
+ * @details
+ * 	 The crystal tuning has no effect on the host, the oscillator is ideal.
+ *
+ ******************************************************************************/
+
+void CMU_HFXOInit(const CMU_HFXOInit_TypeDef *hfxoInit){
+	(void)hfxoInit;
+	host_sync();
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Selects the HFRCO frequency band
+ *
+ ******************************************************************************/
+
+void CMU_HFRCOBandSet(CMU_HFRCOFreq_TypeDef setFreq){
+	host_sync();
+	hfrco_freq = setFreq;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Enables or disables an oscillator
+ *
+ * @details
+ * 	 Oscillators are ready as soon as they are enabled, so wait has no
+ * 	 effect.
+ *
+ ******************************************************************************/
+
+void CMU_OscillatorEnable(CMU_Osc_TypeDef osc, bool enable, bool wait){
+	(void)wait;
+	host_sync();
+	EFM_ASSERT(osc < cmuOsc_COUNT);
+	osc_enabled[osc] = enable;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Selects the source of a clock branch
+ *
+ ******************************************************************************/
+
+void CMU_ClockSelectSet(CMU_Clock_TypeDef clock, CMU_Select_TypeDef ref){
+	host_sync();
+	EFM_ASSERT((clock == cmuClock_HF) || (clock == cmuClock_LFA) || (clock == cmuClock_LFB) || (clock == cmuClock_LFE));
+	clock_select[clock] = ref;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Returns the source of a clock branch
+ *
+ ******************************************************************************/
+
+CMU_Select_TypeDef CMU_ClockSelectGet(CMU_Clock_TypeDef clock){
+	host_sync();
+	EFM_ASSERT(clock < cmuClock_COUNT);
+	return clock_select[clock];
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Enables or disables a clock
+ *
+ ******************************************************************************/
+
+void CMU_ClockEnable(CMU_Clock_TypeDef clock, bool enable){
+	host_sync();
+	EFM_ASSERT(clock < cmuClock_COUNT);
+	clock_enabled[clock] = enable;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Returns true if a clock is enabled
+ *
+ ******************************************************************************/
+
+bool CMU_ClockEnabled(CMU_Clock_TypeDef clock){
+	host_sync();
+	EFM_ASSERT(clock < cmuClock_COUNT);
+	return clock_enabled[clock];
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Returns the frequency of a clock
+ *
+ ******************************************************************************/
+
+uint32_t CMU_ClockFreqGet(CMU_Clock_TypeDef clock){
+	host_sync();
+	return host_cmu_freq(clock);
+}
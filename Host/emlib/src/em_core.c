@@ -0,0 +1,96 @@
+/**
+ * @file em_core.c
+ * @author James Brennan
+ * @date October 16th, 2026
+ * @brief Host stand-in for the emlib CORE module.
+ *
+ * @details
+ * Critical and atomic sections both set the PRIMASK modeled by the host
+ * interrupt controller. Interrupts raised inside a section are delivered when
+ * it ends, as they are on the Cortex-M4.
+ *
+ */
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+
+//** Standard Libraries
+
+//** Silicon Lab include files
+#include "em_core.h"
+
+//** User/developer include files
+#include "host_engine.h"
+
+//***********************************************************************************
+// Global functions
+//***********************************************************************************
+
+/***************************************************************************//**
+ * @brief
+ *   Enters a critical section
+ *
+ * @return
+ *   PRIMASK before entry, to be passed to CORE_ExitCritical()
+ *
+ ******************************************************************************/
+
+CORE_irqState_t CORE_EnterCritical(void){
+	CORE_irqState_t irqState = host_irq_masked();
+
+	host_irq_mask(true);
+	host_sync();
+	return irqState;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Leaves a critical section, restoring the PRIMASK saved on entry
+ *
+ ******************************************************************************/
+
+void CORE_ExitCritical(CORE_irqState_t irqState){
+	host_irq_mask(irqState != 0);
+	host_sync();
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Enters an atomic section
+ *
+ ******************************************************************************/
+
+CORE_irqState_t CORE_EnterAtomic(void){
+	return CORE_EnterCritical();
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Leaves an atomic section
+ *
+ ******************************************************************************/
+
+void CORE_ExitAtomic(CORE_irqState_t irqState){
+	CORE_ExitCritical(irqState);
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Returns true when called from an interrupt handler
+ *
+ ******************************************************************************/
+
+bool CORE_InIrqContext(void){
+	return host_irq_active();
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Returns true while interrupts are masked by PRIMASK
+ *
+ ******************************************************************************/
+
+bool CORE_IrqIsDisabled(void){
+	return host_irq_masked();
+}
@@ -0,0 +1,160 @@
+/**
+ * @file em_emu.c
+ * @author James Brennan
+ * @date October 16th, 2026
+ * @brief Host stand-in for the emlib EMU module.
+ *
+ * @details
+ * Entering an energy mode hands the core to the virtual-time engine, which
+ * runs the peripheral models until an enabled interrupt is pending. The time
+ * spent is charged to the energy mode that was entered.
+ *
+ * EM4H is a reset: the peripheral models and the clock tree are reset on
+ * entry, except for what the EM4H domain keeps, the engine runs until an
+ * EM4 wake-up, and the firmware restarts from main() with its RAM reset.
+ *
+ */
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+
+//** Standard Libraries
+
+//** Silicon Lab include files
+#include "em_emu.h"
+#include "em_assert.h"
+
+//** User/developer include files
+#include "host_bus.h"
+#include "host_engine.h"
+#include "host_models.h"
+
+//***********************************************************************************
+// Private variables
+//***********************************************************************************
+static EMU_EM23Init_TypeDef em23_config = EMU_EM23INIT_DEFAULT;
+static EMU_EM4Init_TypeDef em4_config = EMU_EM4INIT_DEFAULT;
+
+//***********************************************************************************
+// Global functions
+//***********************************************************************************
+
+/***************************************************************************//**
+ * @brief
+ *   Configures the DCDC regulator
+ *
+ * @details
+ * 	 The regulator is not modeled, the call always succeeds.
+ *
+ ******************************************************************************/
+
+bool EMU_DCDCInit(const EMU_DCDCInit_TypeDef *dcdcInit){
+	(void)dcdcInit;
+	host_sync();
+	return true;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Configures the regulator for EM2 and EM3
+ *
+ ******************************************************************************/
+
+void EMU_EM23Init(const EMU_EM23Init_TypeDef *em23Init){
+	host_sync();
+	em23_config = *em23Init;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Enters EM1, the core sleeps and every peripheral keeps running
+ *
+ ******************************************************************************/
+
+void EMU_EnterEM1(void){
+	host_sleep(HOST_EM1);
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Enters EM2, the high frequency clocks stop
+ *
+ * @details
+ * 	 The clock tree is not touched on the host, so restore has no effect.
+ *
+ ******************************************************************************/
+
+void EMU_EnterEM2(bool restore){
+	(void)restore;
+	host_sleep(HOST_EM2);
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Enters EM3, only the ULFRCO domain keeps running
+ *
+ ******************************************************************************/
+
+void EMU_EnterEM3(bool restore){
+	(void)restore;
+	host_sleep(HOST_EM3);
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Configures EM4
+ *
+ * @details
+ * 	 Only EM4H is modeled. The retention settings are applied when EM4H is
+ * 	 entered.
+ *
+ ******************************************************************************/
+
+void EMU_EM4Init(const EMU_EM4Init_TypeDef *em4Init){
+	host_sync();
+	em4_config = *em4Init;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Enters EM4H, the chip is reset on wake-up and this call never returns
+ *
+ * @details
+ * 	 The peripheral models are reset first, the RTCC keeps running, then the
+ * 	 clock tree keeps only the low frequency oscillators EMU_EM4Init()
+ * 	 retained. The GPIO keeps its pins while they are latched. The engine
+ * 	 charges the time until an EM4 wake-up to EM4 and the firmware restarts
+ * 	 from main() with the EM4 reset cause set.
+ *
+ ******************************************************************************/
+
+void EMU_EnterEM4H(void){
+	host_sync();
+	EFM_ASSERT(em4_config.em4State == emuEM4Hibernate);
+
+	host_bus_reset();
+	host_cmu_em4(em4_config.retainLfrco, em4_config.retainLfxo);
+	if(em4_config.pinRetentionMode != emuPinRetentionLatch){
+		host_gpio_reset();
+	}
+
+	host_hibernate();
+	host_rmu_reset(RMU_RSTCAUSE_EM4RST);
+	host_warm_reset();
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Releases pins latched through EM4H
+ *
+ * @details
+ * 	 The GPIO stand-in kept the pin state through EM4H and the firmware
+ * 	 reconfigures the pins before the release, so nothing changes on the
+ * 	 host.
+ *
+ ******************************************************************************/
+
+void EMU_UnlatchPinRetention(void){
+	host_sync();
+}
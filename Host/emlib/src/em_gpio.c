@@ -0,0 +1,96 @@
+/**
+ * @file em_gpio.c
+ * @author James Brennan
+ * @date October 16th, 2026
+ * @brief Host stand-in for the emlib GPIO module.
+ *
+ * @details
+ * Pin modes and output levels are recorded so that the firmware can read them
+ * back. Nothing is connected to the pins on the host.
+ *
+ */
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+
+//** Standard Libraries
+#include <string.h>
+
+//** Silicon Lab include files
+#include "em_gpio.h"
+#include "em_assert.h"
+
+//** User/developer include files
+#include "host_engine.h"
+#include "host_models.h"
+
+//***********************************************************************************
+// Private variables
+//***********************************************************************************
+static GPIO_Mode_TypeDef pin_mode[GPIO_PORT_COUNT][GPIO_PIN_COUNT];
+static uint16_t port_out[GPIO_PORT_COUNT];
+static GPIO_DriveStrength_TypeDef port_drive[GPIO_PORT_COUNT];
+
+//***********************************************************************************
+// Global functions
+//***********************************************************************************
+
+/***************************************************************************//**
+ * @brief
+ *   Returns every pin to its reset state, for an EM4H entry without pin
+ *   retention
+ *
+ ******************************************************************************/
+
+void host_gpio_reset(void){
+	memset(pin_mode, 0, sizeof(pin_mode));
+	memset(port_out, 0, sizeof(port_out));
+	memset(port_drive, 0, sizeof(port_drive));
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Sets the mode and output level of a pin
+ *
+ * @param[in] out
+ *   Output level, any non-zero value drives the pin high
+ *
+ ******************************************************************************/
+
+void GPIO_PinModeSet(GPIO_Port_TypeDef port, unsigned int pin, GPIO_Mode_TypeDef mode, unsigned int out){
+	host_sync();
+	EFM_ASSERT((port < GPIO_PORT_COUNT) && (pin < GPIO_PIN_COUNT));
+
+	pin_mode[port][pin] = mode;
+	if(out){
+		port_out[port] |= 1U << pin;
+	}
+	else{
+		port_out[port] &= ~(1U << pin);
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Sets the drive strength of a port
+ *
+ ******************************************************************************/
+
+void GPIO_DriveStrengthSet(GPIO_Port_TypeDef port, GPIO_DriveStrength_TypeDef strength){
+	host_sync();
+	EFM_ASSERT(port < GPIO_PORT_COUNT);
+	port_drive[port] = strength;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Returns the output level of a pin
+ *
+ ******************************************************************************/
+
+unsigned int GPIO_PinOutGet(GPIO_Port_TypeDef port, unsigned int pin){
+	host_sync();
+	EFM_ASSERT((port < GPIO_PORT_COUNT) && (pin < GPIO_PIN_COUNT));
+	return (port_out[port] >> pin) & 1U;
+}
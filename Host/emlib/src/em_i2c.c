@@ -0,0 +1,154 @@
+/**
+ * @file em_i2c.c
+ * @author James Brennan
+ * @date October 16th, 2026
+ * @brief Host stand-in for the emlib I2C module.
+ *
+ * @details
+ * Like emlib, these functions only program the I2C registers, so the I2C
+ * model sees the same register traffic it would see on the device.
+ *
+ */
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+
+//** Standard Libraries
+
+//** Silicon Lab include files
+#include "em_i2c.h"
+#include "em_cmu.h"
+#include "em_assert.h"
+
+//** User/developer include files
+#include "host_engine.h"
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+
+// Clock cycles added to each SCL period by the synchronization logic
+#define I2C_CR_MAX		4
+
+//***********************************************************************************
+// Private variables
+//***********************************************************************************
+
+// Nlow + Nhigh for each clock low/high ratio
+static const uint8_t i2c_nsum[] = { 4 + 4, 6 + 3, 11 + 6 };
+
+//***********************************************************************************
+// Global functions
+//***********************************************************************************
+
+/***************************************************************************//**
+ * @brief
+ *   Initializes an I2C peripheral
+ *
+ ******************************************************************************/
+
+void I2C_Init(I2C_TypeDef *i2c, const I2C_Init_TypeDef *init){
+	host_sync();
+	EFM_ASSERT((i2c == I2C0) || (i2c == I2C1));
+
+	i2c->IEN = 0;
+	i2c->IFC = _I2C_IF_MASK;
+	i2c->CTRL = init->master ? 0 : I2C_CTRL_SLAVE;
+
+	I2C_BusFreqSet(i2c, init->refFreq, init->freq, init->clhr);
+	I2C_Enable(i2c, init->enable);
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Sets the SCL frequency
+ *
+ * @details
+ * 	 The divider is rounded up so that the bus never runs faster than
+ * 	 freqScl. A freqRef of 0 selects the current HFPER clock.
+ *
+ ******************************************************************************/
+
+void I2C_BusFreqSet(I2C_TypeDef *i2c, uint32_t freqRef, uint32_t freqScl, I2C_ClockHLR_TypeDef i2cMode){
+	uint32_t n = i2c_nsum[i2cMode];
+	uint32_t div;
+
+	host_sync();
+	EFM_ASSERT(freqScl != 0);
+
+	if(freqRef == 0){
+		freqRef = CMU_ClockFreqGet(cmuClock_HFPER);
+	}
+
+	div = (freqRef - I2C_CR_MAX * freqScl + n * freqScl - 1) / (n * freqScl);
+	if(div > 0){
+		div--;
+	}
+
+	i2c->CTRL = (i2c->CTRL & ~_I2C_CTRL_CLHR_MASK) | ((uint32_t)i2cMode << _I2C_CTRL_CLHR_SHIFT);
+	i2c->CLKDIV = div;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Returns the SCL frequency
+ *
+ ******************************************************************************/
+
+uint32_t I2C_BusFreqGet(I2C_TypeDef *i2c){
+	uint32_t n;
+
+	host_sync();
+	n = i2c_nsum[(i2c->CTRL & _I2C_CTRL_CLHR_MASK) >> _I2C_CTRL_CLHR_SHIFT];
+	return CMU_ClockFreqGet(cmuClock_HFPER) / (n * (i2c->CLKDIV + 1) + I2C_CR_MAX);
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Enables or disables an I2C peripheral
+ *
+ ******************************************************************************/
+
+void I2C_Enable(I2C_TypeDef *i2c, bool enable){
+	host_sync();
+	if(enable){
+		i2c->CTRL |= I2C_CTRL_EN;
+	}
+	else{
+		i2c->CTRL &= ~I2C_CTRL_EN;
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Clears I2C interrupt flags
+ *
+ ******************************************************************************/
+
+void I2C_IntClear(I2C_TypeDef *i2c, uint32_t flags){
+	host_sync();
+	i2c->IFC = flags;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Enables I2C interrupts
+ *
+ ******************************************************************************/
+
+void I2C_IntEnable(I2C_TypeDef *i2c, uint32_t flags){
+	host_sync();
+	i2c->IEN |= flags;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Disables I2C interrupts
+ *
+ ******************************************************************************/
+
+void I2C_IntDisable(I2C_TypeDef *i2c, uint32_t flags){
+	host_sync();
+	i2c->IEN &= ~flags;
+}
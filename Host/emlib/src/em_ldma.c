@@ -0,0 +1,111 @@
+/**
+ * @file em_ldma.c
+ * @author James Brennan
+ * @date October 17th, 2026
+ * @brief Host stand-in for the emlib LDMA module.
+ *
+ * @details
+ * Like emlib, these functions program the LDMA registers, except for the
+ * first descriptor of a transfer: a host pointer does not fit the LINK
+ * register, so it is handed to the LDMA model directly before LINKLOAD.
+ *
+ */
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+
+//** Standard Libraries
+
+//** Silicon Lab include files
+#include "em_ldma.h"
+#include "em_cmu.h"
+#include "em_assert.h"
+
+//** User/developer include files
+#include "host_engine.h"
+#include "host_models.h"
+
+//***********************************************************************************
+// Global functions
+//***********************************************************************************
+
+/***************************************************************************//**
+ * @brief
+ *   Enables the LDMA clock and resets the controller
+ *
+ * @details
+ * 	 As in emlib, the ERROR interrupt and the LDMA line in the NVIC are
+ * 	 enabled, so firmware that uses the LDMA needs an LDMA_IRQHandler or
+ * 	 must keep the flags masked.
+ *
+ ******************************************************************************/
+
+void LDMA_Init(const LDMA_Init_t *init){
+	host_sync();
+	EFM_ASSERT(init->ldmaInitCtrlNumFixed <= DMA_CHAN_COUNT);
+
+	CMU_ClockEnable(cmuClock_LDMA, true);
+	LDMA->CTRL = (uint32_t)init->ldmaInitCtrlNumFixed << 24;
+	LDMA->CHEN = 0;
+	LDMA->CHDONE = 0;
+	LDMA->IEN = LDMA_IEN_ERROR;
+	LDMA->IFC = _LDMA_IF_MASK;
+	NVIC_ClearPendingIRQ(LDMA_IRQn);
+	NVIC_EnableIRQ(LDMA_IRQn);
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Starts a descriptor list on a channel
+ *
+ * @details
+ * 	 As in emlib, the channel's DONE interrupt is enabled
+ *
+ ******************************************************************************/
+
+void LDMA_StartTransfer(int ch, const LDMA_TransferCfg_t *transfer, const LDMA_Descriptor_t *descriptor){
+	uint32_t mask = 1UL << ch;
+
+	host_sync();
+	EFM_ASSERT(ch >= 0 && ch < DMA_CHAN_COUNT);
+
+	LDMA->CH[ch].REQSEL = transfer->ldmaReqSel;
+	LDMA->CH[ch].CFG = 0;
+	LDMA->CH[ch].LOOP = 0;
+	LDMA->CHDONE &= ~mask;
+	LDMA->IEN |= mask;
+	host_ldma_link(ch, descriptor);
+	LDMA->LINKLOAD = mask;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Stops a channel, what it has not moved yet is dropped
+ *
+ ******************************************************************************/
+
+void LDMA_StopTransfer(int ch){
+	uint32_t mask = 1UL << ch;
+
+	host_sync();
+	EFM_ASSERT(ch >= 0 && ch < DMA_CHAN_COUNT);
+
+	LDMA->IEN &= ~mask;
+	LDMA->CHEN &= ~mask;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Returns true once a channel has run its whole descriptor list
+ *
+ ******************************************************************************/
+
+bool LDMA_TransferDone(int ch){
+	uint32_t mask = 1UL << ch;
+
+	host_sync();
+	EFM_ASSERT(ch >= 0 && ch < DMA_CHAN_COUNT);
+
+	return !(LDMA->CHEN & mask) && (LDMA->CHDONE & mask);
+}
@@ -0,0 +1,143 @@
+/**
+ * @file em_letimer.c
+ * @author James Brennan
+ * @date October 16th, 2026
+ * @brief Host stand-in for the emlib LETIMER module.
+ *
+ * @details
+ * Like emlib, these functions only program the LETIMER registers, so the
+ * LETIMER model sees the same register traffic it would see on the device.
+ *
+ */
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+
+//** Standard Libraries
+
+//** Silicon Lab include files
+#include "em_letimer.h"
+#include "em_assert.h"
+
+//** User/developer include files
+#include "host_engine.h"
+
+//***********************************************************************************
+// Global functions
+//***********************************************************************************
+
+/***************************************************************************//**
+ * @brief
+ *   Initializes a LETIMER peripheral
+ *
+ ******************************************************************************/
+
+void LETIMER_Init(LETIMER_TypeDef *letimer, const LETIMER_Init_TypeDef *init){
+	uint32_t ctrl = 0;
+
+	host_sync();
+	EFM_ASSERT(letimer == LETIMER0);
+
+	if(!init->enable){
+		letimer->CMD = LETIMER_CMD_STOP;
+	}
+
+	if(init->debugRun){
+		ctrl |= LETIMER_CTRL_DEBUGRUN;
+	}
+	if(init->comp0Top){
+		ctrl |= LETIMER_CTRL_COMP0TOP;
+	}
+	if(init->bufTop){
+		ctrl |= LETIMER_CTRL_BUFTOP;
+	}
+	if(init->out0Pol){
+		ctrl |= LETIMER_CTRL_OPOL0;
+	}
+	if(init->out1Pol){
+		ctrl |= LETIMER_CTRL_OPOL1;
+	}
+	ctrl |= (uint32_t)init->ufoa0 << _LETIMER_CTRL_UFOA0_SHIFT;
+	ctrl |= (uint32_t)init->ufoa1 << _LETIMER_CTRL_UFOA1_SHIFT;
+	ctrl |= (uint32_t)init->repMode;
+	letimer->CTRL = ctrl;
+
+	if(init->enable){
+		letimer->CMD = LETIMER_CMD_START;
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Sets a compare register
+ *
+ ******************************************************************************/
+
+void LETIMER_CompareSet(LETIMER_TypeDef *letimer, unsigned int comp, uint32_t value){
+	host_sync();
+	EFM_ASSERT((comp <= 1) && (value <= _LETIMER_CNT_MASK));
+
+	if(comp == 0){
+		letimer->COMP0 = value;
+	}
+	else{
+		letimer->COMP1 = value;
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Returns a compare register
+ *
+ ******************************************************************************/
+
+uint32_t LETIMER_CompareGet(LETIMER_TypeDef *letimer, unsigned int comp){
+	host_sync();
+	EFM_ASSERT(comp <= 1);
+	return comp == 0 ? letimer->COMP0 : letimer->COMP1;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Starts or stops the counter
+ *
+ ******************************************************************************/
+
+void LETIMER_Enable(LETIMER_TypeDef *letimer, bool enable){
+	host_sync();
+	letimer->CMD = enable ? LETIMER_CMD_START : LETIMER_CMD_STOP;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Clears LETIMER interrupt flags
+ *
+ ******************************************************************************/
+
+void LETIMER_IntClear(LETIMER_TypeDef *letimer, uint32_t flags){
+	host_sync();
+	letimer->IFC = flags;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Enables LETIMER interrupts
+ *
+ ******************************************************************************/
+
+void LETIMER_IntEnable(LETIMER_TypeDef *letimer, uint32_t flags){
+	host_sync();
+	letimer->IEN |= flags;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Disables LETIMER interrupts
+ *
+ ******************************************************************************/
+
+void LETIMER_IntDisable(LETIMER_TypeDef *letimer, uint32_t flags){
+	host_sync();
+	letimer->IEN &= ~flags;
+}
@@ -0,0 +1,128 @@
+/**
+ * @file em_leuart.c
+ * @author James Brennan
+ * @date October 16th, 2026
+ * @brief Host stand-in for the emlib LEUART module.
+ *
+ * @details
+ * Like emlib, these functions only program the LEUART registers, so the
+ * LEUART model sees the same register traffic it would see on the device.
+ *
+ */
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+
+//** Standard Libraries
+
+//** Silicon Lab include files
+#include "em_leuart.h"
+#include "em_cmu.h"
+#include "em_assert.h"
+
+//** User/developer include files
+#include "host_engine.h"
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+
+// CLKDIV holds the divider in 1/256 steps, the low three bits are not implemented
+#define LEUART_CLKDIV_MASK		0x0001FFF8UL
+
+//***********************************************************************************
+// Global functions
+//***********************************************************************************
+
+/***************************************************************************//**
+ * @brief
+ *   Initializes a LEUART peripheral
+ *
+ ******************************************************************************/
+
+void LEUART_Init(LEUART_TypeDef *leuart, const LEUART_Init_TypeDef *init){
+	host_sync();
+	EFM_ASSERT(leuart == LEUART0);
+
+	LEUART_Enable(leuart, leuartDisable);
+	while(leuart->SYNCBUSY);
+
+	LEUART_BaudrateSet(leuart, init->refFreq, init->baudrate);
+	leuart->CTRL = (leuart->CTRL & ~(_LEUART_CTRL_PARITY_MASK | LEUART_CTRL_STOPBITS | LEUART_CTRL_DATABITS))
+			| (uint32_t)init->databits | (uint32_t)init->parity | (uint32_t)init->stopbits;
+
+	LEUART_Enable(leuart, init->enable);
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Sets the baudrate
+ *
+ * @details
+ * 	 baudrate = refFreq / (1 + CLKDIV / 256). A refFreq of 0 selects the
+ * 	 current LEUART clock.
+ *
+ ******************************************************************************/
+
+void LEUART_BaudrateSet(LEUART_TypeDef *leuart, uint32_t refFreq, uint32_t baudrate){
+	uint32_t clkdiv;
+
+	host_sync();
+	EFM_ASSERT(baudrate != 0);
+
+	if(refFreq == 0){
+		refFreq = CMU_ClockFreqGet(cmuClock_LEUART0);
+	}
+	EFM_ASSERT(refFreq >= baudrate);
+
+	clkdiv = (uint32_t)(((uint64_t)256 * refFreq + baudrate / 2) / baudrate) - 256;
+	leuart->CLKDIV = clkdiv & LEUART_CLKDIV_MASK;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Enables or disables the receiver and transmitter
+ *
+ ******************************************************************************/
+
+void LEUART_Enable(LEUART_TypeDef *leuart, LEUART_Enable_TypeDef enable){
+	uint32_t cmd;
+
+	host_sync();
+	cmd = (uint32_t)enable | ((~(uint32_t)enable & (uint32_t)leuartEnable) << 1);
+	leuart->CMD = cmd;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Clears LEUART interrupt flags
+ *
+ ******************************************************************************/
+
+void LEUART_IntClear(LEUART_TypeDef *leuart, uint32_t flags){
+	host_sync();
+	leuart->IFC = flags;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Enables LEUART interrupts
+ *
+ ******************************************************************************/
+
+void LEUART_IntEnable(LEUART_TypeDef *leuart, uint32_t flags){
+	host_sync();
+	leuart->IEN |= flags;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Disables LEUART interrupts
+ *
+ ******************************************************************************/
+
+void LEUART_IntDisable(LEUART_TypeDef *leuart, uint32_t flags){
+	host_sync();
+	leuart->IEN &= ~flags;
+}
@@ -0,0 +1,67 @@
+/**
+ * @file em_rmu.c
+ * @author James Brennan
+ * @date October 16th, 2026
+ * @brief Host stand-in for the emlib RMU module.
+ *
+ * @details
+ * The reset cause is plain state. It reads as a power-on reset when the host
+ * starts, and EMU_EnterEM4H() sets the EM4 cause when it wakes the chip. As
+ * on the board the causes accumulate until the firmware clears them.
+ *
+ */
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+
+//** Standard Libraries
+
+//** Silicon Lab include files
+#include "em_rmu.h"
+
+//** User/developer include files
+#include "host_engine.h"
+#include "host_models.h"
+
+//***********************************************************************************
+// Private variables
+//***********************************************************************************
+static uint32_t reset_cause = RMU_RSTCAUSE_PORST;
+
+//***********************************************************************************
+// Global functions
+//***********************************************************************************
+
+/***************************************************************************//**
+ * @brief
+ *   Records a reset for the firmware to find, without counting as firmware
+ *   activity
+ *
+ ******************************************************************************/
+
+void host_rmu_reset(uint32_t cause){
+	reset_cause |= cause;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Returns the causes of the resets since they were last cleared
+ *
+ ******************************************************************************/
+
+uint32_t RMU_ResetCauseGet(void){
+	host_sync();
+	return reset_cause;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Clears the reset causes
+ *
+ ******************************************************************************/
+
+void RMU_ResetCauseClear(void){
+	host_sync();
+	reset_cause = 0;
+}
@@ -0,0 +1,108 @@
+/**
+ * @file em_rtcc.c
+ * @author James Brennan
+ * @date October 16th, 2026
+ * @brief Host stand-in for the emlib RTCC module.
+ *
+ * @details
+ * Like emlib, these functions only program the RTCC registers, so the RTCC
+ * model sees the same register traffic it would see on the device.
+ *
+ */
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+
+//** Standard Libraries
+
+//** Silicon Lab include files
+#include "em_rtcc.h"
+#include "em_assert.h"
+
+//** User/developer include files
+#include "host_engine.h"
+
+//***********************************************************************************
+// Global functions
+//***********************************************************************************
+
+/***************************************************************************//**
+ * @brief
+ *   Initializes the RTCC
+ *
+ * @details
+ * 	 Calendar mode and the CCV0/CCV1 wrap options are not modeled, the
+ * 	 counter always runs free.
+ *
+ ******************************************************************************/
+
+void RTCC_Init(const RTCC_Init_TypeDef *init){
+	uint32_t ctrl;
+
+	host_sync();
+	EFM_ASSERT(init->cntMode == rtccCntModeNormal);
+	EFM_ASSERT(!init->precntWrapOnCCV0 && !init->cntWrapOnCCV1);
+
+	ctrl = ((uint32_t)init->presc << _RTCC_CTRL_CNTPRESC_SHIFT);
+	if(init->enable){
+		ctrl |= RTCC_CTRL_ENABLE;
+	}
+	if(init->debugRun){
+		ctrl |= RTCC_CTRL_DEBUGRUN;
+	}
+	if(init->prescMode == rtccCntTickCCV0Match){
+		ctrl |= RTCC_CTRL_CNTTICK;
+	}
+	if(init->enaOSCFailDetect){
+		ctrl |= RTCC_CTRL_OSCFDETEN;
+	}
+	if(init->disLeapYearCorr){
+		ctrl |= RTCC_CTRL_LYEARCORRDIS;
+	}
+	RTCC->CTRL = ctrl;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Starts or stops the counter
+ *
+ ******************************************************************************/
+
+void RTCC_Enable(bool enable){
+	host_sync();
+	if(enable){
+		RTCC->CTRL |= RTCC_CTRL_ENABLE;
+	}
+	else{
+		RTCC->CTRL &= ~RTCC_CTRL_ENABLE;
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Configures a capture/compare channel
+ *
+ * @details
+ * 	 Only output compare against the counter is modeled, a match sets the
+ * 	 channel's interrupt flag.
+ *
+ ******************************************************************************/
+
+void RTCC_ChannelInit(int ch, const RTCC_CCChConf_TypeDef *confPtr){
+	uint32_t ctrl;
+
+	host_sync();
+	EFM_ASSERT(ch >= 0 && ch < 3);
+	EFM_ASSERT(confPtr->chMode != rtccCapComModeInputCapture);
+	EFM_ASSERT(confPtr->compBase == rtccCompBaseCnt && confPtr->compMask == 0);
+
+	ctrl = (uint32_t)confPtr->chMode
+			| ((uint32_t)confPtr->compMatchOutAction << _RTCC_CC_CTRL_CMOA_SHIFT)
+			| ((uint32_t)confPtr->inputEdgeSel << _RTCC_CC_CTRL_ICEDGE_SHIFT)
+			| ((uint32_t)confPtr->prsSel << _RTCC_CC_CTRL_PRSSEL_SHIFT);
+	if(confPtr->dayCompMode == rtccDayCompareModeWeek){
+		ctrl |= RTCC_CC_CTRL_DAYCC;
+	}
+	RTCC->CC[ch].CTRL = ctrl;
+}
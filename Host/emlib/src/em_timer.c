@@ -0,0 +1,75 @@
+/**
+ * @file em_timer.c
+ * @author James Brennan
+ * @date October 16th, 2026
+ * @brief Host stand-in for the emlib TIMER module.
+ *
+ * @details
+ * Like emlib, these functions only program the TIMER registers, so the TIMER
+ * model sees the same register traffic it would see on the device.
+ *
+ */
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+
+//** Standard Libraries
+
+//** Silicon Lab include files
+#include "em_timer.h"
+#include "em_assert.h"
+
+//** User/developer include files
+#include "host_engine.h"
+
+//***********************************************************************************
+// Global functions
+//***********************************************************************************
+
+/***************************************************************************//**
+ * @brief
+ *   Initializes a TIMER peripheral
+ *
+ * @details
+ * 	 As in emlib the counter is reset, only the mode, one-shot and prescaler
+ * 	 settings are used by the TIMER model.
+ *
+ ******************************************************************************/
+
+void TIMER_Init(TIMER_TypeDef *timer, const TIMER_Init_TypeDef *init){
+	uint32_t ctrl;
+
+	host_sync();
+	EFM_ASSERT(timer == TIMER0);
+
+	if(!init->enable){
+		timer->CMD = TIMER_CMD_STOP;
+	}
+
+	timer->CNT = 0;
+
+	ctrl = (uint32_t)init->mode | ((uint32_t)init->prescale << _TIMER_CTRL_PRESC_SHIFT);
+	if(init->oneShot){
+		ctrl |= TIMER_CTRL_OSMEN;
+	}
+	if(init->debugRun){
+		ctrl |= TIMER_CTRL_DEBUGRUN;
+	}
+	timer->CTRL = ctrl;
+
+	if(init->enable){
+		timer->CMD = TIMER_CMD_START;
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Starts or stops the counter
+ *
+ ******************************************************************************/
+
+void TIMER_Enable(TIMER_TypeDef *timer, bool enable){
+	host_sync();
+	timer->CMD = enable ? TIMER_CMD_START : TIMER_CMD_STOP;
+}
@@ -31,6 +31,9 @@ static uint32_t hdata;
 static uint32_t tdata;
 static uint32_t uReg;
 
+//bus the self test runs on, set by si7021_i2c_open()
+static I2C_TypeDef *test_i2c;
+
 //***********************************************************************************
 // Private functions
 //***********************************************************************************
@@ -60,9 +63,13 @@ static uint32_t uReg;
  * @param[in] SCL_route
  *   SCL out-route for the i2c peripheral being used
  *
+ * @param[in] configure
+ *   Runs the self test, which ends by writing the resolution. False on a
+ *   warm boot from EM4H, where the sensor stayed powered and configured.
+ *
  ******************************************************************************/
 
-void si7021_i2c_open(I2C_TypeDef *i2c, uint32_t SDA_route, uint32_t SCL_route ){
+void si7021_i2c_open(I2C_TypeDef *i2c, uint32_t SDA_route, uint32_t SCL_route, bool configure){
 
 	//timer delay as per the si7021 power on specifications
 	 //timer_delay(80);
@@ -89,13 +96,13 @@ void si7021_i2c_open(I2C_TypeDef *i2c, uint32_t SDA_route, uint32_t SCL_route ){
 	 i2c_open(i2c, &i2c_open_struct);
 	 //while(i2c->STATE & I2C_STATE_BUSY);
 
-	 uint8_t writeData = 0b00000001;
+	 if(!configure){
+		 return;
+	 }
 
-	 //running the test
-	 EFM_ASSERT(si7021_test(i2c));
-	 si7021_write(Si7021_Write_Reg_CB, i2c,  WRITE_REG, writeData);
-	 //delaying after writing to the si7021 user register as per specifications
-	// timer_delay(15);
+	 //running the test, it writes the configuration once it has passed
+	 test_i2c = i2c;
+	 add_scheduled_event(SI7021_TEST_CB);
 
 
  }
@@ -120,17 +127,25 @@ void si7021_i2c_open(I2C_TypeDef *i2c, uint32_t SDA_route, uint32_t SCL_route ){
  ******************************************************************************/
 
 void si7021_read(uint32_t SI7021_READ_CB, I2C_TypeDef *i2c, uint32_t command){
-	uint32_t address = SI7021_I2C_ADDRESS;
+	I2C_TRANSFER transfer = {
+		.address = SI7021_I2C_ADDRESS,
+		.write = { command },
+		.write_len = 1,
+		.read_len = (command == READ_REG) ? 1 : 2,		//the user register is one byte, measurements two
+		.order = I2C_MSB_FIRST,
+		.event = SI7021_READ_CB
+	};
+
 	if(command == READ_HUM){
-		I2C_Start(i2c, &hdata, address, SI7021_READ_CB, command, false);
+		transfer.data = &hdata;
 	}
-
 	else if(command == READ_TEMP){
-		I2C_Start(i2c, &tdata, address, SI7021_READ_CB, command, false);
+		transfer.data = &tdata;
 	}
 	else if(command == READ_REG){
-		I2C_Start(i2c, &uReg, address, SI7021_READ_CB, command, false);
+		transfer.data = &uReg;
 	}
+	i2c_transfer(i2c, &transfer);
 
 }
 
@@ -161,8 +176,14 @@ void si7021_read(uint32_t SI7021_READ_CB, I2C_TypeDef *i2c, uint32_t command){
 
 
 void si7021_write(uint32_t SI7021_READ_CB, I2C_TypeDef *i2c, uint32_t command, uint8_t writeData){
-	uint32_t address = SI7021_I2C_ADDRESS;
-	I2C_Start(i2c, false, address, SI7021_READ_CB, command, writeData);
+	I2C_TRANSFER transfer = {
+		.address = SI7021_I2C_ADDRESS,
+		.write = { command, writeData },
+		.write_len = 2,
+		.event = SI7021_READ_CB
+	};
+
+	i2c_transfer(i2c, &transfer);
 
 
 }
@@ -183,8 +204,28 @@ void si7021_write(uint32_t SI7021_READ_CB, I2C_TypeDef *i2c, uint32_t command, u
  ******************************************************************************/
 
 float si7021_return_humidity(void){
+	return si7021_humidity(hdata);
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Converts a raw si7021 humidity code to percent relative humidity
+ *
+ * @details
+ * 	 Used by handlers that receive the code as an event payload instead of
+ * 	 reading it back from the driver
+ *
+ * @param[in] code
+ *   16 bit humidity code read from the si7021
+ *
+ * @return
+ *   Relative humidity in percent
+ *
+ ******************************************************************************/
+
+float si7021_humidity(uint32_t code){
 	float humidity;
-	humidity = (125*((float)(hdata))/65536) - 6; //equation for humidity conversion
+	humidity = (125*((float)(code))/65536) - 6; //equation for humidity conversion
 	return humidity;
 }
 
@@ -206,8 +247,24 @@ float si7021_return_humidity(void){
 
 
 float si7021_return_temperature(void){
+	return si7021_temperature(tdata);
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Converts a raw si7021 temperature code to degrees Celsius
+ *
+ * @param[in] code
+ *   16 bit temperature code read from the si7021
+ *
+ * @return
+ *   Temperature in degrees Celsius
+ *
+ ******************************************************************************/
+
+float si7021_temperature(uint32_t code){
 	float temp;
-	temp = (175.72*((float)(tdata))/65536) - 46.85; //equation for temperature conversion
+	temp = (175.72*((float)(code))/65536) - 46.85; //equation for temperature conversion
 	return temp;
 }
 
@@ -252,84 +309,85 @@ int si7021_return_uReg(void){
  * 	 In the case of a write, the function will check that it was successful by then
  * 	 performing a read and comparing it to the expected value.
  *
+ * 	 The test is a coroutine run by the scheduler from SI7021_TEST_CB. Each
+ * 	 transfer and each delay after a register write posts SI7021_TEST_CB when
+ * 	 it completes, and the core sleeps in between instead of spinning.
+ *
  * @note
- *   The rest resets the state of the  si7021 before completion, so configuring
- *   of the si7021 must also be perform in application code
+ *   The rest resets the state of the  si7021 before completion, so it ends by
+ *   writing the application's resolution and handing over to Si7021_Write_Reg_CB
  *
- * @param[in] *i2c
- *   This specifies the i2c bus we are using to test the si7021
+ * @param[in] cr
+ *   State of the coroutine, kept by the scheduler
  *
- * @return
- *   Returns bool true if successfully passed through the tests in this
- *   function.
  ******************************************************************************/
 
 
-bool si7021_test(I2C_TypeDef *i2c){
+void si7021_test(COROUTINE *cr){
 
 	//initializing data required for the test
-	uint32_t address = SI7021_I2C_ADDRESS;
-	uint8_t writeData = 0b00000000;
+	uint8_t writeData;
+	float hum;
+	float temp;
+
+	COROUTINE_BEGIN(cr);
+
 	uReg = 0;
 
 	//changes the si7021 to default settings, in case the test is run multiple times in a row or
 	//immediately after application code
-	I2C_Start(i2c, false, address, SI7021_TEST_CB, WRITE_REG, writeData);
-	//delaying after writing to the si7021 user register as per specifications
-	timer_delay(15);
+	writeData = 0b00000000;
+	si7021_write(SI7021_TEST_CB, test_i2c, WRITE_REG, writeData);
 
-	//these while loops are used throughout the test, they make sure it does not continue until the i2c is free
-	while(!(get_scheduled_events() & (SI7021_TEST_CB)));
-	remove_scheduled_event(SI7021_TEST_CB);
+	//each yield waits for the i2c transfer or the timer to post SI7021_TEST_CB
+	COROUTINE_YIELD(cr);
+	//delaying after writing to the si7021 user register as per specifications
+	letimer_timer_start(SI7021_TEST_CB, SI7021_WRITE_DELAY_MS, false);
+	COROUTINE_YIELD(cr);
 
 	//reads from the user register to check if the si7021 is indeed in default settings
-	I2C_Start(i2c, &uReg, address, SI7021_TEST_CB, READ_REG, false);
-	while(!(get_scheduled_events() & (SI7021_TEST_CB)));
-	remove_scheduled_event(SI7021_TEST_CB);
+	si7021_read(SI7021_TEST_CB, test_i2c, READ_REG);
+	COROUTINE_YIELD(cr);
 	EFM_ASSERT(uReg == 58); //58 is the default value of the user register in decimal
 
 	writeData = 0b00000001;
 	//writes to the user register to change the resolution on temp/humidity
-	I2C_Start(i2c, false, address, SI7021_TEST_CB, WRITE_REG, writeData);
-	while(!(get_scheduled_events() & (SI7021_TEST_CB)));
-	remove_scheduled_event(SI7021_TEST_CB);
+	si7021_write(SI7021_TEST_CB, test_i2c, WRITE_REG, writeData);
+	COROUTINE_YIELD(cr);
 	//delaying after writing to the si7021 user register as per specifications
-	timer_delay(15);
+	letimer_timer_start(SI7021_TEST_CB, SI7021_WRITE_DELAY_MS, false);
+	COROUTINE_YIELD(cr);
 
 	//reads from the user register to ensure the write was successful
-	I2C_Start(i2c, &uReg, address, SI7021_TEST_CB, READ_REG, false);
-	while(!(get_scheduled_events() & (SI7021_TEST_CB)));
-	remove_scheduled_event(SI7021_TEST_CB);
+	si7021_read(SI7021_TEST_CB, test_i2c, READ_REG);
+	COROUTINE_YIELD(cr);
 	EFM_ASSERT(uReg == 59);//59 is the value of the user register, in decimal, after the resolution has been changed to 8/12
 
 	//takes a humidity reading
 	hdata = 0;											//sets hdata to 0
-	I2C_Start(i2c, &hdata, address, SI7021_TEST_CB, READ_HUM, false);
-	while(!(get_scheduled_events() & (SI7021_TEST_CB)));
-	remove_scheduled_event(SI7021_TEST_CB);
-	float hum = si7021_return_humidity();
+	si7021_read(SI7021_TEST_CB, test_i2c, READ_HUM);
+	COROUTINE_YIELD(cr);
+	hum = si7021_return_humidity();
 	EFM_ASSERT((hum > 20) && (hum < 50));								//if hdata is non-zero than a read has occurred
 
 	//takes a temperature reading											//sets tdata to 0
-	I2C_Start(i2c, &tdata, address, SI7021_TEST_CB, READ_TEMP, false);
-	while(!(get_scheduled_events() & (SI7021_TEST_CB)));
-	remove_scheduled_event(SI7021_TEST_CB);
-	float temp = si7021_return_temperature();
+	si7021_read(SI7021_TEST_CB, test_i2c, READ_TEMP);
+	COROUTINE_YIELD(cr);
+	temp = si7021_return_temperature();
 	EFM_ASSERT((temp > 20) && (temp < 30));								//if tdata is non-zero than a read has occurred
 
 	//resets the si7021 to default settings
 	writeData = 0b00000000;
-	I2C_Start(i2c, false, address, SI7021_TEST_CB, WRITE_REG, writeData);
-	while(!(get_scheduled_events() & (SI7021_TEST_CB)));
-	remove_scheduled_event(SI7021_TEST_CB);
+	si7021_write(SI7021_TEST_CB, test_i2c, WRITE_REG, writeData);
+	COROUTINE_YIELD(cr);
 	//delaying after writing to the si7021 user register as per specifications
-	timer_delay(15);
+	letimer_timer_start(SI7021_TEST_CB, SI7021_WRITE_DELAY_MS, false);
+	COROUTINE_YIELD(cr);
 
+	//test passed, configuring the resolution used by the application
+	writeData = 0b00000001;
+	si7021_write(Si7021_Write_Reg_CB, test_i2c, WRITE_REG, writeData);
 
-	return true;
-
+	COROUTINE_END(cr);
 
 }
-
-
-
@@ -16,17 +16,50 @@
 // defined files
 //***********************************************************************************
 
+#ifdef APP_HIBERNATE_ENABLED
+//kept in the RTCC retention registers while the node hibernates
+typedef struct {
+	uint32_t	next_sample;		//RTCC count the next sample is due at
+} APP_RETAINED;
+#endif
 
 //***********************************************************************************
 // Static / Private Variables
 //***********************************************************************************
 
+//rejects bad priorities and budgets in the event list at compile time
+SCHEDULER_EVENT_LIST(SCHEDULER_TABLE_CHECK)
+
+//set once the sensors are configured, the LETIMER runs before that for the boot delays
+static bool app_sampling;
+
+//readings of the current sample still to come, humidity/temperature and lux
+static uint32_t app_readings_due;
+
+//samples since the last I2C summary, which is sent once the due sample's readings are in
+static uint32_t app_stats_samples;
+static bool app_stats_due;
+
+#ifdef APP_HIBERNATE_ENABLED
+static APP_RETAINED app_retained;
+#endif
+
+//***********************************************************************************
+// Global Variables
+//***********************************************************************************
+
+//dispatch table of every event in events.h, indexed by event ID
+const SCHEDULER_EVENT_ENTRY scheduler_event_table[SCHEDULER_EVENT_COUNT] = {
+	SCHEDULER_EVENT_LIST(SCHEDULER_TABLE_ENTRY)
+};
+
 
 //***********************************************************************************
 // Private functions
 //***********************************************************************************
 
 static void app_letimer_pwm_open(float period, float act_period, uint32_t out0_route, uint32_t out1_route);
+static void app_reading_done(void);
 
 //***********************************************************************************
 // Global functions
@@ -41,6 +74,10 @@ static void app_letimer_pwm_open(float period, float act_period, uint32_t out0_r
  *	LETIMER's registers for PWM. It should be called after the chip is initialized
  *	to start the application.
  *
+ *	The LETIMER is started first, as the sensor start up sequences wait on its
+ *	software timers. They run from the scheduler, so this function returns
+ *	straight away and the core sleeps while they wait.
+ *
  *
  * @note
  *	Please see individual functions for more information.
@@ -50,24 +87,107 @@ static void app_letimer_pwm_open(float period, float act_period, uint32_t out0_r
 void app_peripheral_setup(void){
 
 	cmu_open();
+	rtcc_open();
+	trace_open();
 	gpio_open();
 	scheduler_open();
+	work_queue_open();
 	sleep_open();
-	sleep_block_mode(SYSTEM_BLOCK_EM);
+	sleep_block_mode(SYSTEM_BLOCK_EM, SLEEP_OWNER_APP);
+
+	#ifdef APP_HIBERNATE_ENABLED
+	hibernate_pins_release();
+	#endif
+
+	app_sampling = false;
+	app_letimer_pwm_open(PWM_PER, PWM_ACT_PER, PWM_ROUTE_0, PWM_ROUTE_1);
+	letimer_start(LETIMER0, true);   // letimer_start will inform the LETIMER0 peripheral to begin counting.
+
+	veml6030_i2c_open(I2C0, I2C0_SDA_ROUTE, I2C0_SCL_ROUTE, true);
+	si7021_i2c_open(I2C1, I2C1_SDA_ROUTE, I2C1_SCL_ROUTE, true);
+
+	ble_open();
+
+}
 
-	veml6030_i2c_open(I2C0, I2C0_SDA_ROUTE, I2C0_SCL_ROUTE );
-	si7021_i2c_open(I2C1, I2C1_SDA_ROUTE, I2C1_SCL_ROUTE );
+#ifdef APP_HIBERNATE_ENABLED
+/***************************************************************************//**
+ * @brief
+ *	Start up after the node woke from EM4H for a sample
+ *
+ * @details
+ *	Leaving EM4H is a reset, so the clock tree, the GPIO and the drivers
+ *	are opened again. The RTCC kept counting and is not touched, and the
+ *	sensors stayed powered through the latched enable pin, so their self
+ *	test and configuration are skipped and the sample is taken on the
+ *	LETIMER's first underflow.
+ *
+ * @note
+ *	Called from main() instead of app_peripheral_setup() when
+ *	hibernate_warm_boot() found a retained state
+ *
+ ******************************************************************************/
 
+void app_warm_boot(void){
+	bool restored;
 
+	cmu_open();
+	trace_open();
+	gpio_open();
+	hibernate_pins_release();
+	scheduler_open();
+	work_queue_open();
+	sleep_open();
+	sleep_block_mode(SYSTEM_BLOCK_EM, SLEEP_OWNER_APP);
 
+	restored = hibernate_restore(&app_retained, sizeof(app_retained));
+	EFM_ASSERT(restored);
 
 	app_letimer_pwm_open(PWM_PER, PWM_ACT_PER, PWM_ROUTE_0, PWM_ROUTE_1);
+	letimer_start(LETIMER0, true);
+
+	veml6030_i2c_open(I2C0, I2C0_SDA_ROUTE, I2C0_SCL_ROUTE, false);
+	si7021_i2c_open(I2C1, I2C1_SDA_ROUTE, I2C1_SCL_ROUTE, false);
 
 	ble_open();
-	//letimer_start(LETIMER0, true);   // letimer_start will inform the LETIMER0 peripheral to begin counting. (moved to scheduler)
-	//add_scheduled_event(BOOT_UP_CB);
 
+	//the LETIMER counts down from its reset value of 0, so its first
+	//underflow comes on the next tick and takes the sample
+	app_sampling = true;
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *	Hibernates until the next sample if the node is idle
+ *
+ * @details
+ *	EM4H loses the RAM and every peripheral but the RTCC, so the node only
+ *	hibernates once both readings are in, the BLE module has sent them, no
+ *	software timer is armed and no driver blocks EM2. The application's
+ *	own SYSTEM_BLOCK_EM and the LETIMER's block of EM4 are overridden, as
+ *	the LETIMER is only needed while the node is awake. If the next sample
+ *	is too close the function returns and the node sleeps as usual.
+ *
+ * @note
+ *	Called from the main loop with interrupts masked, when neither the
+ *	scheduler nor the work queue has anything to run. Does not return if
+ *	the node hibernates.
+ *
+ ******************************************************************************/
+
+void app_hibernate(void){
+	int32_t remaining = (int32_t)(app_retained.next_sample - rtcc_timestamp());
+
+	if(!app_sampling || app_readings_due != 0 || !ble_tx_idle() || !letimer_timers_idle()){
+		return;
+	}
+	if((sleep_blocked_modes() & ((1 << SYSTEM_BLOCK_EM) - 1)) != 0 || remaining < APP_HIBERNATE_MIN_COUNTS){
+		return;
+	}
+	hibernate_enter(&app_retained, sizeof(app_retained), app_retained.next_sample);
 }
+#endif
 
 /***************************************************************************//**
  * @brief
@@ -112,8 +232,6 @@ void app_letimer_pwm_open(float period, float act_period, uint32_t out0_route, u
 
 	letimer_pwm_struct.comp0_irq_enable = false;
 	letimer_pwm_struct.comp0_cb = LETIMER_COMP0_CB;
-	letimer_pwm_struct.comp1_irq_enable = false;
-	letimer_pwm_struct.comp1_cb = LETIMER_COMP1_CB;
 	letimer_pwm_struct.uf_irq_enable = true;
 	letimer_pwm_struct.uf_cb = LETIMER_UF_CB;
 
@@ -121,6 +239,26 @@ void app_letimer_pwm_open(float period, float act_period, uint32_t out0_route, u
 
 }
 
+/***************************************************************************//**
+ * @brief
+ * Counts a reading of the current sample in
+ *
+ *
+ * @details
+ * Once the last reading is in and a summary is due, the I2C counters are
+ * sent over BLE. They go out between samples, so their lines do not fill
+ * the BLE buffer ahead of the readings.
+ *
+ ******************************************************************************/
+
+static void app_reading_done(void){
+	app_readings_due--;
+	if(app_readings_due == 0 && app_stats_due){
+		app_stats_due = false;
+		i2c_stats_ble();
+	}
+}
+
 /***************************************************************************//**
  * @brief
  * Handles the UF event
@@ -130,7 +268,11 @@ void app_letimer_pwm_open(float period, float act_period, uint32_t out0_route, u
  * At this point the UF event handles sleep modes
  *
  * @note
+ * Underflows before the boot up event has run are ignored, the si7021 self
+ * test is still using I2C1
  *
+ * If the readings of the previous sample have not all arrived, the period
+ * has overrun and the trace ring is sent over BLE to show what held it up
 
  *
  ******************************************************************************/
@@ -138,8 +280,27 @@ void app_letimer_pwm_open(float period, float act_period, uint32_t out0_route, u
 void scheduled_letimer0_uf_cb (void){
 
 
-	EFM_ASSERT(get_scheduled_events() & LETIMER_UF_CB);
+	EFM_ASSERT(check_scheduled_event(LETIMER_UF_CB));
 	remove_scheduled_event(LETIMER_UF_CB);
+	if(!app_sampling){
+		return;
+	}
+	if(app_readings_due != 0){
+		trace_dump_ble();
+	}
+	app_readings_due = 2;
+	if(++app_stats_samples == APP_I2C_STATS_SAMPLES){
+		app_stats_samples = 0;
+		app_stats_due = true;
+	}
+
+	#ifdef APP_HIBERNATE_ENABLED
+	//the wake-ups are kept on the RTCC grid, a sample that ran late starts a new one
+	app_retained.next_sample += APP_SAMPLE_COUNTS;
+	if((int32_t)(app_retained.next_sample - rtcc_timestamp()) <= 0){
+		app_retained.next_sample = rtcc_timestamp() + APP_SAMPLE_COUNTS;
+	}
+	#endif
 	/* uint32_t currentmode = current_block_energy_mode();
 	sleep_unblock_mode(currentmode);
 
@@ -151,7 +312,9 @@ void scheduled_letimer0_uf_cb (void){
 	}*/
 	//
 
+	//the temperature comes from the humidity conversion, I2C1 queues it behind that read
 	si7021_read(Si7021_Read_Humidity_CB, I2C1, READ_HUM);
+	si7021_read(Si7021_Read_Temperature_CB, I2C1, READ_TEMP);
 	veml6030_read(VEML6030_Read_CB, I2C0,  0x04);
 
 
@@ -177,29 +340,6 @@ void scheduled_letimer0_comp0_cb (void){
 	EFM_ASSERT(false);
 }
 
-/***************************************************************************//**
- * @brief
- * Handles the COMP1 event
- *
- *
- * @details
- * details here
- *
- * @note
- *
-
- *
- ******************************************************************************/
-void scheduled_letimer0_comp1_cb (void){
-
-
-
-	remove_scheduled_event(LETIMER_COMP1_CB);
-	EFM_ASSERT(false);
-
-}
-
-
 /***************************************************************************//**
  * @brief
  * Handles the Si7021 humidity event
@@ -213,22 +353,24 @@ void scheduled_letimer0_comp1_cb (void){
  * @note
  *
 
+ *
+ * @param[in] record
+ *   Record posted by the I2C state machine, the payload holds the raw reading,
+ *   or 0 if the read failed, and the status how the read ended
  *
  ******************************************************************************/
-void scheduled_si7021_humidity_cb (void){
-
-
-	EFM_ASSERT(get_scheduled_events() & (Si7021_Read_Humidity_CB));
-
-
-	remove_scheduled_event(Si7021_Read_Humidity_CB);
+void scheduled_si7021_humidity_cb (const SCHEDULER_RECORD *record){
+	EFM_ASSERT(record->event == Si7021_Read_Humidity_CB);
 
 	char humidity_str[25];
 
 	float hdata;
-	hdata = si7021_return_humidity();
-
-
+	//a sensor that stopped answering is reported instead of a bogus reading
+	if(record->status != I2C_OK){
+		ble_write("\nHumidity read failed\n");
+		return;
+	}
+	hdata = si7021_humidity(record->payload);
 
 	sprintf(humidity_str,"\nHumidity = %.1f %%\n", hdata);
 
@@ -241,7 +383,6 @@ void scheduled_si7021_humidity_cb (void){
 	else{
 			GPIO_PinModeSet(LED1_PORT, LED1_PIN, LED1_GPIOMODE, LED1_DEFAULT);
 		}
-	si7021_read(Si7021_Read_Temperature_CB, I2C1, READ_TEMP);
 
 }
 
@@ -257,12 +398,14 @@ void scheduled_si7021_humidity_cb (void){
  * @note
  *
 
+ *
+ * @param[in] record
+ *   Record posted by the I2C state machine, the payload holds the raw reading
  *
  ******************************************************************************/
 
-void scheduled_si7021_temperature_cb (void){
-	EFM_ASSERT(get_scheduled_events() & (Si7021_Read_Temperature_CB));
-	remove_scheduled_event(Si7021_Read_Temperature_CB);
+void scheduled_si7021_temperature_cb (const SCHEDULER_RECORD *record){
+	EFM_ASSERT(record->event == Si7021_Read_Temperature_CB);
 
 
 	char temp_str[25];
@@ -278,7 +421,12 @@ void scheduled_si7021_temperature_cb (void){
 	//char temperature_str[25];
 
 	float tdata;
-	tdata = si7021_return_temperature();
+	app_reading_done();
+	if(record->status != I2C_OK){
+		ble_write("Temperature read failed\n");
+		return;
+	}
+	tdata = si7021_temperature(record->payload);
 
 	sprintf(temp_str,"Temperature = %.1f C\n", tdata);
 
@@ -306,7 +454,7 @@ void scheduled_si7021_temperature_cb (void){
  ******************************************************************************/
 
 void scheduled_veml6030_write_cb (void){
-	EFM_ASSERT(get_scheduled_events() & (VEML6030_Write_CB));
+	EFM_ASSERT(check_scheduled_event(VEML6030_Write_CB));
 	remove_scheduled_event(VEML6030_Write_CB);
 	//veml6030_read(VEML6030_Read_CB, I2C0,  0x04);
 
@@ -327,12 +475,14 @@ void scheduled_veml6030_write_cb (void){
  * @note
  *
 
+ *
+ * @param[in] record
+ *   Record posted by the I2C state machine, the payload holds the raw reading
  *
  ******************************************************************************/
 
-void scheduled_veml6030_lux_cb (void){
-	EFM_ASSERT(get_scheduled_events() & (VEML6030_Read_CB));
-	remove_scheduled_event(VEML6030_Read_CB);
+void scheduled_veml6030_lux_cb (const SCHEDULER_RECORD *record){
+	EFM_ASSERT(record->event == VEML6030_Read_CB);
 
 
 	char lux_str[25];
@@ -348,7 +498,12 @@ void scheduled_veml6030_lux_cb (void){
 	//char temperature_str[25];
 
 	float ldata;
-	ldata = veml6030_return_lux();
+	app_reading_done();
+	if(record->status != I2C_OK){
+		ble_write("Lux read failed\n");
+		return;
+	}
+	ldata = veml6030_lux(record->payload);
 
 	sprintf(lux_str,"Lux = %.1f \n", ldata);
 
@@ -375,7 +530,7 @@ void scheduled_veml6030_lux_cb (void){
  ******************************************************************************/
 
 void scheduled_si7021_writeReg_cb (void){
-	EFM_ASSERT(get_scheduled_events() & (Si7021_Write_Reg_CB));
+	EFM_ASSERT(check_scheduled_event(Si7021_Write_Reg_CB));
 	remove_scheduled_event(Si7021_Write_Reg_CB);
 
 	si7021_read(Si7021_Read_Reg_CB, I2C1, 0xE7);
@@ -394,42 +549,50 @@ void scheduled_si7021_writeReg_cb (void){
  * @note
  * Is used several times during the TDD function
 
+ *
+ * @param[in] record
+ *   Record posted by the I2C state machine, the payload holds the raw reading
  *
  ******************************************************************************/
-void scheduled_si7021_readReg_cb (void){
-	EFM_ASSERT(get_scheduled_events() & (Si7021_Read_Reg_CB));
-	remove_scheduled_event(Si7021_Read_Reg_CB);
+void scheduled_si7021_readReg_cb (const SCHEDULER_RECORD *record){
+	EFM_ASSERT(record->event == Si7021_Read_Reg_CB);
 	int uReg;
-	uReg = si7021_return_uReg();
+	uReg = record->payload;
 	EFM_ASSERT(uReg == 59);
-	add_scheduled_event(BOOT_UP_CB);
+	//boot up runs once, so it is queued as work rather than given an event
+	work_submit(app_boot_up, NULL);
 
 }
 
 
 /***************************************************************************//**
  * @brief
- * Handles the boot_up_cb event
+ * Finishes start up
  *
  *
  * @details
  * This event runs the ble_test if BLE_TEST_ENABLED is defined. It then runs the
- * circular buffer test. After the tests are complete the function then starts the
- * letimer. It runs only once on startup.
+ * circular buffer test. After the tests are complete the function then starts
+ * sampling. It runs only once on startup, submitted to the work queue by the
+ * si7021 read register handler once the sensor configuration has been checked.
  *
  *
  * @note
- * letimer_start has been moved to this function to ensure that all the peripherals
- * have been configured correctly before interrupts begin occurring.
+ * The letimer is already running for the start up delays, so sampling is only
+ * enabled here to ensure that all the peripherals have been configured correctly
+ * before the first read. As before the coroutine rework, the first sample is
+ * taken on the next underflow, by which time the VEML6030 has finished its
+ * first integration.
+ *
+ * @param[in] ctx
+ *   Not used
 
  *
  ******************************************************************************/
-void scheduled_boot_up_cb (void){
+void app_boot_up (void *ctx){
+	(void)ctx;
 
 
-	EFM_ASSERT(get_scheduled_events() & BOOT_UP_CB);
-	remove_scheduled_event(BOOT_UP_CB);
-
 	//letimer_start(LETIMER0, true);   // letimer_start will inform the LETIMER0 peripheral to begin counting.
 
 	#ifdef BLE_TEST_ENABLED
@@ -446,7 +609,11 @@ void scheduled_boot_up_cb (void){
 	ble_write("James Brennan\n");
 
 
-	letimer_start(LETIMER0, true);   // letimer_start will inform the LETIMER0 peripheral to begin counting.
+	app_sampling = true;
+	#ifdef APP_HIBERNATE_ENABLED
+	//already passed, so the first underflow starts the wake-up grid
+	app_retained.next_sample = rtcc_timestamp() - APP_SAMPLE_COUNTS;
+	#endif
 
 }
 
@@ -468,7 +635,7 @@ void scheduled_boot_up_cb (void){
  ******************************************************************************/
 
 void scheduled_ble_tx_done_cb (void){
-	EFM_ASSERT(get_scheduled_events() & BLE_TX_DONE_CB);
+	EFM_ASSERT(check_scheduled_event(BLE_TX_DONE_CB));
 	remove_scheduled_event(BLE_TX_DONE_CB);
 
 	ble_circ_pop(CIRC_OPER);
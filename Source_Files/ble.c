@@ -303,6 +303,24 @@ void ble_write(char* string){
 
 }
 
+/***************************************************************************//**
+ * @brief
+ *
+ * Returns true once everything written to the bluetooth module has gone out
+ *
+ * @details
+ * the circular buffer only holds a few lines, so long output such as the trace
+ * dump must wait for this before each write
+ *
+ ******************************************************************************/
+
+
+bool ble_tx_idle(void){
+
+	return (ble_circ_space() == CSIZE) && !leuart_tx_busy(LEUART0);
+
+}
+
 /***************************************************************************//**
  * @brief
  *   BLE Test performs two functions.  First, it is a Test Driven Development
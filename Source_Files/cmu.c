@@ -70,6 +70,9 @@ void cmu_open(void){
 		//route
 		CMU_ClockSelectSet(cmuClock_LFB, cmuSelect_LFXO);
 
+		// Route the LFXO to the LFE clock tree for the RTCC timestamp counter
+		CMU_ClockSelectSet(cmuClock_LFE, cmuSelect_LFXO);
+
 		// Now, you must ensure that the global Low Frequency is enabled
 		CMU_ClockEnable(cmuClock_CORELE, true);	//This enumeration is found in the Lab 2 assignment
 
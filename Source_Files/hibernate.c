@@ -0,0 +1,210 @@
+/**
+ * @file hibernate.c
+ * @author James Brennan
+ * @date October 16th, 2026
+ * @brief EM4H between samples, with a small state kept in the RTCC retention
+ * registers.
+ *
+ */
+
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+
+//** Standard Libraries
+#include <string.h>
+
+//** Silicon Lab include files
+
+//** User/developer include files
+#include "hibernate.h"
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+
+
+//***********************************************************************************
+// Private variables
+//***********************************************************************************
+//reset causes found by hibernate_open(), the RMU register is cleared for the next reset
+static uint32_t hibernate_cause;
+
+
+//***********************************************************************************
+// Private functions
+//***********************************************************************************
+
+/***************************************************************************//**
+ * @brief
+ *   Checksum of the size word and the state words in the retention registers
+ *
+ * @param[in] words
+ *   Number of state words to include
+ *
+ ******************************************************************************/
+
+static uint32_t hibernate_checksum(uint32_t words){
+	uint32_t sum = HIBERNATE_MAGIC ^ RTCC_RetentionRegGet(HIBERNATE_REG_SIZE);
+
+	for(uint32_t i = 0; i < words; i++){
+		sum = ((sum << 5) | (sum >> 27)) ^ RTCC_RetentionRegGet(HIBERNATE_REG_STATE + i);
+	}
+	return sum;
+}
+
+
+//***********************************************************************************
+// Global functions
+//***********************************************************************************
+
+/***************************************************************************//**
+ * @brief
+ *   Opens the hibernate mode
+ *
+ * @details
+ * 	 Reads and clears the reset cause, then sets EM4 up as EM4H with the
+ * 	 LFXO retained, so the RTCC keeps counting to the wake-up, and with the
+ * 	 pins latched, so the si7021 enable pin keeps the sensor powered and
+ * 	 configured while the chip is off.
+ *
+ * 	 The CORELE clock is enabled here as hibernate_warm_boot() reads the
+ * 	 RTCC before cmu_open() has run.
+ *
+ * @note
+ *   Should be called once at the start of main(), before the warm or cold
+ *   start up is chosen
+ *
+ ******************************************************************************/
+
+void hibernate_open(void){
+	EMU_EM4Init_TypeDef em4_init = EMU_EM4INIT_DEFAULT;
+
+	hibernate_cause = RMU_ResetCauseGet();
+	RMU_ResetCauseClear();
+
+	CMU_ClockEnable(cmuClock_CORELE, true);
+
+	em4_init.em4State = emuEM4Hibernate;
+	em4_init.retainLfxo = true;
+	em4_init.pinRetentionMode = emuPinRetentionLatch;
+	EMU_EM4Init(&em4_init);
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Returns true if the chip woke from EM4H with a valid retained state
+ *
+ * @details
+ * 	 Any other reset, or retention registers that fail the check, means a
+ * 	 cold start.
+ *
+ ******************************************************************************/
+
+bool hibernate_warm_boot(void){
+	uint32_t size;
+
+	if(!(hibernate_cause & RMU_RSTCAUSE_EM4RST)){
+		return false;
+	}
+	if(RTCC_RetentionRegGet(HIBERNATE_REG_MAGIC) != HIBERNATE_MAGIC){
+		return false;
+	}
+	size = RTCC_RetentionRegGet(HIBERNATE_REG_SIZE);
+	if(size > HIBERNATE_STATE_MAX){
+		return false;
+	}
+	return RTCC_RetentionRegGet(HIBERNATE_REG_CHECK) == hibernate_checksum((size + 3) / 4);
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Copies the retained state out and disarms the wake-up
+ *
+ * @details
+ * 	 The magic word is cleared, so the state is only used once.
+ *
+ * @param[out] state
+ *   Receives the state
+ *
+ * @param[in] size
+ *   Size of the state in bytes, it must match the size it was saved with
+ *
+ * @return
+ *   true if a valid state of that size was retained
+ *
+ ******************************************************************************/
+
+bool hibernate_restore(void *state, uint32_t size){
+	uint32_t word;
+
+	if(!hibernate_warm_boot() || RTCC_RetentionRegGet(HIBERNATE_REG_SIZE) != size){
+		return false;
+	}
+	for(uint32_t i = 0; i < size; i += sizeof(word)){
+		word = RTCC_RetentionRegGet(HIBERNATE_REG_STATE + i / sizeof(word));
+		memcpy((uint8_t *)state + i, &word, (size - i < sizeof(word)) ? size - i : sizeof(word));
+	}
+	RTCC_RetentionRegSet(HIBERNATE_REG_MAGIC, 0);
+	rtcc_wakeup_clear();
+	return true;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Hands the pins latched through EM4H back to the GPIO
+ *
+ * @note
+ *   Must be called after gpio_open() on every start up, warm or cold, or
+ *   the pins keep the state they had when the chip hibernated
+ *
+ ******************************************************************************/
+
+void hibernate_pins_release(void){
+	EMU_UnlatchPinRetention();
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Saves the state and enters EM4H until the RTCC reaches wake_at
+ *
+ * @details
+ * 	 Everything but the RTCC, its retention registers and the latched pins
+ * 	 is powered down, so leaving EM4H is a reset. The chip starts from
+ * 	 main() again and hibernate_warm_boot() finds the state. The magic word
+ * 	 is written last, so a reset part way through leaves no valid state.
+ *
+ * @note
+ *   Does not return. The caller must check that nothing is in flight, as
+ *   the peripherals, the RAM and the pending events are all lost.
+ *
+ * @param[in] state
+ *   State to keep, at most HIBERNATE_STATE_MAX bytes
+ *
+ * @param[in] size
+ *   Size of the state in bytes
+ *
+ * @param[in] wake_at
+ *   RTCC count to wake up at, it must be ahead of the counter
+ *
+ ******************************************************************************/
+
+void hibernate_enter(const void *state, uint32_t size, uint32_t wake_at){
+	uint32_t word;
+
+	EFM_ASSERT(size <= HIBERNATE_STATE_MAX);
+
+	RTCC_RetentionRegSet(HIBERNATE_REG_MAGIC, 0);
+	RTCC_RetentionRegSet(HIBERNATE_REG_SIZE, size);
+	for(uint32_t i = 0; i < size; i += sizeof(word)){
+		word = 0;
+		memcpy(&word, (const uint8_t *)state + i, (size - i < sizeof(word)) ? size - i : sizeof(word));
+		RTCC_RetentionRegSet(HIBERNATE_REG_STATE + i / sizeof(word), word);
+	}
+	RTCC_RetentionRegSet(HIBERNATE_REG_CHECK, hibernate_checksum((size + 3) / 4));
+	RTCC_RetentionRegSet(HIBERNATE_REG_MAGIC, HIBERNATE_MAGIC);
+
+	rtcc_wakeup_at(wake_at);
+	EMU_EnterEM4H();
+}
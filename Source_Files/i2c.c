@@ -12,25 +12,59 @@
 //***********************************************************************************
 
 //** Standard Libraries
+#include <string.h>
+#include <stdio.h>
 
 //** Silicon Lab include files
 
 //** User/developer include files
 #include "i2c.h"
+#include "ble.h"
 
 //***********************************************************************************
 // defined files
 //***********************************************************************************
-enum state{Call, sendCommand, Read, MS, LS, MStop, WriteDone, writeLSB, writeMSB};
-//enum I2C{I2C_0, I2C_1};
+//states of the transfer engine
+enum i2c_state{I2C_IDLE, I2C_RESET, I2C_ADDR_WRITE, I2C_WRITE, I2C_ADDR_READ, I2C_READ, I2C_STOP, I2C_LDMA,
+	I2C_RELEASE, I2C_BACKOFF, I2C_STATE_COUNT};
+//interrupts that move it on, a bus error is handled before the others
+enum i2c_event{I2C_ON_ACK, I2C_ON_NACK, I2C_ON_RXDATAV, I2C_ON_MSTOP, I2C_ON_BITO, I2C_ON_ERROR, I2C_EVENT_COUNT};
+
+//interrupts that end a try of a transfer
+#define I2C_IF_ERRORS			(I2C_IF_CLTO | I2C_IF_ARBLOST | I2C_IF_BUSERR)
+
+typedef void (*I2C_ACTION)(I2C_BUS *bus);
+
+#define I2C_QUEUE_MASK			(I2C_QUEUE_SIZE - 1)
+
+_Static_assert((I2C_QUEUE_SIZE & I2C_QUEUE_MASK) == 0, "I2C_QUEUE_SIZE must be a power of two");
 
 
 //***********************************************************************************
 // Private variables
 //***********************************************************************************
 
-static I2C_STATE_MACHINE i2c0_State;
-static I2C_STATE_MACHINE i2c1_State;
+//resources of each peripheral, a bus is added with a line here and its vector below
+static const I2C_INSTANCE i2c_instances[I2C_COUNT] = {
+	{ I2C0, cmuClock_I2C0, I2C0_IRQn, SLEEP_OWNER_I2C0, I2C0_RETRY_CB,
+			I2C0_LDMA_TX_CH, I2C0_LDMA_RX_CH, ldmaPeripheralSignal_I2C0_TXBL, ldmaPeripheralSignal_I2C0_RXDATAV },
+	{ I2C1, cmuClock_I2C1, I2C1_IRQn, SLEEP_OWNER_I2C1, I2C1_RETRY_CB,
+			I2C1_LDMA_TX_CH, I2C1_LDMA_RX_CH, ldmaPeripheralSignal_I2C1_TXBL, ldmaPeripheralSignal_I2C1_RXDATAV },
+};
+
+//context of each bus, in the same order
+static I2C_BUS i2c_buses[I2C_COUNT];
+
+//transaction counters, filled in the order each kind is first seen. Only
+//written by the I2C interrupt handlers, which do not preempt each other.
+static I2C_STATS i2c_stats[I2C_STATS_SIZE];
+static uint32_t i2c_stats_used;
+static uint32_t i2c_stats_untracked;
+
+//position of the BLE summary
+static bool stats_busy;
+static bool stats_started;
+static uint32_t stats_next;
 
 //***********************************************************************************
 // Private functions
@@ -38,250 +72,669 @@ static I2C_STATE_MACHINE i2c1_State;
 
 /***************************************************************************//**
  * @brief
- *   Function to reset the I2C bus
+ *   Returns the bus of an I2C peripheral
  *
  * @details
- * 	 This routine is a low level driver.  The application code calls this function
- * 	 to reset the bus before enabling interupts
+ * 	 Only called when a bus is opened or a transfer is started, the
+ * 	 interrupt handlers already know their bus
  *
  *
  * @param[in] i2c
- *   Pointer to the base peripheral address of the I2C peripheral being opened
+ *   Pointer to the base peripheral address of the I2C peripheral
+ *
+ *
+ ******************************************************************************/
+
+static I2C_BUS *i2c_bus(I2C_TypeDef *i2c){
+	for(uint32_t n = 0; n < I2C_COUNT; n++){
+		if(i2c_instances[n].i2c == i2c){
+			return &i2c_buses[n];
+		}
+	}
+	EFM_ASSERT(false);
+	return &i2c_buses[0];
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Function to reset the I2C bus
+ *
+ * @details
+ * 	 This routine is a low level driver.  It is called when a bus is opened
+ * 	 and before a transfer is retried after a bus error. The START and STOP
+ * 	 written together make the slaves drop whatever they were doing. The
+ * 	 MSTOP interrupt ends the reset, so nothing waits on the bus here. If
+ * 	 the bus is stuck, CLTO ends it instead.
+ *
+ *
+ * @param[in] bus
+ *   Bus to reset, the caller holds its EM2 block
  *
  *
  ******************************************************************************/
 
-void static i2c_bus_reset(I2C_TypeDef *i2c){
-	uint32_t savestate;
+static void i2c_bus_reset(I2C_BUS *bus){
 	//resting the i2c state machine
-	i2c->CMD = I2C_CMD_ABORT;
+	bus->i2c->CMD = I2C_CMD_ABORT;
 
-	//saving the state of IEN register
-	savestate = i2c->IEN;
+	//clear the transmit buffer and any flags left from before
+	bus->i2c->CMD = I2C_CMD_CLEARTX;
+	bus->i2c->IFC = _I2C_IF_MASK;
 
-	//disabling interrupts
-	i2c->IEN = ~i2c->IEN;
+	////Perform reset by writing to the start and stop bits simultaneously
+	bus->state = I2C_RESET;
+	bus->i2c->CMD = I2C_CMD_START | I2C_CMD_STOP;
+}
 
-	//clearing all interrupts
-	i2c->IFC = savestate;
+/***************************************************************************//**
+ * @brief
+ *   Sets a bus up to move its bytes by LDMA
+ *
+ * @details
+ * 	 Each bus has a channel for TXDATA, requested by TXBL, and one for
+ * 	 RXDATA, requested by RXDATAV. AUTOACK lets the master ACK each byte
+ * 	 the receive channel reads without the CPU.
+ *
+ ******************************************************************************/
 
+#ifdef I2C_LDMA_ENABLED
+static void i2c_ldma_open(I2C_BUS *bus){
+	static bool ldma_ready;
+	LDMA_Init_t ldma_init = LDMA_INIT_DEFAULT;
 
-	//clear the transmit buffer
+	if(!ldma_ready){
+		LDMA_Init(&ldma_init);
+		ldma_ready = true;
+	}
 
-	i2c->CMD = I2C_CMD_CLEARTX;
+	bus->i2c->CTRL |= I2C_CTRL_AUTOACK;
+	bus->ldma = true;
+}
+#endif
 
-	////Perform reset by writing to the start and stop bits simultaneously
-	i2c->CMD = I2C_CMD_START | I2C_CMD_STOP;
+/***************************************************************************//**
+ * @brief
+ *   Puts a transfer on the bus with the LDMA
+ *
+ * @details
+ * 	 The transmit list sends the write address and the bytes to write, then
+ * 	 either queues the STOP or the repeated START and the read address. Its
+ * 	 command writes wait for TXBL, so they only take effect once the byte
+ * 	 before them has left the buffer. The receive list reads all but the
+ * 	 last byte, queues NACK and STOP once the last byte is in, then reads
+ * 	 it. The CPU takes the MSTOP interrupt at the end, and a NACK.
+ *
+ * 	 The firmware has no LDMA interrupt handler. The descriptors raise no
+ * 	 DONE flags, and the channel interrupts LDMA_StartTransfer() enables are
+ * 	 masked again.
+ *
+ * 	 A transfer resumed at its read address only sends that.
+ *
+ *
+ * @param[in] bus
+ *   Bus whose active transfer is started, the bus must be idle
+ *
+ ******************************************************************************/
 
+static void i2c_ldma_start(I2C_BUS *bus){
+	I2C_TRANSFER *transfer = &bus->active;
+	bool read = (bus->resume == I2C_ADDR_READ);
+	LDMA_TransferCfg_t tx_cfg = LDMA_TRANSFER_CFG_PERIPHERAL(bus->instance->tx_signal);
+	LDMA_TransferCfg_t rx_cfg = LDMA_TRANSFER_CFG_PERIPHERAL(bus->instance->rx_signal);
+	uint8_t *rx = (transfer->rx != NULL) ? transfer->rx : bus->rx_buf;
+	uint32_t cmd;
 
+	bus->tx_buf[0] = transfer->address << 1;
+	memcpy(&bus->tx_buf[1], transfer->write, transfer->write_len);
+	bus->read_address = (transfer->address << 1) | 1;
 
-	//stalling while reset is finished
-	while(!(i2c->IF & I2C_IF_MSTOP));
+	if(read){
+		bus->tx_desc[0] = (LDMA_Descriptor_t)LDMA_DESCRIPTOR_SINGLE_M2P_BYTE(&bus->read_address, &bus->i2c->TXDATA, 1);
+	}
+	else{
+		cmd = (transfer->read_len != 0) ? I2C_CMD_START : I2C_CMD_STOP;
+		bus->tx_desc[0] = (LDMA_Descriptor_t)LDMA_DESCRIPTOR_LINKREL_M2P_BYTE(bus->tx_buf, &bus->i2c->TXDATA, transfer->write_len + 1, 1);
+		bus->tx_desc[1] = (LDMA_Descriptor_t)LDMA_DESCRIPTOR_LINKREL_WRITE(cmd, &bus->i2c->CMD, 1);
+		bus->tx_desc[1].wri.structReq = false;		//wait for the last byte to leave the buffer
+		bus->tx_desc[1].wri.link = (transfer->read_len != 0);
+		bus->tx_desc[2] = (LDMA_Descriptor_t)LDMA_DESCRIPTOR_SINGLE_M2P_BYTE(&bus->read_address, &bus->i2c->TXDATA, 1);
+	}
 
-	//clearing all interrupts
-	i2c->IFC = i2c->IF;
+	if(transfer->read_len != 0){
+		if(transfer->read_len > 1){
+			bus->rx_desc[0] = (LDMA_Descriptor_t)LDMA_DESCRIPTOR_LINKREL_P2M_BYTE(&bus->i2c->RXDATA, rx, transfer->read_len - 1, 1);
+		}
+		bus->rx_desc[1] = (LDMA_Descriptor_t)LDMA_DESCRIPTOR_LINKREL_WRITE(I2C_CMD_NACK | I2C_CMD_STOP, &bus->i2c->CMD, 1);
+		bus->rx_desc[1].wri.structReq = false;		//wait for the last byte to come in
+		bus->rx_desc[2] = (LDMA_Descriptor_t)LDMA_DESCRIPTOR_SINGLE_P2M_BYTE(&bus->i2c->RXDATA, &rx[transfer->read_len - 1], 1);
+	}
+
+	for(uint32_t i = 0; i < sizeof(bus->tx_desc) / sizeof(bus->tx_desc[0]); i++){
+		bus->tx_desc[i].xfer.doneIfs = 0;
+		bus->rx_desc[i].xfer.doneIfs = 0;
+	}
+	if(transfer->read_len != 0){
+		LDMA_StartTransfer(bus->instance->rx_ch, &rx_cfg, &bus->rx_desc[(transfer->read_len > 1) ? 0 : 1]);
+	}
+
+	bus->state = I2C_LDMA;
+	bus->i2c->CMD        = I2C_CMD_START;       //Start CMD
+	LDMA_StartTransfer(bus->instance->tx_ch, &tx_cfg, bus->tx_desc);
+	LDMA->IEN &= ~((1UL << bus->instance->tx_ch) | (1UL << bus->instance->rx_ch));
+}
 
+/***************************************************************************//**
+ * @brief
+ *   Sends the active transfer from where it resumes
+ *
+ * @details
+ * 	 Sends the START and the slave address, for a write if the transfer has
+ * 	 bytes to write and for a read otherwise. A transfer whose read address
+ * 	 was NACKed after its bytes were written is resumed at the read address.
+ * 	 The transition table takes the transfer on from there.
+ *
+ *
+ * @param[in] bus
+ *   Bus whose active transfer is sent, the bus must be idle
+ *
+ ******************************************************************************/
 
-	//restoring the IEN
+static void i2c_transfer_send(I2C_BUS *bus){
+	I2C_TRANSFER *transfer = &bus->active;
+	bool read = (bus->resume == I2C_ADDR_READ);
 
-	i2c->IEN = savestate;
+	EFM_ASSERT((bus->i2c->STATE & _I2C_STATE_STATE_MASK) == I2C_STATE_STATE_IDLE);
 
-	//resting the i2c state machine
-	i2c->CMD = I2C_CMD_ABORT;
+	bus->tx_pos = 0;
+	bus->rx_pos = 0;
+	bus->result = 0;
+	bus->status = I2C_OK;
+	if(bus->ldma){
+		i2c_ldma_start(bus);
+		return;
+	}
+	bus->state = bus->resume;
+	bus->i2c->CMD        = I2C_CMD_START;       //Start CMD
+	bus->i2c->TXDATA     = (transfer->address<<1)|(read); //Loading address
 }
 
 /***************************************************************************//**
  * @brief
- *   Function handle the ACK interrupt
+ *   Puts a transfer on the bus
  *
  * @details
- * 	 This routine is part of the I2C state machine, it handles the ACK interrupt and
- * 	 all relevant state transitions.
+ * 	 The bus blocks EM2 while a transfer is on it, but not while the
+ * 	 transfer waits in the queue or backs off before a retry
  *
  *
- * @param[in] i2cState
- *   Pointer to the STRUCT which handles the state machine
+ * @param[in] bus
+ *   Bus whose active transfer is started, the bus must be idle
  *
+ ******************************************************************************/
+
+static void i2c_transfer_start(I2C_BUS *bus){
+	I2C_TRANSFER *transfer = &bus->active;
+
+	bus->attempts = 0;
+	bus->nacks = 0;
+	bus->started = rtcc_timestamp();
+	bus->resume = (transfer->write_len == 0 && transfer->read_len != 0) ? I2C_ADDR_READ : I2C_ADDR_WRITE;
+	sleep_block_mode(EM2, bus->instance->owner);
+	i2c_transfer_send(bus);
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Releases the bus's EM2 block and starts the oldest queued transfer
  *
  ******************************************************************************/
 
+static void i2c_next(I2C_BUS *bus){
+	sleep_unblock_mode(EM2, bus->instance->owner);
+	bus->state = I2C_IDLE;
+	bus->resume = I2C_IDLE;
 
-void static i2c_ACK_fun(I2C_STATE_MACHINE *i2cState){
-	switch(i2cState->STATE){
-		case Call:{
-			i2cState->i2c->TXDATA  = i2cState->Command; //sends the command to the peripheral
-			i2cState->STATE = sendCommand;
-			if(i2cState->Command == Veml_WRITE){     //in the case of turning on the veml, the state machine re-directs
-				i2cState->STATE = writeLSB;
-				break;
-			}
-			else{
-			break;
-			}
-		}
-		case sendCommand:{
-			if((i2cState->Command == READ_TEMP) || (i2cState->Command == READ_HUM) || (i2cState->Command == READ_REG) || (i2cState->Command == Veml_READ)){
-				i2cState->i2c->CMD        = I2C_CMD_START;       //Start CMD
-				i2cState->i2c->TXDATA     = (i2cState->slaveAddress<<1)|(true); //Address + read command
-				i2cState->STATE = Read;
-			}
-			else if(i2cState->Command ==  WRITE_REG){
-				i2cState->i2c->TXDATA   = i2cState->writeData;
-				i2cState->STATE = WriteDone;
-			}
-			break;
-		}
-		case Read:{
-			if(i2cState->Command == Veml_READ){ //handles the correct order of reads for the  veml vs si7021
-				i2cState->STATE = LS;
-			}
-			else{
-			i2cState->STATE = MS;
-			}
+	if(bus->tail != bus->head){
+		bus->active = bus->queue[bus->tail & I2C_QUEUE_MASK];
+		bus->tail = bus->tail + 1;
+		i2c_transfer_start(bus);
+	}
+	else{
+		bus->busy = false;
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Adds a finished transfer to the counters of its kind
+ *
+ * @details
+ * 	 Transfers are told apart by bus, slave address and the first byte
+ * 	 written, which is the command or register of every device on the
+ * 	 board. A kind first seen once the table is full is only counted as
+ * 	 untracked.
+ *
+ ******************************************************************************/
+
+static void i2c_stats_record(I2C_BUS *bus){
+	I2C_TRANSFER *transfer = &bus->active;
+	uint32_t index = bus - i2c_buses;
+	uint32_t command = (transfer->write_len != 0) ? transfer->write[0] : I2C_STATS_NO_COMMAND;
+	uint32_t ticks = rtcc_timestamp() - bus->started;
+	I2C_STATS *stats = NULL;
+
+	for(uint32_t i = 0; i < i2c_stats_used; i++){
+		if(i2c_stats[i].bus == index && i2c_stats[i].address == transfer->address && i2c_stats[i].command == command){
+			stats = &i2c_stats[i];
 			break;
 		}
-		case WriteDone:{
-			i2cState->i2c->CMD  = I2C_CMD_STOP;
-			i2cState->STATE = MStop;
-			break;
+	}
+	if(stats == NULL){
+		if(i2c_stats_used == I2C_STATS_SIZE){
+			i2c_stats_untracked++;
+			return;
 		}
-		case writeLSB:{
-			i2cState->i2c->TXDATA   = i2cState->writeData;         //this and the following case handles the two byte writes
-			i2cState->STATE = writeMSB;							   //required for the veml.
-			break;
+		stats = &i2c_stats[i2c_stats_used++];
+		*stats = (I2C_STATS){ .bus = index, .address = transfer->address, .command = command };
+	}
+
+	stats->count++;
+	stats->nack_retries += bus->nacks;
+	stats->error_retries += bus->attempts - bus->nacks;
+	if(bus->status != I2C_OK){
+		stats->failed++;
+	}
+	else{
+		stats->bytes += transfer->write_len + transfer->read_len;
+	}
+	stats->ticks += ticks;
+	if(ticks > stats->max_ticks){
+		stats->max_ticks = ticks;
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Hands a finished transfer to its caller and starts the next
+ *
+ * @details
+ * 	 The result is handed to the scheduler with the transfer's event, then
+ * 	 the oldest queued transfer goes out straight away, without waiting for
+ * 	 the main loop. A transfer that failed still posts its event, with 0 as
+ * 	 the payload and its I2C_STATUS as the record's status, so the caller is
+ * 	 never left waiting.
+ *
+ ******************************************************************************/
+
+static void i2c_complete(I2C_BUS *bus){
+	I2C_TRANSFER *transfer = &bus->active;
+
+	if(bus->status != I2C_OK){
+		bus->result = 0;
+	}
+	else if(transfer->data != NULL){
+		*(transfer->data) = bus->result;
+	}
+	if(transfer->status != NULL){
+		*(transfer->status) = bus->status;
+	}
+	i2c_stats_record(bus);
+	scheduler_post(transfer->event, bus->result, bus->status);
+	i2c_next(bus);
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Takes the transfer off the bus until its retry timer expires
+ *
+ * @details
+ * 	 The wait doubles with each retry, and the bus releases its EM2 block
+ * 	 so the node can sleep through it. The LETIMER software timer posts
+ * 	 the bus's retry event when it expires. Once the retries are used up
+ * 	 the transfer completes with the reason of its last failure.
+ *
+ ******************************************************************************/
+
+static void i2c_backoff(I2C_BUS *bus){
+	uint32_t ms = I2C_BACKOFF_MS << bus->attempts;
+
+	if(bus->attempts == I2C_RETRY_MAX){
+		i2c_complete(bus);
+		return;
+	}
+	bus->attempts++;
+	if(bus->status == I2C_NACK_TIMEOUT){
+		bus->nacks++;
+	}
+	bus->state = I2C_BACKOFF;
+	sleep_unblock_mode(EM2, bus->instance->owner);
+	letimer_timer_start(bus->instance->retry_event, (ms < I2C_BACKOFF_MAX_MS) ? ms : I2C_BACKOFF_MAX_MS, false);
+}
+
+/***************************************************************************//**
+ * @brief
+ *   The backoff timer expired, sends the transfer again
+ *
+ * @details
+ * 	 After a bus error the bus is reset first and the transfer is sent
+ * 	 when the reset's MSTOP comes in. After a NACK it is sent straight
+ * 	 away.
+ *
+ * @note
+ *   Called from the retry event handlers, in the main loop
+ *
+ ******************************************************************************/
+
+static void i2c_retry(I2C_BUS *bus){
+	CORE_DECLARE_IRQ_STATE;
+	CORE_ENTER_CRITICAL();
+
+	if(bus->state == I2C_BACKOFF){
+		sleep_block_mode(EM2, bus->instance->owner);
+		if(bus->status == I2C_BUS_ERROR){
+			i2c_bus_reset(bus);
 		}
-		case writeMSB:{
-				i2cState->i2c->TXDATA   = (i2cState->writeData);
-				i2cState->STATE = WriteDone;
-				break;
+		else{
+			i2c_transfer_send(bus);
 		}
-
-		default:
-			EFM_ASSERT(false);
-			break;
 	}
 
+	CORE_EXIT_CRITICAL();
 }
 
 /***************************************************************************//**
  * @brief
- *   Function handle the NACK interrupt
+ *   The reset's STOP has gone out
  *
  * @details
- * 	 This routine is part of the I2C state machine, it handles the NACK interrupt and
- * 	 all relevant state transitions.
+ * 	 A transfer retried after a bus error is sent now. The reset of
+ * 	 i2c_open() has no transfer, it lets the first queued one go.
+ *
+ ******************************************************************************/
+
+static void i2c_reset_done(I2C_BUS *bus){
+	if(bus->resume != I2C_IDLE){
+		i2c_transfer_send(bus);
+	}
+	else{
+		i2c_next(bus);
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Interrupt that needs nothing done
  *
+ * @details
+ * 	 BITO: the bus was seen busy without a STOP for too long and GIBITO
+ * 	 has already freed it. A START waiting for the bus goes out by itself.
  *
- * @param[in] i2cState
- *   Pointer to the STRUCT which handles the state machine
+ ******************************************************************************/
+
+static void i2c_ignore(I2C_BUS *bus){
+	(void)bus;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   The bus failed, or an interrupt came that cannot happen in this state
  *
+ * @details
+ * 	 CLTO, a lost arbitration and a misplaced START or STOP all end up
+ * 	 here. The transfer's channels are stopped and the I2C is aborted, so
+ * 	 nothing is left driving the bus, then the transfer backs off and is
+ * 	 retried after a reset. A reset that fails is abandoned, the abort
+ * 	 alone leaves the I2C idle. A stray flag with no transfer on the bus
+ * 	 is just cleared.
  *
  ******************************************************************************/
 
-void static i2c_NACK_fun(I2C_STATE_MACHINE *i2cState){
-	switch(i2cState->STATE){
-		case Read:{
-			i2cState->i2c->CMD        = I2C_CMD_START;       //Start CMD
-			i2cState->i2c->TXDATA     = (i2cState->slaveAddress<<1)|(true); //Address + read command
+static void i2c_bus_error(I2C_BUS *bus){
+	if(bus->ldma){
+		LDMA_StopTransfer(bus->instance->tx_ch);
+		LDMA_StopTransfer(bus->instance->rx_ch);
+	}
+	bus->i2c->CMD = I2C_CMD_ABORT;
+	bus->i2c->CMD = I2C_CMD_CLEARTX;
+	bus->i2c->IFC = _I2C_IF_MASK;
+
+	switch(bus->state){
+		case I2C_IDLE:
+		case I2C_BACKOFF:
 			break;
-		}
-		case Call:{
-			i2cState->i2c->CMD        = I2C_CMD_START;       //Start CMD
-			i2cState->i2c->TXDATA     = (i2cState->slaveAddress<<1)|(false); //Loading address write
+		case I2C_RESET:
+			i2c_reset_done(bus);
 			break;
-		}
 		default:
-			EFM_ASSERT(false);
+			bus->status = I2C_BUS_ERROR;
+			bus->resume = (bus->active.write_len == 0 && bus->active.read_len != 0) ? I2C_ADDR_READ : I2C_ADDR_WRITE;
+			i2c_backoff(bus);
 			break;
 	}
+}
+
+/***************************************************************************//**
+ * @brief
+ *   The slave took the address or the last byte, sends what comes next
+ *
+ * @details
+ * 	 The next byte of the write buffer, then a repeated START with the read
+ * 	 address if the transfer reads, else the STOP
+ *
+ ******************************************************************************/
 
+static void i2c_write_next(I2C_BUS *bus){
+	I2C_TRANSFER *transfer = &bus->active;
+
+	if(bus->tx_pos < transfer->write_len){
+		bus->i2c->TXDATA = transfer->write[bus->tx_pos++];
+		bus->state = I2C_WRITE;
+	}
+	else if(transfer->read_len != 0){
+		bus->i2c->CMD        = I2C_CMD_START;       //repeated START
+		bus->i2c->TXDATA     = (transfer->address<<1)|(true); //Address + read command
+		bus->state = I2C_ADDR_READ;
+	}
+	else{
+		bus->i2c->CMD  = I2C_CMD_STOP;
+		bus->state = I2C_STOP;
+	}
 }
 
 /***************************************************************************//**
  * @brief
- *   Function handle the RXDATAV interrupt
+ *   The slave did not answer, lets go of the bus before trying again
  *
  * @details
- * 	 This routine is part of the I2C state machine, it handles the RXDATAV interrupt and
- * 	 all relevant state transitions.
+ * 	 A busy slave, e.g. the si7021 during a conversion, NACKs its read
+ * 	 address until it is ready, so the transfer resumes there. A refused
+ * 	 write address or data byte sends the whole transfer again. The STOP's
+ * 	 MSTOP starts the backoff.
  *
+ ******************************************************************************/
+
+static void i2c_nack(I2C_BUS *bus){
+	bus->status = I2C_NACK_TIMEOUT;
+	bus->resume = (bus->state == I2C_ADDR_READ) ? I2C_ADDR_READ : I2C_ADDR_WRITE;
+	bus->i2c->CMD  = I2C_CMD_STOP;
+	bus->state = I2C_RELEASE;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   The slave took the read address, its first byte follows
  *
- * @param[in] i2cState
- *   Pointer to the STRUCT which handles the state machine
+ ******************************************************************************/
+
+static void i2c_read_begin(I2C_BUS *bus){
+	bus->state = I2C_READ;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Adds a received byte to the result
  *
+ * @details
+ * 	 The first four bytes make up the result in the transfer's byte order
  *
  ******************************************************************************/
-void static i2c_RXDATAV_fun(I2C_STATE_MACHINE *i2cState){
-	switch(i2cState->STATE){
-		case MS:{
-		if((i2cState->Command == READ_TEMP) || (i2cState->Command == READ_HUM)){
-		*(i2cState->Data) = i2cState->i2c->RXDATA<<8;
-		i2cState->STATE = LS;
-		i2cState->i2c->CMD  = I2C_CMD_ACK;
-		}
-		else if(i2cState->Command == READ_REG){
-			*(i2cState->Data) = i2cState->i2c->RXDATA;
-			i2cState->STATE = MStop;
-			i2cState->i2c->CMD  = I2C_CMD_NACK;
-			i2cState->i2c->CMD  = I2C_CMD_STOP;
-		}
-		else if(i2cState->Command == Veml_READ){
-			*(i2cState->Data) |= i2cState->i2c->RXDATA<<8;
-			i2cState->STATE = MStop;
-			i2cState->i2c->CMD  = I2C_CMD_NACK;
-			i2cState->i2c->CMD  = I2C_CMD_STOP;
-		}
-		break;
-		}
-		case LS:{
-		if(i2cState->Command == Veml_READ){
-			*(i2cState->Data) |= i2cState->i2c->RXDATA;
-			i2cState->STATE = MS;
-			i2cState->i2c->CMD  = I2C_CMD_ACK;
+
+static void i2c_result_byte(I2C_BUS *bus, uint8_t byte){
+	if(bus->rx_pos < sizeof(bus->result)){
+		if(bus->active.order == I2C_MSB_FIRST){
+			bus->result = (bus->result << 8) | byte;
 		}
 		else{
-			*(i2cState->Data) |= i2cState->i2c->RXDATA;
-			i2cState->STATE = MStop;
-			i2cState->i2c->CMD  = I2C_CMD_NACK;
-			i2cState->i2c->CMD  = I2C_CMD_STOP;
+			bus->result |= (uint32_t)byte << (8 * bus->rx_pos);
 		}
-		break;
-		}
-		default:
-			EFM_ASSERT(false);
-			break;
 	}
+	bus->rx_pos++;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Takes a received byte and ACKs it, or NACKs and STOPs after the last
+ *
+ * @details
+ * 	 Every byte also goes to the transfer's buffer if it has one
+ *
+ ******************************************************************************/
+
+static void i2c_read_next(I2C_BUS *bus){
+	I2C_TRANSFER *transfer = &bus->active;
+	uint8_t byte = bus->i2c->RXDATA;
+
+	if(transfer->rx != NULL){
+		transfer->rx[bus->rx_pos] = byte;
+	}
+	i2c_result_byte(bus, byte);
+
+	if(bus->rx_pos < transfer->read_len){
+		bus->i2c->CMD  = I2C_CMD_ACK;
+	}
+	else{
+		bus->i2c->CMD  = I2C_CMD_NACK;
+		bus->i2c->CMD  = I2C_CMD_STOP;
+		bus->state = I2C_STOP;
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ *   The slave refused a byte of an LDMA transfer, lets go of the bus
+ *
+ * @details
+ * 	 The channels are stopped so they cannot refill TXDATA. If the transmit
+ * 	 list has run and the transfer reads, it was the read address that was
+ * 	 refused, e.g. by the si7021 while it converts, and the transfer
+ * 	 resumes there. Anything refused earlier sends the whole transfer
+ * 	 again. A STOP the list already queued is just sent twice.
+ *
+ ******************************************************************************/
+
+static void i2c_ldma_nack(I2C_BUS *bus){
+	bool addressed = (LDMA->CHDONE & (1UL << bus->instance->tx_ch)) && (bus->active.read_len != 0);
+
+	LDMA_StopTransfer(bus->instance->tx_ch);
+	LDMA_StopTransfer(bus->instance->rx_ch);
+	bus->i2c->CMD = I2C_CMD_CLEARTX;
+	bus->status = I2C_NACK_TIMEOUT;
+	bus->resume = addressed ? I2C_ADDR_READ : I2C_ADDR_WRITE;
+	bus->i2c->CMD = I2C_CMD_STOP;
+	bus->state = I2C_RELEASE;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   The STOP of an LDMA transfer has gone out, makes up the result from
+ *   the bytes the receive channel read
+ *
+ ******************************************************************************/
+
+static void i2c_ldma_complete(I2C_BUS *bus){
+	I2C_TRANSFER *transfer = &bus->active;
+	uint8_t *rx = (transfer->rx != NULL) ? transfer->rx : bus->rx_buf;
+
+	for(uint32_t i = 0; i < transfer->read_len; i++){
+		i2c_result_byte(bus, rx[i]);
+	}
+	i2c_complete(bus);
 }
 
+//what each interrupt does in each state, anything not listed is a bus error
+static const I2C_ACTION i2c_transitions[I2C_STATE_COUNT][I2C_EVENT_COUNT] = {
+	[I2C_IDLE]			= { i2c_bus_error,	i2c_bus_error,	i2c_bus_error,	i2c_bus_error,		i2c_ignore,	i2c_bus_error },
+	[I2C_RESET]			= { i2c_bus_error,	i2c_bus_error,	i2c_bus_error,	i2c_reset_done,		i2c_ignore,	i2c_bus_error },
+	[I2C_ADDR_WRITE]	= { i2c_write_next,	i2c_nack,		i2c_bus_error,	i2c_bus_error,		i2c_ignore,	i2c_bus_error },
+	[I2C_WRITE]			= { i2c_write_next,	i2c_nack,		i2c_bus_error,	i2c_bus_error,		i2c_ignore,	i2c_bus_error },
+	[I2C_ADDR_READ]		= { i2c_read_begin,	i2c_nack,		i2c_bus_error,	i2c_bus_error,		i2c_ignore,	i2c_bus_error },
+	[I2C_READ]			= { i2c_bus_error,	i2c_bus_error,	i2c_read_next,	i2c_bus_error,		i2c_ignore,	i2c_bus_error },
+	[I2C_STOP]			= { i2c_bus_error,	i2c_bus_error,	i2c_bus_error,	i2c_complete,		i2c_ignore,	i2c_bus_error },
+	[I2C_LDMA]			= { i2c_bus_error,	i2c_ldma_nack,	i2c_bus_error,	i2c_ldma_complete,	i2c_ignore,	i2c_bus_error },
+	[I2C_RELEASE]		= { i2c_bus_error,	i2c_bus_error,	i2c_bus_error,	i2c_backoff,		i2c_ignore,	i2c_bus_error },
+	[I2C_BACKOFF]		= { i2c_bus_error,	i2c_bus_error,	i2c_bus_error,	i2c_bus_error,		i2c_ignore,	i2c_bus_error },
+};
+
+//interrupt flags of each I2C_EVENT, in the order they are handled
+static const uint32_t i2c_event_flags[I2C_EVENT_COUNT] = {
+	[I2C_ON_ACK]		= I2C_IF_ACK,
+	[I2C_ON_NACK]		= I2C_IF_NACK,
+	[I2C_ON_RXDATAV]	= I2C_IF_RXDATAV,
+	[I2C_ON_MSTOP]		= I2C_IF_MSTOP,
+	[I2C_ON_BITO]		= I2C_IF_BITO,
+	[I2C_ON_ERROR]		= I2C_IF_ERRORS,
+};
+
 /***************************************************************************//**
  * @brief
- *   Function handle the MSTOP interrupt
+ *   Runs the state machine of a bus for the interrupts that fired
  *
  * @details
- * 	 This routine is part of the I2C state machine, it handles the MSTOP interrupt and
- * 	 all relevant state transitions.
+ * 	 Each flag is one lookup in the transition table, so the interrupt path
+ * 	 does not depend on the device or the command being sent
  *
  *
- * @param[in] i2cState
- *   Pointer to the STRUCT which handles the state machine
+ * @param[in] bus
+ *   Bus that interrupted
  *
+ * @param[in] int_flag
+ *   Enabled interrupt flags that were set
  *
  ******************************************************************************/
 
-void static i2c_MSTOP_fun(I2C_STATE_MACHINE *i2cState){
-	switch(i2cState->STATE){
-		case MStop:{
-			sleep_unblock_mode(EM2);
-			add_scheduled_event(i2cState->SI7021_Read_CB);
-			i2cState->STATE = Call;
-		break;
+static void i2c_dispatch(I2C_BUS *bus, uint32_t int_flag){
+	//a bus error ends the try, anything flagged with it is stale
+	if(int_flag & i2c_event_flags[I2C_ON_ERROR]){
+		i2c_transitions[bus->state][I2C_ON_ERROR](bus);
+		return;
+	}
+	for(uint32_t event = 0; event < I2C_ON_ERROR; event++){
+		if(int_flag & i2c_event_flags[event]){
+			i2c_transitions[bus->state][event](bus);
 		}
-		default:
-			EFM_ASSERT(false);
-			break;
 	}
 }
 
+/***************************************************************************//**
+ * @brief
+ *   Interrupt handler body shared by every bus
+ *
+ * @param[in] bus
+ *   Bus whose peripheral interrupted
+ *
+ ******************************************************************************/
+
+static void i2c_irq(I2C_BUS *bus){
+	uint32_t int_flag;
+	int_flag = bus->i2c->IF & bus->i2c->IEN;
+	bus->i2c->IFC = int_flag;
+	TRACE(TRACE_IRQ_ENTER, bus->instance->irq, int_flag);
+
+	i2c_dispatch(bus, int_flag);
+
+	TRACE(TRACE_IRQ_EXIT, bus->instance->irq, 0);
+}
+
 
 //***********************************************************************************
 // Global functions
@@ -308,17 +761,11 @@ void static i2c_MSTOP_fun(I2C_STATE_MACHINE *i2cState){
  ******************************************************************************/
 
 void i2c_open(I2C_TypeDef *i2c, I2C_OPEN_STRUCT *app_i2c_struct){
-
+	I2C_BUS *bus = i2c_bus(i2c);
 
 	//enabling the clock to whichever I2C peripheral has been selected
-	if(i2c == I2C0){
-			CMU_ClockEnable(cmuClock_I2C0, true);
-
-		}
-	else if(i2c == I2C1){
-		CMU_ClockEnable(cmuClock_I2C1, true);
-
-	}
+	bus->instance = &i2c_instances[bus - i2c_buses];
+	CMU_ClockEnable(bus->instance->clock, true);
 
 	//verifying that the clock has been enabled correctly
 
@@ -349,140 +796,302 @@ void i2c_open(I2C_TypeDef *i2c, I2C_OPEN_STRUCT *app_i2c_struct){
 	i2c->ROUTELOC0 = (app_i2c_struct->out_pin_SCL << 8) | app_i2c_struct->out_pin_SDA;
 	i2c->ROUTEPEN = (app_i2c_struct->out_pin_SCL_en << 1) | app_i2c_struct->out_pin_SDA_en;
 
-	i2c_bus_reset(i2c);
-	//interrupts
-	I2C_IntClear(i2c, I2C_IF_ACK |  I2C_IF_NACK | I2C_IF_MSTOP | I2C_IF_SSTOP |I2C_IF_RXDATAV);
-	I2C_IntEnable(i2c, I2C_IF_ACK |  I2C_IF_NACK | I2C_IF_MSTOP | I2C_IF_SSTOP | I2C_IF_RXDATAV);
-
-	if(i2c == I2C0){
-		NVIC_EnableIRQ(I2C0_IRQn);
+	//a held clock or a bus left busy raise an interrupt instead of hanging a transfer
+	i2c->CTRL = (i2c->CTRL & ~(_I2C_CTRL_CLTO_MASK | _I2C_CTRL_BITO_MASK)) | I2C_TIMEOUTS;
+
+	//anything queued before the reset is dropped
+	bus->i2c = i2c;
+	bus->state = I2C_IDLE;
+	bus->resume = I2C_IDLE;
+	bus->tail = bus->head;
+	bus->ldma = false;
+#ifdef I2C_LDMA_ENABLED
+	i2c_ldma_open(bus);
+#endif
+	//interrupts, with the LDMA only the NACK and the end of a transfer, and the timeouts and bus errors in both cases
+	I2C_IntClear(i2c, _I2C_IF_MASK);
+	if(bus->ldma){
+		I2C_IntEnable(i2c, I2C_IF_NACK | I2C_IF_MSTOP | I2C_IF_BITO | I2C_IF_ERRORS);
 	}
-	else if(i2c == I2C1){
-		NVIC_EnableIRQ(I2C1_IRQn);
+	else{
+		I2C_IntEnable(i2c, I2C_IF_ACK |  I2C_IF_NACK | I2C_IF_MSTOP | I2C_IF_SSTOP | I2C_IF_RXDATAV | I2C_IF_BITO | I2C_IF_ERRORS);
 	}
 
+	//transfers queue behind the reset until its MSTOP
+	bus->busy = true;
+	sleep_block_mode(EM2, bus->instance->owner);
+	i2c_bus_reset(bus);
 
+	NVIC_EnableIRQ(bus->instance->irq);
 }
 
 /***************************************************************************//**
  * @brief
- *   Driver to Start an I2C peripheral
+ *   Driver to start an I2C transfer
  *
  * @details
- * 	 This routine is a low level driver.  The application code calls this function
- * 	 to start one of the I2C peripherals
+ * 	 This routine is a low level driver.  The device drivers call this function
+ * 	 with a descriptor of the transfer: the slave address, the bytes to
+ * 	 write, how many bytes to read back after a repeated START and in which
+ * 	 order they make up the result, and the event to post when it is done.
+ * 	 The interrupt handler only follows the transition table, so a new
+ * 	 device or register needs no change here.
  *
+ * 	 A transfer started while the bus is busy waits in the bus's queue and
+ * 	 is started by the MSTOP handler when the transfers ahead of it are
+ * 	 done, so several reads can be issued at once and complete in order.
+ * 	 Each transfer blocks EM2 while it is on the bus.
  *
- * @param[in] i2c
- *   Pointer to the base peripheral address of the i2c peripheral being opened
+ * 	 A NACK or a bus error does not stall the node. The transfer gets off
+ * 	 the bus and is retried after a backoff, up to I2C_RETRY_MAX times.
+ * 	 Its status then tells the caller whether it succeeded, ran out of
+ * 	 retries on NACKs, or kept hitting bus errors.
  *
- * @param[in] data
- *   pointer the variable where the data being taken from i2c rx buffer will be stored, if
- *   I2C_Start is being used for a write, this parameter can be set to false.
- *
- *@param[in] address
- *	address of the slave module
+ * @note
+ *   The descriptor is copied, so it may live on the caller's stack. A read
+ *   buffer must stay valid until the event is posted. A full queue drops
+ *   the transfer and fails an EFM_ASSERT. Its event is still posted, with
+ *   I2C_QUEUE_FULL, so a caller waiting on it is not left hanging.
  *
  *
- * @param[in] I2C_CB
- *   Callback variable, used for the scheduler
+ * @param[in] i2c
+ *   Pointer to the base peripheral address of the i2c peripheral
  *
- *@param[in] Command
- *   Specific command to be sent to the slave
+ * @param[in] transfer
+ *   Descriptor of the transfer
  *
- * @param[in] writeData
- *   If being used for a write, data to be written will be sent in via this parameter.
- *   If being used for a read, this can be set to false.
+ * @return
+ *   true if the transfer was started or queued
  ******************************************************************************/
 
+bool i2c_transfer(I2C_TypeDef *i2c, const I2C_TRANSFER *transfer){
+	I2C_BUS *bus = i2c_bus(i2c);
 
+	EFM_ASSERT(transfer->write_len <= I2C_WRITE_MAX);
+	EFM_ASSERT((transfer->rx != NULL) || (transfer->read_len <= sizeof(bus->result)));
 
-void I2C_Start(I2C_TypeDef *i2c, uint32_t *data, uint32_t address, uint32_t I2C_CB, uint32_t Command, uint16_t writeData ){
+	//the MSTOP handler may be moving the queue on
+	CORE_DECLARE_IRQ_STATE;
+	CORE_ENTER_CRITICAL();
 
+	if(bus->busy){
+		if((bus->head - bus->tail) >= I2C_QUEUE_SIZE){
+			if(transfer->status != NULL){
+				*(transfer->status) = I2C_QUEUE_FULL;
+			}
+			scheduler_post(transfer->event, 0, I2C_QUEUE_FULL);
+			CORE_EXIT_CRITICAL();
+			EFM_ASSERT(false);
+			return false;
+		}
+		bus->queue[bus->head & I2C_QUEUE_MASK] = *transfer;
+		bus->head = bus->head + 1;
+	}
+	else{
+		bus->busy = true;
+		bus->active = *transfer;
+		i2c_transfer_start(bus);
+	}
 
-	EFM_ASSERT((i2c->STATE & _I2C_STATE_STATE_MASK) == I2C_STATE_STATE_IDLE); // X = the I2C peripheral #
+	CORE_EXIT_CRITICAL();
+	return true;
+}
 
-	sleep_block_mode(EM2);
+/***************************************************************************//**
+ * @brief
+ *   ISR for I2C0
+ *
+ *
+ ******************************************************************************/
 
+void I2C0_IRQHandler(void){
+	i2c_irq(&i2c_buses[0]);
+}
 
-	if(i2c == I2C0){
-		i2c0_State.STATE = Call;
-		i2c0_State.slaveAddress = address;
-		i2c0_State.i2c = i2c;
-		i2c0_State.Command = Command;
-		i2c0_State.Data = data;
-		i2c0_State.SI7021_Read_CB = I2C_CB;
-		i2c0_State.writeData = writeData;
-	}
+/***************************************************************************//**
+ * @brief
+ *   ISR for I2C1
+ *
+ *
+ ******************************************************************************/
 
-	else if(i2c == I2C1){
-		i2c1_State.STATE = Call;
-		i2c1_State.slaveAddress = address;
-		i2c1_State.i2c = i2c;
-		i2c1_State.Command = Command;
-		i2c1_State.Data = data;
-		i2c1_State.SI7021_Read_CB = I2C_CB;
-		i2c1_State.writeData = writeData;
-	}
+void I2C1_IRQHandler(void){
+	i2c_irq(&i2c_buses[1]);
+}
 
+/***************************************************************************//**
+ * @brief
+ *   Retries the transfer on I2C0, posted when its backoff timer expires
+ *
+ *
+ ******************************************************************************/
 
-	i2c->CMD        = I2C_CMD_START;       //Start CMD
-	i2c->TXDATA     = (address<<1)|(false); //Loading address write
+void scheduled_i2c0_retry_cb(void){
+	EFM_ASSERT(check_scheduled_event(I2C0_RETRY_CB));
+	remove_scheduled_event(I2C0_RETRY_CB);
+	i2c_retry(&i2c_buses[0]);
 }
 
-	/***************************************************************************//**
-	 * @brief
-	 *   ISR for I2C0
-	 *
-	 *
-	 ******************************************************************************/
+/***************************************************************************//**
+ * @brief
+ *   Retries the transfer on I2C1, posted when its backoff timer expires
+ *
+ *
+ ******************************************************************************/
 
-void I2C0_IRQHandler(void){
-	uint32_t int_flag;
-	int_flag = I2C0->IF & I2C0->IEN;
-	I2C0->IFC = int_flag;
+void scheduled_i2c1_retry_cb(void){
+	EFM_ASSERT(check_scheduled_event(I2C1_RETRY_CB));
+	remove_scheduled_event(I2C1_RETRY_CB);
+	i2c_retry(&i2c_buses[1]);
+}
 
-	if (int_flag & I2C_IF_ACK){
-		i2c_ACK_fun(&i2c0_State);
-	}
-	if (int_flag & I2C_IF_NACK ){
-		i2c_NACK_fun(&i2c0_State);
-	}
-	if (int_flag & I2C_IF_RXDATAV){
-		i2c_RXDATAV_fun(&i2c0_State);
+/***************************************************************************//**
+ * @brief
+ *   Copies the transaction counters out
+ *
+ * @details
+ * 	 The time on the bus is in RTCC ticks of about 30.5 us. That is
+ * 	 coarse next to a single read but it shows how long the conversion
+ * 	 of a polled read keeps its bus, and what the NACKed polls cost.
+ *
+ * @param[out] stats
+ *   Array that receives the counters, one entry per kind of transaction
+ *
+ * @param[out] untracked
+ *   Receives the transactions not counted because the table was full, may
+ *   be NULL
+ *
+ * @return
+ *   Number of entries copied
+ *
+ ******************************************************************************/
+
+uint32_t i2c_stats_snapshot(I2C_STATS stats[I2C_STATS_SIZE], uint32_t *untracked){
+	uint32_t used;
+
+	CORE_DECLARE_IRQ_STATE;
+	CORE_ENTER_CRITICAL();
+
+	used = i2c_stats_used;
+	for(uint32_t i = 0; i < used; i++){
+		stats[i] = i2c_stats[i];
 	}
-	if (int_flag & I2C_IF_MSTOP){
-		i2c_MSTOP_fun(&i2c0_State);
+	if(untracked != NULL){
+		*untracked = i2c_stats_untracked;
 	}
 
+	CORE_EXIT_CRITICAL();
+	return used;
 }
 
 /***************************************************************************//**
  * @brief
- *   ISR for I2C1
- *
+ *   Zeroes the transaction counters and forgets the kinds seen so far
  *
  ******************************************************************************/
 
+void i2c_stats_clear(void){
+	CORE_DECLARE_IRQ_STATE;
+	CORE_ENTER_CRITICAL();
 
-void I2C1_IRQHandler(void){
-uint32_t int_flag;
-int_flag = I2C1->IF & I2C1->IEN;
-I2C1->IFC = int_flag;
+	i2c_stats_used = 0;
+	i2c_stats_untracked = 0;
 
-	if (int_flag & I2C_IF_ACK){
-		i2c_ACK_fun(&i2c1_State);
-	}
-	if (int_flag & I2C_IF_NACK ){
-		i2c_NACK_fun(&i2c1_State);
-	}
-	if (int_flag & I2C_IF_RXDATAV){
-		i2c_RXDATAV_fun(&i2c1_State);
-	}
-	if (int_flag & I2C_IF_MSTOP){
-		i2c_MSTOP_fun(&i2c1_State);
-	}
+	CORE_EXIT_CRITICAL();
+}
 
+/***************************************************************************//**
+ * @brief
+ *   Sends a summary of the transaction counters over the BLE link
+ *
+ * @details
+ * 	 I2C_STATS_CB runs i2c_stats_dump(), which sends one line per kind of
+ * 	 transaction. The counters keep running, each summary covers the time
+ * 	 since i2c_stats_clear(). A call while a summary is in progress is
+ * 	 ignored.
+ *
+ ******************************************************************************/
+
+void i2c_stats_ble(void){
+	if(stats_busy){
+		return;
+	}
+	stats_busy = true;
+	stats_started = false;
+	stats_next = 0;
+	add_scheduled_event(I2C_STATS_CB);
 }
 
+/***************************************************************************//**
+ * @brief
+ *   Coroutine that writes the transaction counters to the BLE module
+ *
+ * @details
+ * 	 As for the trace dump, a line is written only once the previous
+ * 	 output has gone out, checked every I2C_STATS_POLL_MS. A header names
+ * 	 the columns. Each kind of transaction takes two lines, so the longest
+ * 	 counters still fit in one ble_write(). The first gives the bus, slave
+ * 	 address and command in hex, transactions, failures, and NACK and bus
+ * 	 error retries. The second gives the bytes moved, then the average and
+ * 	 longest time on the bus in us. The last line gives the transactions
+ * 	 that were not tracked.
+ *
+ * @param[in] cr
+ *   State of the coroutine, kept by the scheduler
+ *
+ ******************************************************************************/
+
+void i2c_stats_dump(COROUTINE *cr){
+	char line[CSIZE - 1];				//longest string ble_write() takes, and its terminator
+	I2C_STATS stats[I2C_STATS_SIZE];
+	uint32_t untracked;
+	uint32_t used;
 
+	COROUTINE_BEGIN(cr);
+
+	while(true){
+		letimer_timer_start(I2C_STATS_CB, I2C_STATS_POLL_MS, false);
+		COROUTINE_YIELD(cr);
+		if(!ble_tx_idle()){
+			continue;
+		}
+
+		used = i2c_stats_snapshot(stats, &untracked);
+		if(!stats_started){
+			ble_write("\nI2C bus adr cmd n fail nack err\n  bytes avg max us\n");
+			stats_started = true;
+		}
+		else if(stats_next < 2 * used){
+			I2C_STATS *entry = &stats[stats_next / 2];
+
+			if((stats_next % 2) == 0){
+				char command[3] = "--";
+
+				if(entry->command != I2C_STATS_NO_COMMAND){
+					snprintf(command, sizeof(command), "%02x", (unsigned)(uint8_t)entry->command);
+				}
+				snprintf(line, sizeof(line), "%u %02x %s %lu %lu %lu %lu\n",
+						(unsigned)entry->bus, (unsigned)entry->address, command,
+						(unsigned long)entry->count, (unsigned long)entry->failed,
+						(unsigned long)entry->nack_retries, (unsigned long)entry->error_retries);
+			}
+			else{
+				snprintf(line, sizeof(line), "  %lu %llu %llu\n",
+						(unsigned long)entry->bytes,
+						(entry->count != 0) ? (unsigned long long)(entry->ticks * 1000000 / RTCC_HZ / entry->count) : 0ULL,
+						(unsigned long long)entry->max_ticks * 1000000 / RTCC_HZ);
+			}
+			ble_write(line);
+			stats_next++;
+		}
+		else{
+			snprintf(line, sizeof(line), "I2C end, %lu untracked\n", (unsigned long)untracked);
+			ble_write(line);
+			break;
+		}
+	}
+
+	stats_busy = false;
+
+	COROUTINE_END(cr);
+}
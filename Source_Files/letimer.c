@@ -22,18 +22,96 @@
 // defined files
 //***********************************************************************************
 
+// Software timer, one per scheduler event, posting its event when it expires
+typedef struct {
+	bool			armed;			// timer is counting
+	uint32_t		deadline;		// letimer_timer_now() value at which it expires
+	uint32_t		period;			// reload in counts, 0 for a one-shot timer
+} LETIMER_TIMER;
+
 
 //***********************************************************************************
 // Private variables
 //***********************************************************************************
 static uint32_t scheduled_comp0_cb;
-static uint32_t scheduled_comp1_cb;
 static uint32_t scheduled_uf_cb;
 
+//software timers on LETIMER0, timer_base is the time of the counter at top
+static LETIMER_TIMER timers[SCHEDULER_EVENT_COUNT];
+static uint32_t timers_armed;
+static uint32_t timer_top;
+static uint32_t timer_base;
+
 //***********************************************************************************
 // Private functions
 //***********************************************************************************
 
+/***************************************************************************//**
+ * @brief
+ *   Posts the events of expired timers and aims COMP1 at the next deadline
+ *
+ * @details
+ * 	 COMP0 sets the PWM period, so the counter runs from timer_top down to 0
+ * 	 over and over and only COMP1 is free for deadlines. A deadline inside the
+ * 	 current period is loaded into COMP1. One that is further away is left to
+ * 	 the underflow, which wakes the core anyway, so timers add no wakeups
+ * 	 beyond their own deadlines.
+ *
+ * 	 The counter keeps running while COMP1 is written. If it has already
+ * 	 reached the new compare value by the time the write is done, the
+ * 	 deadline is handled here rather than a full period late.
+ *
+ * @note
+ *   Must be called with interrupts disabled
+ *
+ ******************************************************************************/
+
+static void letimer_timer_schedule(void){
+	while(true){
+		uint32_t now = letimer_timer_now();
+		uint32_t next = UINT32_MAX;
+		uint32_t cnt;
+
+		for(uint32_t i = 0; i < SCHEDULER_EVENT_COUNT && timers_armed; i++){
+			LETIMER_TIMER *timer = &timers[i];
+
+			if(!timer->armed){
+				continue;
+			}
+			if((int32_t)(now - timer->deadline) >= 0){
+				add_scheduled_event(i);
+				if(timer->period == 0){
+					timer->armed = false;
+					timers_armed--;
+					continue;
+				}
+				timer->deadline += timer->period;
+				if((int32_t)(now - timer->deadline) >= 0){
+					timer->deadline = now + timer->period;		//missed periods are not made up
+				}
+			}
+			if(timer->deadline - now < next){
+				next = timer->deadline - now;
+			}
+		}
+
+		cnt = LETIMER0->CNT;
+		if(next > cnt){
+			//nothing due before the underflow
+			LETIMER_IntDisable(LETIMER0, LETIMER_IF_COMP1);
+			return;
+		}
+
+		LETIMER_CompareSet(LETIMER0, 1, cnt - next);
+		LETIMER_IntClear(LETIMER0, LETIMER_IF_COMP1);
+		LETIMER_IntEnable(LETIMER0, LETIMER_IF_COMP1);
+		while(LETIMER0->SYNCBUSY);
+		if(LETIMER0->CNT > cnt - next){
+			return;
+		}
+	}
+}
+
 
 //***********************************************************************************
 // Global functions
@@ -132,6 +210,12 @@ void letimer_pwm_open(LETIMER_TypeDef *letimer, APP_LETIMER_PWM_TypeDef *app_let
 
 	LETIMER_CompareSet(letimer, 0,period_cnt);
 
+	//the software timers count periods of COMP0 + 1
+	if(letimer == LETIMER0){
+		timer_top = period_cnt;
+		timer_base = 0;
+	}
+
 	LETIMER_CompareSet(letimer, 1,period_active_cnt);
 
 
@@ -177,7 +261,6 @@ void letimer_pwm_open(LETIMER_TypeDef *letimer, APP_LETIMER_PWM_TypeDef *app_let
 
 	//configuring statics
 	scheduled_comp0_cb = app_letimer_struct->comp0_cb;
-	scheduled_comp1_cb = app_letimer_struct->comp1_cb;
 	scheduled_uf_cb = app_letimer_struct->uf_cb;
 
 	/* We will not enable or turn-on the LETIMER0 at this time */
@@ -214,13 +297,13 @@ void letimer_start(LETIMER_TypeDef *letimer, bool enable){
 
 	//checking if the letimer is off and about to be turned on
 if((letimer->STATUS == false) && (enable == true)){
-	sleep_block_mode(LETIMER_EM);
+	sleep_block_mode(LETIMER_EM, SLEEP_OWNER_LETIMER0);
 	check = true;
 	}
 
 //checking if the letimer is on and about to be disabled
 if((letimer->STATUS == true) && (enable == false)){
-	sleep_unblock_mode(LETIMER_EM);
+	sleep_unblock_mode(LETIMER_EM, SLEEP_OWNER_LETIMER0);
 	check = true;
 }
 LETIMER_Enable(letimer, enable);
@@ -251,22 +334,160 @@ void LETIMER0_IRQHandler(void){
 	uint32_t int_flag;
 	int_flag = LETIMER0->IF & LETIMER0->IEN;
 	LETIMER0->IFC = int_flag;
+	TRACE(TRACE_IRQ_ENTER, LETIMER0_IRQn, int_flag);
 
 	if(int_flag & LETIMER_IF_COMP0){
 		EFM_ASSERT(! (LETIMER0->IF & LETIMER_IF_COMP0));
 		add_scheduled_event(scheduled_comp0_cb);
 	}
 
-	if(int_flag & LETIMER_IF_COMP1){
-		EFM_ASSERT(!(LETIMER0->IF & LETIMER_IF_COMP1));
-		add_scheduled_event(scheduled_comp1_cb);
-		}
-
 	if(int_flag & LETIMER_IF_UF){
 		EFM_ASSERT(!(LETIMER0->IF & LETIMER_IF_UF));
+		timer_base += timer_top + 1;
 		add_scheduled_event(scheduled_uf_cb);
 		}
 
+	//COMP1 belongs to the software timers, which are also checked on each underflow
+	if(int_flag & (LETIMER_IF_COMP1 | LETIMER_IF_UF)){
+		letimer_timer_schedule();
+		}
+
 	//LETIMER0->IFC = int_flag;
+	TRACE(TRACE_IRQ_EXIT, LETIMER0_IRQn, 0);
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Returns the time the software timers run on
+ *
+ * @details
+ * 	 Counts LETIMER0 ticks, one per LETIMER_TIMER_MS, while the timer runs.
+ * 	 Only the difference between two values has a meaning. An underflow
+ * 	 whose interrupt has not run yet is added in, so the value never steps
+ * 	 back.
+ *
+ * @return
+ *   Current time in LETIMER counts
+ *
+ ******************************************************************************/
+
+uint32_t letimer_timer_now(void){
+	uint32_t base;
+	uint32_t cnt;
+
+	CORE_DECLARE_IRQ_STATE;
+	CORE_ENTER_CRITICAL();
+
+	base = timer_base;
+	cnt = LETIMER0->CNT;
+	if(LETIMER0->IF & LETIMER_IF_UF){
+		base += timer_top + 1;
+		cnt = LETIMER0->CNT;
+	}
+
+	CORE_EXIT_CRITICAL();
+
+	return base + (timer_top - cnt);
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Arms the software timer of an event
+ *
+ * @details
+ * 	 When the timer expires its event is posted to the scheduler from the
+ * 	 LETIMER0 interrupt. Each event has one timer, so arming it again
+ * 	 restarts it. Any number of timers share LETIMER0 COMP1, which is always
+ * 	 aimed at the nearest deadline.
+ *
+ * @note
+ *   LETIMER0 must be open and running with its outputs off. COMP1 is taken
+ *   over, so the PWM active period no longer applies.
+ *
+ * @param[in] event
+ *   ID of the event to post, from events.h
+ *
+ * @param[in] ms
+ *   Time until the timer expires, and its period for a periodic timer
+ *
+ * @param[in] periodic
+ *   true to rearm the timer each time it expires
+ *
+ ******************************************************************************/
+
+void letimer_timer_start(uint32_t event, uint32_t ms, bool periodic){
+	uint32_t counts = ms / LETIMER_TIMER_MS;
+
+	EFM_ASSERT(event < SCHEDULER_EVENT_COUNT);
+	EFM_ASSERT(counts > 0 && counts < INT32_MAX);
+	EFM_ASSERT(LETIMER0->ROUTEPEN == 0);
+
+	CORE_DECLARE_IRQ_STATE;
+	CORE_ENTER_CRITICAL();
+
+	if(!timers[event].armed){
+		timers_armed++;
+	}
+	timers[event].armed = true;
+	timers[event].deadline = letimer_timer_now() + counts;
+	timers[event].period = periodic ? counts : 0;
+	letimer_timer_schedule();
+
+	CORE_EXIT_CRITICAL();
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Disarms the software timer of an event
+ *
+ * @note
+ *   An expiry that was already posted stays scheduled
+ *
+ * @param[in] event
+ *   ID of the event whose timer is stopped
+ *
+ ******************************************************************************/
+
+void letimer_timer_stop(uint32_t event){
+	EFM_ASSERT(event < SCHEDULER_EVENT_COUNT);
+
+	CORE_DECLARE_IRQ_STATE;
+	CORE_ENTER_CRITICAL();
+
+	if(timers[event].armed){
+		timers[event].armed = false;
+		timers_armed--;
+		letimer_timer_schedule();
+	}
+
+	CORE_EXIT_CRITICAL();
 }
 
+/***************************************************************************//**
+ * @brief
+ *   Returns true while the software timer of an event is armed
+ *
+ * @param[in] event
+ *   ID of the event, from events.h
+ *
+ ******************************************************************************/
+
+bool letimer_timer_armed(uint32_t event){
+	EFM_ASSERT(event < SCHEDULER_EVENT_COUNT);
+
+	return timers[event].armed;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Returns true if no software timer is armed
+ *
+ * @details
+ * 	 A node that hibernates stops the LETIMER, so it must first check that
+ * 	 no driver is waiting on a timer.
+ *
+ ******************************************************************************/
+
+bool letimer_timers_idle(void){
+	return timers_armed == 0;
+}
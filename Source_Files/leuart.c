@@ -225,6 +225,7 @@ void LEUART0_IRQHandler(void){
 	uint32_t int_flag;
 	int_flag = LEUART0->IF & LEUART0->IEN;
 	LEUART0->IFC = int_flag;
+	TRACE(TRACE_IRQ_ENTER, LEUART0_IRQn, int_flag);
 
 	if (int_flag & LEUART_IEN_TXBL){
 		leuart_TXBL_fun(&leuart_State);
@@ -232,6 +233,7 @@ void LEUART0_IRQHandler(void){
 	if (int_flag & LEUART_IEN_TXC ){
 		leuart_TXC_fun(&leuart_State);
 	}
+	TRACE(TRACE_IRQ_EXIT, LEUART0_IRQn, 0);
 
 
 
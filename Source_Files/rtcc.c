@@ -0,0 +1,128 @@
+/**
+ * @file rtcc.c
+ * @author James Brennan
+ * @date October 16th, 2026
+ * @brief Runs the RTCC as a free running low energy timestamp counter.
+ *
+ */
+
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+
+//** Standard Libraries
+
+//** Silicon Lab include files
+
+//** User/developer include files
+#include "rtcc.h"
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+
+
+//***********************************************************************************
+// Private variables
+//***********************************************************************************
+
+
+//***********************************************************************************
+// Private functions
+//***********************************************************************************
+
+
+//***********************************************************************************
+// Global functions
+//***********************************************************************************
+
+/***************************************************************************//**
+ * @brief
+ *   Driver to open the RTCC as a timestamp counter
+ *
+ * @details
+ * 	 The RTCC counts the LFXO, which cmu_open() routes to the LFE clock tree,
+ * 	 in normal mode without a prescaler. The counter wraps after about 36
+ * 	 hours, so timestamps should only be compared by unsigned subtraction.
+ * 	 The LFXO keeps running down to EM2, which is as deep as this project
+ * 	 sleeps, so the RTCC does not block any energy mode. The hibernate mode
+ * 	 also retains it in EM4H, where the RTCC keeps counting and wakes the
+ * 	 chip.
+ *
+ * @note
+ *   This function is normally called once after cmu_open()
+ *
+ ******************************************************************************/
+
+void rtcc_open(void){
+	RTCC_Init_TypeDef rtcc_init_values = RTCC_INIT_DEFAULT;
+
+	CMU_ClockEnable(cmuClock_RTCC, true);
+
+	rtcc_init_values.enable = true;
+	rtcc_init_values.presc = rtccCntPresc_1;		// one count per LFXO period
+	rtcc_init_values.cntMode = rtccCntModeNormal;
+
+	RTCC_Init(&rtcc_init_values);
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Returns the current RTCC count
+ *
+ * @details
+ * 	 A single register read, cheap enough to call from interrupt handlers.
+ *
+ * @return
+ * 	 The RTCC count, in units of 1 / RTCC_HZ seconds
+ *
+ ******************************************************************************/
+
+uint32_t rtcc_timestamp(void){
+	return RTCC_CounterGet();
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Arms the RTCC to wake the chip from EM4H
+ *
+ * @details
+ * 	 RTCC_WAKEUP_CH compares against the counter and its flag is enabled as
+ * 	 an EM4 wake-up source. The flag is not enabled in the NVIC, so a match
+ * 	 while the core is awake does nothing.
+ *
+ * @note
+ *   The count must be ahead of the counter, a count already passed is only
+ *   matched again after the counter wraps
+ *
+ * @param[in] count
+ *   RTCC count to wake up at
+ *
+ ******************************************************************************/
+
+void rtcc_wakeup_at(uint32_t count){
+	RTCC_CCChConf_TypeDef compare = RTCC_CH_INIT_COMPARE_DEFAULT;
+
+	RTCC_ChannelInit(RTCC_WAKEUP_CH, &compare);
+	RTCC_ChannelCCVSet(RTCC_WAKEUP_CH, count);
+	RTCC_IntClear(RTCC_WAKEUP_IF);
+	RTCC_IntEnable(RTCC_WAKEUP_IF);
+	RTCC_EM4WakeupEnable(true);
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Disarms the EM4H wake-up
+ *
+ * @details
+ * 	 The RTCC keeps its registers through EM4H, so the wake-up that ended it
+ * 	 is still armed after the warm boot.
+ *
+ ******************************************************************************/
+
+void rtcc_wakeup_clear(void){
+	RTCC_EM4WakeupEnable(false);
+	RTCC_IntDisable(RTCC_WAKEUP_IF);
+	RTCC_IntClear(RTCC_WAKEUP_IF);
+}
@@ -14,17 +14,160 @@
 //***********************************************************************************
 // defined files
 //***********************************************************************************
+#define SCHEDULER_QUEUE_MASK		(SCHEDULER_QUEUE_SIZE - 1)
+
+//word and bit of an event in the pending bitmap
+#define SCHEDULER_WORD(event)		((event) >> 5)
+#define SCHEDULER_BIT(event)		(1UL << ((event) & 31))
+
+//the summary word has one bit per bitmap word
+_Static_assert(SCHEDULER_EVENT_WORDS <= 32, "too many events for the summary word");
 
 
 //***********************************************************************************
 // Static / Private Variables
 //***********************************************************************************
-static unsigned int event_scheduled;
+//pending bitmap, a bit of event_summary is set while its word has any bit set.
+//Both are only changed with the atomics in atomic.h, never under a critical section
+static volatile uint32_t event_scheduled[SCHEDULER_EVENT_WORDS];
+static volatile uint32_t event_summary;
+static uint8_t event_runs[SCHEDULER_EVENT_COUNT];
+static uint32_t priority_events[SCHEDULER_PRIORITY_COUNT][SCHEDULER_EVENT_WORDS];
+static uint32_t record_events[SCHEDULER_EVENT_WORDS];
+
+//record queue, head is only written by interrupt handlers and tail only by the main loop
+static SCHEDULER_RECORD event_queue[SCHEDULER_QUEUE_SIZE];
+static volatile uint32_t queue_head;
+static volatile uint32_t queue_tail;
+static uint32_t records_dropped;
+
+//per event counters, posted_at holds the time of the post a set bit stands for
+static SCHEDULER_STATS event_stats[SCHEDULER_EVENT_COUNT];
+static uint32_t event_posted_at[SCHEDULER_EVENT_COUNT];
+
+//where each COROUTINE event's coroutine left off
+static COROUTINE event_coroutines[SCHEDULER_EVENT_COUNT];
 
 //***********************************************************************************
 // Private functions
 //***********************************************************************************
 
+/***************************************************************************//**
+ * @brief
+ *   Picks the next event to dispatch
+ *
+ * @details
+ * 	 Returns the lowest pending ID of the highest priority level that has an
+ * 	 event pending. Only the bitmap words flagged in the summary word are
+ * 	 looked at, and the event within a word is found with count trailing
+ * 	 zeros.
+ *
+ * @param[in] spent
+ *   Bitmap of the events that may not run again in this pass
+ *
+ * @return
+ * 	 ID of the event, or SCHEDULER_EVENT_COUNT if none of the pending events
+ * 	 has a handler
+ *
+ ******************************************************************************/
+
+static uint32_t scheduler_next(const uint32_t spent[SCHEDULER_EVENT_WORDS]){
+	for(int priority = 0; priority < SCHEDULER_PRIORITY_COUNT; priority++){
+		uint32_t words = event_summary;
+
+		while(words){
+			uint32_t word = __builtin_ctz(words);
+			uint32_t ready = event_scheduled[word] & priority_events[priority][word] & ~spent[word];
+
+			if(ready){
+				return (word << 5) + __builtin_ctz(ready);
+			}
+			words &= words - 1;
+		}
+	}
+	return SCHEDULER_EVENT_COUNT;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Updates the counters of an event about to be dispatched
+ *
+ * @details
+ * 	 The wait since the post is added to the event's log2 histogram. The
+ * 	 bucket is the bit length of the wait, found with count leading zeros,
+ * 	 so the cost is the same for any wait.
+ *
+ * @param[in] index
+ *   ID of the event
+ *
+ * @param[in] posted_at
+ *   RTCC count when the event was posted
+ *
+ * @return
+ *   RTCC count at dispatch, the start of the handler's run
+ *
+ ******************************************************************************/
+
+static uint32_t scheduler_account(uint32_t index, uint32_t posted_at){
+	uint32_t now = rtcc_timestamp();
+	uint32_t pending = now - posted_at;
+	uint32_t bucket = (pending == 0) ? 0 : 32 - __builtin_clz(pending);
+
+	if(bucket >= SCHEDULER_LATENCY_BUCKETS){
+		bucket = SCHEDULER_LATENCY_BUCKETS - 1;
+	}
+
+	event_stats[index].dispatched++;
+	event_stats[index].latency[bucket]++;
+	if(pending > event_stats[index].max_pending){
+		event_stats[index].max_pending = pending;
+	}
+	return now;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Records how long a handler ran
+ *
+ * @param[in] index
+ *   ID of the event
+ *
+ * @param[in] start
+ *   RTCC count returned by scheduler_account() before the handler ran
+ *
+ ******************************************************************************/
+
+static void scheduler_account_run(uint32_t index, uint32_t start){
+	uint32_t run = rtcc_timestamp() - start;
+
+	if(run > event_stats[index].max_run){
+		event_stats[index].max_run = run;
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Charges a handler run to its event's budget
+ *
+ * @param[in] index
+ *   ID of the event
+ *
+ * @param[in,out] ran
+ *   Bitmap of the events that ran in this pass
+ *
+ * @param[in,out] spent
+ *   Bitmap of the events that may not run again in this pass
+ *
+ ******************************************************************************/
+
+static void scheduler_charge(uint32_t index, uint32_t ran[SCHEDULER_EVENT_WORDS], uint32_t spent[SCHEDULER_EVENT_WORDS]){
+	ran[SCHEDULER_WORD(index)] |= SCHEDULER_BIT(index);
+	if((scheduler_event_table[index].budget != SCHEDULER_NO_BUDGET) &&
+			(++event_runs[index] >= scheduler_event_table[index].budget)){
+		spent[SCHEDULER_WORD(index)] |= SCHEDULER_BIT(index);
+	}
+}
+
 //***********************************************************************************
 // Global functions
 //***********************************************************************************
@@ -34,7 +177,8 @@ static unsigned int event_scheduled;
  *   Opens the scheduler
  *
  * @details
- * 	 This function simply clears the event_scheduled variable
+ * 	 Clears the pending events and the record queue, and builds the mask of
+ * 	 each priority level from the dispatch table
  *
  * @note
  *   Should be called to start or reset the scheduler
@@ -46,10 +190,35 @@ void scheduler_open(void){
 	CORE_DECLARE_IRQ_STATE;
 	CORE_ENTER_CRITICAL();
 
-	event_scheduled = event_scheduled & ~event_scheduled; //clears the variable
+	for(int i = 0; i < SCHEDULER_EVENT_WORDS; i++){
+		event_scheduled[i] = 0;
+		record_events[i] = 0;
+		for(int priority = 0; priority < SCHEDULER_PRIORITY_COUNT; priority++){
+			priority_events[priority][i] = 0;
+		}
+	}
+	event_summary = 0;
+
+	//only events with a BIT or COROUTINE handler are picked from the bitmap,
+	//a RECORD event's bit is never taken and must not be set
+	for(int i = 0; i < SCHEDULER_EVENT_COUNT; i++){
+		event_runs[i] = 0;
+		event_coroutines[i] = (COROUTINE){0};
+		if(scheduler_event_table[i].callback != NULL || scheduler_event_table[i].coroutine != NULL){
+			priority_events[scheduler_event_table[i].priority][SCHEDULER_WORD(i)] |= SCHEDULER_BIT(i);
+		}
+		else if(scheduler_event_table[i].record_callback != NULL){
+			record_events[SCHEDULER_WORD(i)] |= SCHEDULER_BIT(i);
+		}
+	}
+
+	//empties the record queue
+	queue_tail = queue_head;
+	records_dropped = 0;
 
 	CORE_EXIT_CRITICAL();
 
+	scheduler_stats_clear();
 }
 
 /***************************************************************************//**
@@ -57,21 +226,35 @@ void scheduler_open(void){
  *   Adds an event
  *
  * @details
- * 	 Ors an event with the event scheduled variable
+ * 	 Sets the event's bit in the pending bitmap. A post of an event whose
+ * 	 bit is still set is merged into the earlier one and counted as
+ * 	 coalesced, otherwise the time of the post is kept for the pending time.
+ *
+ * 	 Interrupts stay enabled. The bit and the counters are each updated
+ * 	 with one exclusive load/store, and the word's summary bit is set after
+ * 	 the word, so the summary never misses a pending event for longer than
+ * 	 remove_scheduled_event() takes to repair it.
  *
  * @param[in] event
- *   int defining a new event
+ *   ID of the event, from events.h
  *
  *
  ******************************************************************************/
 
 void add_scheduled_event(uint32_t event){
-	CORE_DECLARE_IRQ_STATE;
-	CORE_ENTER_CRITICAL();
+	uint32_t now = rtcc_timestamp();
 
-	event_scheduled = event_scheduled | event;
+	EFM_ASSERT(event < SCHEDULER_EVENT_COUNT);
 
-	CORE_EXIT_CRITICAL();
+	TRACE(TRACE_POST, event, 0);
+	atomic_add32(&event_stats[event].posted, 1);
+	if(atomic_or32(&event_scheduled[SCHEDULER_WORD(event)], SCHEDULER_BIT(event)) & SCHEDULER_BIT(event)){
+		atomic_add32(&event_stats[event].coalesced, 1);
+	}
+	else{
+		event_posted_at[event] = now;
+	}
+	atomic_or32(&event_summary, SCHEDULER_BIT(SCHEDULER_WORD(event)));
 }
 
 /***************************************************************************//**
@@ -79,41 +262,269 @@ void add_scheduled_event(uint32_t event){
  *   Removes an event
  *
  * @details
- * 	 Removes an event from the event scheduler variable using &
+ * 	 Clears the event's bit in the pending bitmap, and the word's bit in the
+ * 	 summary once the word is empty
+ *
+ * 	 An interrupt can post an event in the same word between the word being
+ * 	 seen empty and the summary bit being cleared. The word is read again
+ * 	 afterwards and the summary bit put back if it is no longer empty, so no
+ * 	 critical section is needed.
  *
  * @param[in] event
- *   int defining an event to remove
+ *   ID of the event, from events.h
  *
  *
  ******************************************************************************/
 
 
 void remove_scheduled_event(uint32_t event){
+	uint32_t word = SCHEDULER_WORD(event);
+
+	EFM_ASSERT(event < SCHEDULER_EVENT_COUNT);
 
+	if((atomic_and32(&event_scheduled[word], ~SCHEDULER_BIT(event)) & ~SCHEDULER_BIT(event)) == 0){
+		atomic_and32(&event_summary, ~SCHEDULER_BIT(word));
+		if(event_scheduled[word] != 0){
+			atomic_or32(&event_summary, SCHEDULER_BIT(word));
+		}
+	}
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Returns true if an event is pending
+ *
+ * @details
+ * 	 Used to wait for events that have no handler. Sequences that wait on
+ * 	 a peripheral should be written as a coroutine instead, so the core
+ * 	 can sleep.
+ *
+ * @param[in] event
+ *   ID of the event, from events.h
+ *
+ ******************************************************************************/
+
+bool check_scheduled_event(uint32_t event){
+	EFM_ASSERT(event < SCHEDULER_EVENT_COUNT);
+
+	return (event_scheduled[SCHEDULER_WORD(event)] & SCHEDULER_BIT(event)) != 0;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Posts an event together with a value and a status
+ *
+ * @details
+ * 	 If the event is a RECORD event, a record with the payload, the status
+ * 	 and an RTCC timestamp is added to the queue. The status travels with
+ * 	 the payload, so a handler always sees how the very work it is handed
+ * 	 ended, even if the same work has been done again since. Otherwise the
+ * 	 payload and status are dropped and
+ * 	 the event's bit is set as add_scheduled_event() does, so callers do not
+ * 	 need to know how an event is handled.
+ *
+ * 	 The queue takes no lock. Only the interrupt handlers write to it, and
+ * 	 they share one priority so they never preempt each other; the main loop
+ * 	 only moves the tail, or posts with interrupts masked. The record is filled in before the head is
+ * 	 advanced, so the main loop never sees a partly written record.
+ *
+ * @note
+ *   Records may only be posted from interrupt handlers or with interrupts
+ *   masked. A full queue drops the record and counts it.
+ *
+ * @param[in] event
+ *   ID of the event, from events.h
+ *
+ * @param[in] payload
+ *   Value handed to the handler
+ *
+ * @param[in] status
+ *   How the work behind the post ended, 0 if it succeeded
+ *
+ ******************************************************************************/
+
+void scheduler_post(uint32_t event, uint32_t payload, uint32_t status){
+	SCHEDULER_RECORD *record;
+	uint32_t head = queue_head;
+
+	EFM_ASSERT(event < SCHEDULER_EVENT_COUNT);
+
+	if(scheduler_event_table[event].record_callback == NULL){
+		add_scheduled_event(event);
+		return;
+	}
+
+	EFM_ASSERT(CORE_InIrqContext() || CORE_IrqIsDisabled());
+
+	TRACE(TRACE_POST, event, payload);
+	event_stats[event].posted++;
+	if((head - queue_tail) >= SCHEDULER_QUEUE_SIZE){
+		event_stats[event].dropped++;
+		records_dropped++;
+		EFM_ASSERT(false);
+		return;
+	}
+
+	record = &event_queue[head & SCHEDULER_QUEUE_MASK];
+	record->event = event;
+	record->payload = payload;
+	record->status = status;
+	record->timestamp = rtcc_timestamp();
+
+	//the record must be complete before the main loop can see it
+	__DMB();
+	queue_head = head + 1;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Returns true if there is any work for scheduler_dispatch()
+ *
+ * @details
+ * 	 Unlike check_scheduled_event(), this also covers queued records, so the
+ * 	 main loop must use it to decide whether it may sleep.
+ *
+ ******************************************************************************/
+
+bool scheduler_pending(void){
+	return (event_summary != 0) || (queue_tail != queue_head);
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Returns the number of records lost to a full queue
+ *
+ ******************************************************************************/
+
+uint32_t scheduler_records_dropped(void){
+	return records_dropped;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Copies the counters of every event
+ *
+ * @details
+ * 	 The copy is taken with interrupts off, so the counters of one snapshot
+ * 	 all belong to the same moment. Comparing coalesced posts and the longest
+ * 	 pending time against the sample period shows whether the I2C and BLE
+ * 	 work keeps up with the LETIMER.
+ *
+ * @param[out] stats
+ *   Array indexed by event ID that receives the counters
+ *
+ ******************************************************************************/
+
+void scheduler_stats_snapshot(SCHEDULER_STATS stats[SCHEDULER_EVENT_COUNT]){
 	CORE_DECLARE_IRQ_STATE;
 	CORE_ENTER_CRITICAL();
 
-	event_scheduled = event_scheduled & ~event;
+	for(int i = 0; i < SCHEDULER_EVENT_COUNT; i++){
+		stats[i] = event_stats[i];
+	}
 
 	CORE_EXIT_CRITICAL();
+}
 
+/***************************************************************************//**
+ * @brief
+ *   Clears the counters of every event
+ *
+ * @note
+ *   Events still pending keep the time they were posted at
+ *
+ ******************************************************************************/
+
+void scheduler_stats_clear(void){
+	CORE_DECLARE_IRQ_STATE;
+	CORE_ENTER_CRITICAL();
+
+	for(int i = 0; i < SCHEDULER_EVENT_COUNT; i++){
+		event_stats[i] = (SCHEDULER_STATS){0};
+	}
+
+	CORE_EXIT_CRITICAL();
 }
 
 /***************************************************************************//**
  * @brief
- *   Returns the event_scheduled variable
+ *   Runs the handlers of the scheduled events by priority
  *
  * @details
- * 	 Allows one to check how many events are scheduled
+ * 	 Handlers run to completion one at a time. After each one the bitmap is
+ * 	 read again, so an event posted by an interrupt or by the handler itself
+ * 	 goes ahead of any lower priority work still waiting. Within a priority
+ * 	 level the lowest ID runs first. Queued records are taken oldest first,
+ * 	 ahead of bit events of the same or lower priority. An event that has
+ * 	 used up its budget is left pending for the next pass, and the pass ends
+ * 	 once nothing else can run. Records count against the budget of their
+ * 	 event too. Once the oldest record's event is spent the queue waits for
+ * 	 the next pass, so records are still handled in the order they came.
+ *
+ * 	 A COROUTINE event is cleared before its coroutine is resumed, so the
+ * 	 transfer or timer the coroutine starts before yielding posts it again.
  *
- *+
+ * @note
+ *   Called from the main loop after waking up
  *
  ******************************************************************************/
 
-uint32_t get_scheduled_events(void){
+void scheduler_dispatch(void){
+	uint32_t spent[SCHEDULER_EVENT_WORDS] = {0};
+	uint32_t ran[SCHEDULER_EVENT_WORDS] = {0};
+
+	while(true){
+		uint32_t event = scheduler_next(spent);
+		uint32_t tail = queue_tail;
+		uint32_t start;
+
+		//the oldest record goes first unless a bit event of higher priority is waiting
+		if(tail != queue_head){
+			SCHEDULER_RECORD record;
+
+			__DMB();
+			record = event_queue[tail & SCHEDULER_QUEUE_MASK];
+			if(((spent[SCHEDULER_WORD(record.event)] & SCHEDULER_BIT(record.event)) == 0) &&
+					((event == SCHEDULER_EVENT_COUNT) ||
+					(scheduler_event_table[record.event].priority <= scheduler_event_table[event].priority))){
+				queue_tail = tail + 1;
+				start = scheduler_account(record.event, record.timestamp);
+				TRACE(TRACE_HANDLER_BEGIN, record.event, 0);
+				scheduler_event_table[record.event].record_callback(&record);
+				TRACE(TRACE_HANDLER_END, record.event, 0);
+				scheduler_account_run(record.event, start);
+				scheduler_charge(record.event, ran, spent);
+				continue;
+			}
+		}
 
+		if(event == SCHEDULER_EVENT_COUNT){
+			break;
+		}
 
-	return event_scheduled;
+		start = scheduler_account(event, event_posted_at[event]);
+		TRACE(TRACE_HANDLER_BEGIN, event, 0);
+		if(scheduler_event_table[event].coroutine != NULL){
+			remove_scheduled_event(event);
+			scheduler_event_table[event].coroutine(&event_coroutines[event]);
+		}
+		else{
+			scheduler_event_table[event].callback();
+		}
+		TRACE(TRACE_HANDLER_END, event, 0);
+		scheduler_account_run(event, start);
+		scheduler_charge(event, ran, spent);
+	}
 
+	for(int i = 0; i < SCHEDULER_EVENT_WORDS; i++){
+		//interrupts may post handled events at any time, only a RECORD bit is an error
+		EFM_ASSERT((event_scheduled[i] & record_events[i]) == 0);		//record posted without scheduler_post()
 
+		//budgets start over on the next pass
+		while(ran[i]){
+			event_runs[(i << 5) + __builtin_ctz(ran[i])] = 0;
+			ran[i] &= ran[i] - 1;
+		}
+	}
 }
@@ -51,12 +51,130 @@
 //***********************************************************************************
 // Private variables
 //***********************************************************************************
-static int lowest_energy_mode [MAX_ENERGY_MODES];
+static volatile uint32_t lowest_energy_mode [MAX_ENERGY_MODES];
+static volatile uint32_t sleep_block_mask;		//bit n set while EMn has a nonzero block count
+
+//residency counters, only changed by enter_sleep() with interrupts off
+static SLEEP_STATS sleep_stats;
+static uint32_t sleep_stamp;			//RTCC count when the current mode was entered
+static uint32_t sleep_mode;				//mode the core is in, EM0 unless stopped in enter_sleep()
+
+//blocks per owner, live counts are kept apart from the counters so they can be updated exclusively
+static volatile uint32_t sleep_owner_blocks[SLEEP_OWNER_COUNT][MAX_ENERGY_MODES];
+static volatile uint32_t sleep_owner_held[SLEEP_OWNER_COUNT];		//blocks of every mode together
+static uint32_t sleep_owner_since[SLEEP_OWNER_COUNT];				//RTCC count when the first was taken
+static SLEEP_OWNER_STATS sleep_owner_stats[SLEEP_OWNER_COUNT];
 
 //***********************************************************************************
 // Private functions
 //***********************************************************************************
 
+/***************************************************************************//**
+ * @brief
+ *   Takes one from a count unless it is already zero
+ *
+ * @details
+ * 	 The check and the decrement are one exclusive load/store, so an
+ * 	 unblock that does not match a block can be refused without masking
+ * 	 interrupts
+ *
+ * @param[in] count
+ *   Count to decrement
+ *
+ * @return
+ *   false if the count was zero and has not changed
+ *
+ ******************************************************************************/
+
+static bool sleep_take(volatile uint32_t *count){
+	uint32_t value;
+
+	do {
+		value = __LDREXW(count);
+		if(value == 0){
+			__CLREX();
+			return false;
+		}
+	} while(__STREXW(value - 1, count));
+	return true;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Brings the bit of an energy mode in the block mask in line with its count
+ *
+ * @details
+ * 	 Called when a count goes from zero to one or back. A block and an unblock of the
+ * 	 same mode may interleave between the count and the mask, so the bit is
+ * 	 written from the count and checked again until the two agree. Whichever
+ * 	 caller writes the bit last also checks it last, so the mask is right
+ * 	 once every caller has returned.
+ *
+ * @param[in] EM
+ *   The energy mode whose count changed
+ *
+ ******************************************************************************/
+
+static void sleep_update_mask(uint32_t EM){
+	uint32_t bit = 1UL << EM;
+
+	do {
+		if(lowest_energy_mode[EM] != 0){
+			atomic_or32(&sleep_block_mask, bit);
+		}
+		else{
+			atomic_and32(&sleep_block_mask, ~bit);
+		}
+	} while((lowest_energy_mode[EM] != 0) != ((sleep_block_mask & bit) != 0));
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Enters a sleep mode and charges the time to it
+ *
+ * @details
+ * 	 The time since the last wake up is charged to EM0 and the time asleep
+ * 	 to the mode entered. The RTCC is read with interrupts off, before the
+ * 	 core stops and after it restarts but before the interrupt that woke it
+ * 	 is handled, so handler time counts as EM0.
+ *
+ * @note
+ *   Time in EM3 is only measured if the RTCC clock keeps running there
+ *
+ * @param[in] EM
+ *   EM1, EM2 or EM3
+ *
+ ******************************************************************************/
+
+static void sleep_enter_mode(uint32_t EM){
+	uint32_t now = rtcc_timestamp();
+
+	sleep_stats.ticks[EM0] += (uint32_t)(now - sleep_stamp);
+	sleep_stamp = now;
+	sleep_mode = EM;
+
+	TRACE(TRACE_SLEEP, EM, 0);
+	switch(EM){
+		case EM1:
+			EMU_EnterEM1();
+			break;
+		case EM2:
+			EMU_EnterEM2(true);
+			break;
+		default:
+			EMU_EnterEM3(true);
+			break;
+	}
+	TRACE(TRACE_WAKE, EM, 0);
+
+	now = rtcc_timestamp();
+	sleep_stats.ticks[EM] += (uint32_t)(now - sleep_stamp);
+	sleep_stamp = now;
+	sleep_mode = EM0;
+	sleep_stats.entries[EM]++;
+	sleep_stats.entries[EM0]++;
+}
+
 
 //***********************************************************************************
 // Global functions
@@ -82,6 +200,14 @@ void sleep_open(void){
 	for(i = 0; i< MAX_ENERGY_MODES; i++){
 		lowest_energy_mode[i] = false;
 	}
+	sleep_block_mask = 0;
+	for(i = 0; i < SLEEP_OWNER_COUNT; i++){
+		for(int em = 0; em < MAX_ENERGY_MODES; em++){
+			sleep_owner_blocks[i][em] = 0;
+		}
+		sleep_owner_held[i] = 0;
+	}
+	sleep_stats_clear();
 
 
 }
@@ -93,24 +219,42 @@ void sleep_open(void){
  * @details
  * 	 This routine sends a block order for a particular energy mode
  *
+ * 	 The count is updated with an exclusive load/store, so the I2C interrupt
+ * 	 handlers that block and unblock modes are never held off. The mode's
+ * 	 bit in the block mask is set on the first block.
+ *
+ * 	 The block is also counted against its owner, whose time holding blocks
+ * 	 starts with its first one.
+ *
  *
  * @param[in] EM
  *   The energy mode to be blocked
  *
+ * @param[in] owner
+ *   Driver taking the block, from SLEEP_OWNER_LIST
+ *
  *
  *
  ******************************************************************************/
 
-void sleep_block_mode(uint32_t EM){
-	CORE_DECLARE_IRQ_STATE;
-	CORE_ENTER_CRITICAL();
+void sleep_block_mode(uint32_t EM, SLEEP_OWNER owner){
+	uint32_t blocks;
 
-	//code here
-	lowest_energy_mode[EM] = lowest_energy_mode[EM]+1;
+	EFM_ASSERT(EM < MAX_ENERGY_MODES && owner < SLEEP_OWNER_COUNT);
 
-	EFM_ASSERT (lowest_energy_mode[EM] < 5);
+	if(atomic_add32(&sleep_owner_held[owner], 1) == 0){
+		sleep_owner_since[owner] = rtcc_timestamp();
+	}
+	atomic_add32(&sleep_owner_blocks[owner][EM], 1);
+	atomic_add32(&sleep_owner_stats[owner].block_calls, 1);
 
-	CORE_EXIT_CRITICAL();
+	blocks = atomic_add32(&lowest_energy_mode[EM], 1);
+	if(blocks == 0){
+		sleep_update_mask(EM);
+	}
+	TRACE(TRACE_BLOCK, EM, blocks + 1);
+
+	EFM_ASSERT (blocks + 1 < 5);
 }
 
 /***************************************************************************//**
@@ -120,24 +264,45 @@ void sleep_block_mode(uint32_t EM){
  * @details
  * 	 This routine sends an unblock order for a particular energy mode
  *
+ * 	 As with sleep_block_mode(), interrupts are not disabled. The mode's bit
+ * 	 in the block mask is cleared with the last unblock.
+ *
+ * 	 An owner may only release blocks it holds. Any other unblock is counted
+ * 	 against the owner and refused, so it cannot release another driver's
+ * 	 block.
+ *
  *
  * @param[in] EM
  *   The energy mode to be unblocked
  *
+ * @param[in] owner
+ *   Driver that took the block
+ *
  *
  *
  ******************************************************************************/
 
-void sleep_unblock_mode(uint32_t EM){
-	CORE_DECLARE_IRQ_STATE;
-	CORE_ENTER_CRITICAL();
+void sleep_unblock_mode(uint32_t EM, SLEEP_OWNER owner){
+	uint32_t blocks;
 
-	//code here
-	lowest_energy_mode[EM] = lowest_energy_mode[EM]-1;
+	EFM_ASSERT(EM < MAX_ENERGY_MODES && owner < SLEEP_OWNER_COUNT);
+
+	if(!sleep_take(&sleep_owner_blocks[owner][EM])){
+		atomic_add32(&sleep_owner_stats[owner].unbalanced, 1);
+		EFM_ASSERT(false);
+		return;
+	}
+	if(atomic_sub32(&sleep_owner_held[owner], 1) == 1){
+		sleep_owner_stats[owner].ticks += (uint32_t)(rtcc_timestamp() - sleep_owner_since[owner]);
+	}
 
-	EFM_ASSERT (lowest_energy_mode[EM] >= 0);
+	blocks = atomic_sub32(&lowest_energy_mode[EM], 1);
+	if(blocks == 1){
+		sleep_update_mask(EM);
+	}
+	TRACE(TRACE_UNBLOCK, EM, blocks - 1);
 
-	CORE_EXIT_CRITICAL();
+	EFM_ASSERT (blocks > 0);
 }
 
 /***************************************************************************//**
@@ -145,45 +310,27 @@ void sleep_unblock_mode(uint32_t EM){
  *   Enters a sleep mode
  *
  * @details
- * 	 This routine enters the lowest sleep mode
- *
- *
- *
+ * 	 This routine enters the deepest mode allowed, the one numbered just
+ * 	 below the shallowest blocked mode. Blocks of EM0 or EM1 keep the core
+ * 	 awake.
  *
+ * 	 Interrupts stay off from reading the block mask until the core stops,
+ * 	 so an interrupt that changes the blocks cannot be missed. The mask is
+ * 	 one word, so this window is only a few instructions.
  *
  ******************************************************************************/
 
 void enter_sleep(void){
+	uint32_t mode;
 	CORE_DECLARE_IRQ_STATE;
 	CORE_ENTER_CRITICAL();
 
-
-	if(lowest_energy_mode[EM0]>0){
-		CORE_EXIT_CRITICAL();
-		return;
+	mode = current_block_energy_mode();
+	if(mode > EM1){
+		sleep_enter_mode(mode - 1);
 	}
-	else if(lowest_energy_mode[EM1]>0){
-		CORE_EXIT_CRITICAL();
-		return;
-	}
-	else if(lowest_energy_mode[EM2]>0){
-		EMU_EnterEM1();
-		CORE_EXIT_CRITICAL();
-		return;
-		}
-	else if(lowest_energy_mode[EM3]>0){
-		EMU_EnterEM2(true);
-		CORE_EXIT_CRITICAL();
-		return;
-		}
-	else{
-		EMU_EnterEM3(true);
-		CORE_EXIT_CRITICAL();
-		return;
-	}
-
-
 
+	CORE_EXIT_CRITICAL();
 }
 
 /***************************************************************************//**
@@ -191,7 +338,8 @@ void enter_sleep(void){
  *   Returns the current lowest energy mode
  *
  * @details
- * 	 This routine returns the lowest current energy mode
+ * 	 This routine returns the shallowest energy mode with a block, the
+ * 	 lowest set bit of the block mask, or EM4 if nothing is blocked
  *
  *
  * @return
@@ -201,40 +349,107 @@ void enter_sleep(void){
  ******************************************************************************/
 
 uint32_t current_block_energy_mode(void){
-int i =  0;
-
-while(1){
-	if(  i == 0){
-		if(i<MAX_ENERGY_MODES){
-			if(lowest_energy_mode[i] != 0){
-				return i;
-			}
-			else{
-				i = i+1;
-			}
-		}
-		else{
-		return MAX_ENERGY_MODES - 1;
-		}
-	}
-	else{
-		if(i<MAX_ENERGY_MODES){
-			if(lowest_energy_mode[i] != 0){
-				return i;
-				}
-			else{
-				i = i+1;
-			}
-		}
-		else{
+	uint32_t mask = sleep_block_mask;
+
+	if(mask == 0){
 		return MAX_ENERGY_MODES - 1;
-		}
 	}
+	return __builtin_ctz(mask);
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Returns the block mask
+ *
+ * @details
+ * 	 Bit n is set while EMn has at least one block, so the whole block state
+ * 	 can be logged or reported with a single read
+ *
+ ******************************************************************************/
 
+uint32_t sleep_blocked_modes(void){
+	return sleep_block_mask;
 }
 
+/***************************************************************************//**
+ * @brief
+ *   Copies the energy mode residency counters
+ *
+ * @details
+ * 	 The time since the current mode was entered is added to it, so the
+ * 	 ticks of all modes sum to the time since the counters were cleared. The share of
+ * 	 EM1 is the cost of the EM2 block held over I2C transfers, and time not
+ * 	 spent in EM3 is the cost of SYSTEM_BLOCK_EM.
+ *
+ * @param[out] stats
+ *   Receives the counters
+ *
+ ******************************************************************************/
 
+void sleep_stats_snapshot(SLEEP_STATS *stats){
+	CORE_DECLARE_IRQ_STATE;
+	CORE_ENTER_CRITICAL();
+
+	*stats = sleep_stats;
+	stats->ticks[sleep_mode] += (uint32_t)(rtcc_timestamp() - sleep_stamp);
+
+	CORE_EXIT_CRITICAL();
 }
 
+/***************************************************************************//**
+ * @brief
+ *   Clears the energy mode residency and owner counters
+ *
+ * @note
+ *   Blocks still held are kept, and their owners' time restarts from now
+ *
+ ******************************************************************************/
+
+void sleep_stats_clear(void){
+	CORE_DECLARE_IRQ_STATE;
+	CORE_ENTER_CRITICAL();
+
+	sleep_stats = (SLEEP_STATS){0};
+	sleep_stamp = rtcc_timestamp();
+	sleep_mode = EM0;
+	for(int i = 0; i < SLEEP_OWNER_COUNT; i++){
+		sleep_owner_stats[i] = (SLEEP_OWNER_STATS){0};
+		sleep_owner_since[i] = sleep_stamp;
+	}
+
+	CORE_EXIT_CRITICAL();
+}
 
 
+/***************************************************************************//**
+ * @brief
+ *   Copies the blocks held by each owner and its counters
+ *
+ * @details
+ * 	 An owner still holding blocks has the time since it took the first
+ * 	 added to its total. Comparing owners' totals with the time outside EM3
+ * 	 from sleep_stats_snapshot() shows which driver is costing the most.
+ *
+ * @param[out] stats
+ *   Array indexed by owner that receives the counters
+ *
+ ******************************************************************************/
+
+void sleep_owner_snapshot(SLEEP_OWNER_STATS stats[SLEEP_OWNER_COUNT]){
+	uint32_t now;
+	CORE_DECLARE_IRQ_STATE;
+	CORE_ENTER_CRITICAL();
+
+	now = rtcc_timestamp();
+	for(int i = 0; i < SLEEP_OWNER_COUNT; i++){
+		stats[i] = sleep_owner_stats[i];
+		for(int em = 0; em < MAX_ENERGY_MODES; em++){
+			stats[i].blocks[em] = sleep_owner_blocks[i][em];
+		}
+		if(sleep_owner_held[i] != 0){
+			stats[i].ticks += (uint32_t)(now - sleep_owner_since[i]);
+		}
+	}
+
+	CORE_EXIT_CRITICAL();
+}
@@ -0,0 +1,241 @@
+/**
+ * @file trace.c
+ * @author James Brennan
+ * @date October 16th, 2026
+ * @brief Ring of timestamped trace entries written by the interrupt handlers,
+ * the scheduler and the sleep routines.
+ *
+ */
+
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+
+//** Standard Libraries
+#include <stdio.h>
+
+//** Silicon Lab include files
+
+//** User/developer include files
+#include "trace.h"
+#include "ble.h"
+#include "letimer.h"
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+#define TRACE_RING_MASK			(TRACE_RING_SIZE - 1)
+
+_Static_assert((TRACE_RING_SIZE & TRACE_RING_MASK) == 0, "TRACE_RING_SIZE must be a power of two");
+
+
+//***********************************************************************************
+// Private variables
+//***********************************************************************************
+//trace_head counts every entry ever claimed, the ring holds the last TRACE_RING_SIZE
+static TRACE_ENTRY trace_ring[TRACE_RING_SIZE];
+static volatile uint32_t trace_head;
+static volatile bool trace_running;
+
+//position of the BLE dump, which freezes the ring until it is done
+static bool dump_busy;
+static bool dump_started;
+static uint32_t dump_next;
+static uint32_t dump_end;
+
+
+//***********************************************************************************
+// Private functions
+//***********************************************************************************
+
+
+//***********************************************************************************
+// Global functions
+//***********************************************************************************
+
+/***************************************************************************//**
+ * @brief
+ *   Opens the trace ring and starts recording
+ *
+ * @note
+ *   Should be called once after rtcc_open(), as entries are stamped with the
+ *   RTCC count
+ *
+ ******************************************************************************/
+
+void trace_open(void){
+	trace_head = 0;
+	dump_busy = false;
+	trace_running = true;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Adds an entry to the ring
+ *
+ * @details
+ * 	 The slot is claimed with one exclusive load/store on the head, so an
+ * 	 interrupt that traces while the main loop is part way through an entry
+ * 	 takes the next slot and neither is lost. Apart from that the cost is
+ * 	 the RTCC read and three stores, so the call can be left in the
+ * 	 interrupt handlers.
+ *
+ * @note
+ *   Use the TRACE() macro, which compiles to nothing without TRACE_ENABLED
+ *
+ * @param[in] id
+ *   What happened, a TRACE_ID
+ *
+ * @param[in] source
+ *   Interrupt number, event ID or energy mode, kept to 8 bits
+ *
+ * @param[in] arg
+ *   Extra detail, kept to 16 bits
+ *
+ ******************************************************************************/
+
+void trace_write(uint32_t id, uint32_t source, uint32_t arg){
+	TRACE_ENTRY *entry;
+
+	if(!trace_running){
+		return;
+	}
+
+	entry = &trace_ring[atomic_add32(&trace_head, 1) & TRACE_RING_MASK];
+	entry->timestamp = rtcc_timestamp();
+	entry->id = id;
+	entry->source = source;
+	entry->arg = arg;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Resumes recording
+ *
+ ******************************************************************************/
+
+void trace_start(void){
+	trace_running = true;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Stops recording, so the ring keeps what led up to now
+ *
+ ******************************************************************************/
+
+void trace_stop(void){
+	trace_running = false;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Copies the ring out, oldest entry first
+ *
+ * @note
+ *   Recording should be stopped first, or entries may change while they
+ *   are being copied
+ *
+ * @param[out] entries
+ *   Array that receives the entries
+ *
+ * @param[in] max
+ *   Size of the array, the newest entries are kept if the ring holds more
+ *
+ * @return
+ *   Number of entries copied
+ *
+ ******************************************************************************/
+
+uint32_t trace_snapshot(TRACE_ENTRY *entries, uint32_t max){
+	uint32_t head = trace_head;
+	uint32_t count = (head < TRACE_RING_SIZE) ? head : TRACE_RING_SIZE;
+
+	if(count > max){
+		count = max;
+	}
+	for(uint32_t i = 0; i < count; i++){
+		entries[i] = trace_ring[(head - count + i) & TRACE_RING_MASK];
+	}
+	return count;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Sends the ring over the BLE link
+ *
+ * @details
+ * 	 Recording stops and TRACE_DUMP_CB runs trace_dump(), which sends one
+ * 	 entry per line and starts recording again once the ring is empty. A
+ * 	 call while a dump is in progress is ignored.
+ *
+ ******************************************************************************/
+
+void trace_dump_ble(void){
+	uint32_t head;
+
+	if(dump_busy){
+		return;
+	}
+	trace_stop();
+	head = trace_head;
+	dump_busy = true;
+	dump_started = false;
+	dump_end = head;
+	dump_next = (head < TRACE_RING_SIZE) ? 0 : head - TRACE_RING_SIZE;
+	add_scheduled_event(TRACE_DUMP_CB);
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Coroutine that writes the frozen ring to the BLE module
+ *
+ * @details
+ * 	 The BLE circular buffer only holds a few lines, so a line is written
+ * 	 only once the previous output has gone out. The link is checked every
+ * 	 TRACE_DUMP_POLL_MS on a software timer, and the core sleeps in between.
+ * 	 A header with the entry count comes first, then one line per entry
+ * 	 with the RTCC timestamp, the TRACE_ID, the source and the argument, in
+ * 	 hex.
+ *
+ * @param[in] cr
+ *   State of the coroutine, kept by the scheduler
+ *
+ ******************************************************************************/
+
+void trace_dump(COROUTINE *cr){
+	char line[32];
+	TRACE_ENTRY *entry;
+
+	COROUTINE_BEGIN(cr);
+
+	while(true){
+		letimer_timer_start(TRACE_DUMP_CB, TRACE_DUMP_POLL_MS, false);
+		COROUTINE_YIELD(cr);
+		if(!ble_tx_idle()){
+			continue;
+		}
+
+		if(!dump_started){
+			sprintf(line, "\nTrace %lu\n", (unsigned long)(dump_end - dump_next));
+			dump_started = true;
+		}
+		else if(dump_next != dump_end){
+			entry = &trace_ring[dump_next & TRACE_RING_MASK];
+			sprintf(line, "%08lx %x %x %x\n", (unsigned long)entry->timestamp,
+					(unsigned)entry->id, (unsigned)entry->source, (unsigned)entry->arg);
+			dump_next++;
+		}
+		else{
+			ble_write("Trace end\n");
+			break;
+		}
+		ble_write(line);
+	}
+
+	dump_busy = false;
+	trace_start();
+
+	COROUTINE_END(cr);
+}
@@ -58,9 +58,13 @@ static uint32_t ldata;
  * @param[in] SCL_route
  *   SCL out-route for the i2c peripheral being used
  *
+ * @param[in] configure
+ *   Powers the sensor on. False on a warm boot from EM4H, where the sensor
+ *   kept its configuration.
+ *
  ******************************************************************************/
 
-void veml6030_i2c_open(I2C_TypeDef *i2c, uint32_t SDA_route, uint32_t SCL_route ){
+void veml6030_i2c_open(I2C_TypeDef *i2c, uint32_t SDA_route, uint32_t SCL_route, bool configure){
 
 	 I2C_OPEN_STRUCT i2c_open_struct;
 	 //not ready to enable i2c yet
@@ -84,9 +88,14 @@ void veml6030_i2c_open(I2C_TypeDef *i2c, uint32_t SDA_route, uint32_t SCL_route
 	 i2c_open(i2c, &i2c_open_struct);
 
 
+	 if(!configure){
+		 return;
+	 }
+
+	 //powers the sensor on, VEML6030_Write_CB is posted once the write is done.
+	 //I2C0 is not used again until the first sample, so there is no need to wait.
 	 uint16_t writeData = 0b0000000000000000;
 	 veml6030_write(VEML6030_Write_CB , i2c, Veml_WRITE, writeData);
-	 while(!(get_scheduled_events() & (VEML6030_Write_CB)));
 
 
 
@@ -112,9 +121,17 @@ void veml6030_i2c_open(I2C_TypeDef *i2c, uint32_t SDA_route, uint32_t SCL_route
  ******************************************************************************/
 
 void veml6030_read(uint32_t VEML6030_CB, I2C_TypeDef *i2c, uint32_t command){
-	uint32_t address = 0x48;
+	I2C_TRANSFER transfer = {
+		.address = 0x48,
+		.write = { command },
+		.write_len = 1,
+		.read_len = 2,
+		.order = I2C_LSB_FIRST,			//the veml6030 sends the low byte of a register first
+		.data = &ldata,
+		.event = VEML6030_CB
+	};
 
-	I2C_Start(i2c, &ldata, address, VEML6030_CB, command, false);
+	i2c_transfer(i2c, &transfer);
 
 
 
@@ -138,9 +155,15 @@ void veml6030_read(uint32_t VEML6030_CB, I2C_TypeDef *i2c, uint32_t command){
  ******************************************************************************/
 
 
-void veml6030_write(uint32_t VEML6030_CB, I2C_TypeDef *i2c, uint32_t command, uint8_t writeData){
-	uint32_t address =0x48;
-	I2C_Start(i2c, false, address, VEML6030_CB , command, writeData);
+void veml6030_write(uint32_t VEML6030_CB, I2C_TypeDef *i2c, uint32_t command, uint16_t writeData){
+	I2C_TRANSFER transfer = {
+		.address = 0x48,
+		.write = { command, writeData & 0xFF, writeData >> 8 },		//registers are written low byte first
+		.write_len = 3,
+		.event = VEML6030_CB
+	};
+
+	i2c_transfer(i2c, &transfer);
 
 
 }
@@ -162,12 +185,28 @@ void veml6030_write(uint32_t VEML6030_CB, I2C_TypeDef *i2c, uint32_t command, ui
 
 float veml6030_return_lux(void){
 	//float humidity;
-	float lux = 0.0576*((float)(ldata)); //equation for lux conversion based on current settings, gain =  1, integration time = 100ms
+	float lux = veml6030_lux(ldata);
 
     ldata = 0; //resetting ldata before the next read
 	return lux;
 }
 
+/***************************************************************************//**
+ * @brief
+ *   Converts a raw veml6030 ALS code to lux
+ *
+ * @param[in] code
+ *   16 bit ALS code read from the veml6030
+ *
+ * @return
+ *   Lux for the current settings
+ *
+ ******************************************************************************/
+
+float veml6030_lux(uint32_t code){
+	return 0.0576*((float)(code)); //equation for lux conversion based on current settings, gain =  1, integration time = 100ms
+}
+
 
 
 
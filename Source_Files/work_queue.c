@@ -0,0 +1,189 @@
+/**
+ * @file work_queue.c
+ * @author James Brennan
+ * @date October 16th, 2026
+ * @brief Queue of deferred function calls run from the main loop.
+ *
+ */
+
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+
+//** Standard Libraries
+
+//** Silicon Lab include files
+
+//** User/developer include files
+#include "work_queue.h"
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+#define WORK_QUEUE_MASK			(WORK_QUEUE_SIZE - 1)
+
+_Static_assert((WORK_QUEUE_SIZE & WORK_QUEUE_MASK) == 0, "WORK_QUEUE_SIZE must be a power of two");
+
+
+//***********************************************************************************
+// Private variables
+//***********************************************************************************
+//head is claimed by submitters with an exclusive load/store, tail is only moved by the main loop
+static WORK_ITEM work_items[WORK_QUEUE_SIZE];
+static volatile uint32_t work_head;
+static volatile uint32_t work_tail;
+static WORK_QUEUE_STATS work_stats;
+
+
+//***********************************************************************************
+// Private functions
+//***********************************************************************************
+
+
+//***********************************************************************************
+// Global functions
+//***********************************************************************************
+
+/***************************************************************************//**
+ * @brief
+ *   Opens the work queue
+ *
+ * @details
+ * 	 Empties the queue and clears its counters
+ *
+ * @note
+ *   Should be called once on start up, before any work is submitted
+ *
+ ******************************************************************************/
+
+void work_queue_open(void){
+	for(int i = 0; i < WORK_QUEUE_SIZE; i++){
+		work_items[i].fn = NULL;
+		work_items[i].ctx = NULL;
+	}
+	work_tail = work_head;
+	work_stats = (WORK_QUEUE_STATS){0};
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Queues a function to run from the main loop
+ *
+ * @details
+ * 	 Unlike an event, an item needs no entry in events.h and carries a
+ * 	 context pointer, so a driver can defer a follow up step without
+ * 	 reserving an event for it. Items run in the order they were submitted.
+ *
+ * 	 A slot is claimed by advancing the head with an exclusive load/store,
+ * 	 so interrupt handlers and the main loop may both submit without
+ * 	 masking interrupts. The function pointer is written last and marks the
+ * 	 slot as ready.
+ *
+ * @note
+ *   A full queue drops the item and counts it
+ *
+ * @param[in] fn
+ *   Function to run
+ *
+ * @param[in] ctx
+ *   Value handed to fn, it must still be valid when fn runs
+ *
+ * @return
+ *   true if the item was queued
+ *
+ ******************************************************************************/
+
+bool work_submit(WORK_FN fn, void *ctx){
+	uint32_t head;
+	uint32_t depth;
+
+	EFM_ASSERT(fn != NULL);
+
+	do {
+		head = __LDREXW(&work_head);
+		if((head - work_tail) >= WORK_QUEUE_SIZE){
+			__CLREX();
+			atomic_add32(&work_stats.dropped, 1);
+			EFM_ASSERT(false);
+			return false;
+		}
+	} while(__STREXW(head + 1, &work_head));
+
+	work_items[head & WORK_QUEUE_MASK].ctx = ctx;
+	//the context must be in place before the slot reads as ready
+	__DMB();
+	work_items[head & WORK_QUEUE_MASK].fn = fn;
+
+	atomic_add32(&work_stats.submitted, 1);
+	depth = head + 1 - work_tail;
+	if(depth > work_stats.max_depth){
+		work_stats.max_depth = depth;
+	}
+	return true;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Returns true if there are items waiting to run
+ *
+ * @details
+ * 	 The main loop must check this as well as scheduler_pending() before it
+ * 	 goes to sleep.
+ *
+ ******************************************************************************/
+
+bool work_queue_pending(void){
+	return work_tail != work_head;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Runs the queued items, oldest first
+ *
+ * @details
+ * 	 Only the items queued when the drain starts are run. Anything they
+ * 	 submit waits for the next pass of the main loop, so a chain of work
+ * 	 items cannot hold off the scheduler's events. A slot whose submitter
+ * 	 has not finished filling it ends the drain early.
+ *
+ * @note
+ *   Called from the main loop after scheduler_dispatch()
+ *
+ ******************************************************************************/
+
+void work_queue_drain(void){
+	uint32_t end = work_head;
+
+	while(work_tail != end){
+		WORK_ITEM *item = &work_items[work_tail & WORK_QUEUE_MASK];
+		WORK_FN fn = item->fn;
+		void *ctx;
+
+		if(fn == NULL){
+			break;
+		}
+		__DMB();
+		ctx = item->ctx;
+
+		//the slot is handed back before the item runs, so it may resubmit itself
+		item->fn = NULL;
+		work_tail = work_tail + 1;
+		fn(ctx);
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Copies the work queue counters
+ *
+ * @param[out] stats
+ *   Receives the counters
+ *
+ ******************************************************************************/
+
+void work_queue_stats(WORK_QUEUE_STATS *stats){
+	stats->submitted = work_stats.submitted;
+	stats->dropped = work_stats.dropped;
+	stats->max_depth = work_stats.max_depth;
+}
@@ -25,68 +25,39 @@ int main(void)
   CMU_OscillatorEnable(cmuOsc_HFXO, false, false);
 
   /* Call application program to open / initialize all required peripheral */
+#ifdef APP_HIBERNATE_ENABLED
+  /* A wake-up from EM4H takes the warm boot path */
+  hibernate_open();
+  if (hibernate_warm_boot()){
+	  app_warm_boot();
+  }
+  else{
+	  app_peripheral_setup();
+  }
+#else
   app_peripheral_setup();
+#endif
 
-  //EFM_ASSERT(get_scheduled_events() & BOOT_UP_CB);
   /* Infinite blink loop */
   while (1) {
 //	  EMU_EnterEM1();
 //	  EMU_EnterEM2(true);
 	  CORE_DECLARE_IRQ_STATE;
 	  CORE_ENTER_CRITICAL();
-	  if (!get_scheduled_events()){
+	  if (!scheduler_pending() && !work_queue_pending()){
 
+#ifdef APP_HIBERNATE_ENABLED
+		  app_hibernate();
+#endif
 		  enter_sleep();
 		 // CORE_EXIT_CRITICAL();
 	  }
 
 		  CORE_EXIT_CRITICAL();
 
-	  //check for UF event
-	  if(get_scheduled_events() & LETIMER_UF_CB){
-		  scheduled_letimer0_uf_cb();
-	  }
-
-	  //check for COMP0 event
-	  if(get_scheduled_events() & LETIMER_COMP0_CB){
-		  scheduled_letimer0_comp0_cb();
-	 	  }
-
-	  //check for COMP1 event
-	  if(get_scheduled_events() & LETIMER_COMP1_CB){
-		  scheduled_letimer0_comp1_cb();
-	 	  }
-	  //check for humidity callback
-	  if(get_scheduled_events() & Si7021_Read_Humidity_CB ){
-			  scheduled_si7021_humidity_cb ();
-		  }
-	  if(get_scheduled_events() & Si7021_Read_Temperature_CB ){
-			  scheduled_si7021_temperature_cb ();
-		  }
-
-	  if(get_scheduled_events() & Si7021_Write_Reg_CB ){
-		  scheduled_si7021_writeReg_cb ();
-		 }
-	  if(get_scheduled_events() & Si7021_Read_Reg_CB ){
-		  	  scheduled_si7021_readReg_cb ();
-		 }
-
-	  if(get_scheduled_events() & VEML6030_Read_CB ){
-		  scheduled_veml6030_lux_cb();
-	  		 }
-
-	  if(get_scheduled_events() & VEML6030_Write_CB ){
-			  scheduled_veml6030_write_cb();
-		  }
-
-
-	  //check for boot callback
-	  if(get_scheduled_events() & BOOT_UP_CB){
-	 		  scheduled_boot_up_cb ();
-	  }
-	  //check for ble_TX callback
-	  if(get_scheduled_events() & BLE_TX_DONE_CB){
-		  	  scheduled_ble_tx_done_cb ();
-	 	 }
+	  //run the handlers of every event that is set
+	  scheduler_dispatch();
+	  //then the work queued before this pass
+	  work_queue_drain();
   }
 }